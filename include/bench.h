@@ -0,0 +1,35 @@
+/**
+ * @file  bench.h
+ * @brief Header for the bench module, which benchmarks the renderer.
+ *
+ * Declares the interface for the bench module. Enables the caller to
+ * render a fixed number of frames along scripted camera paths without a
+ * window, display, or frame cap, and report how long they took. Meant
+ * for build machines that need to track renderer performance over time.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>  // for the bool type
+#include "options.h"  // for the benchmark settings
+
+/**
+ * @brief Renders the frames requested with -bench and prints statistics.
+ *
+ * Draws into a CPU framebuffer only, so it never initializes SDL video.
+ * Uses the maze, resolution, kernel, and thread count from the options;
+ * without -seed, the maze seed is fixed so that runs are comparable.
+ *
+ * Prints a single line of JSON with the results to stdout, and its own
+ * error messages on failure.
+ *
+ * @param pOptions Pointer to the options, with `benchFrames` positive.
+ * @return         True if the benchmark ran; false on failure.
+ */
+bool bench_run(const struct GameOptions *restrict pOptions);
+
+#endif  // BENCH_H
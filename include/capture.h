@@ -0,0 +1,92 @@
+/**
+ * @file  capture.h
+ * @brief Header for the capture module, which saves frames to disk.
+ *
+ * Declares the interface for the capture module. Enables the caller to
+ * save the view in the framebuffer as a screenshot, or as the next frame
+ * of a video, without waiting on the disk. Frames are copied into one of
+ * a few slots and handed to a background thread that converts and
+ * writes them. When every slot is still waiting to be written, the new
+ * frame is dropped rather than held up for, so a slow disk costs frames
+ * of the capture and never frames of the game.
+ *
+ * Screenshots are saved as binary PPM files. Videos are saved as Y4M
+ * streams, which most video tools read, in 4:2:0 YUV, which takes half
+ * the room RGB would.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "render.h"  // for the framebuffer to capture
+
+#define CAPTURE_SLOTS       3   ///< frames that can wait to be written at once
+#define CAPTURE_VIDEO_RATE  30  ///< frames per second of video
+
+// The state of the capture, opaque outside its module
+struct FrameCapture;
+
+
+/**
+ * @brief Starts the background thread that writes captured frames.
+ *
+ * The video file isn't created until the first video frame comes in,
+ * since its header needs the frame's size. Prints its own error
+ * messages on failure.
+ *
+ * @param videoPath Path of the Y4M file to record video to; can be null
+ *                  to only take screenshots.
+ * @return          Pointer to the new capture; `NULL` on failure.
+ */
+struct FrameCapture *capture_create(const char *videoPath);
+
+
+/**
+ * @brief Queues the view in the framebuffer to be saved as a screenshot.
+ *
+ * Saves it to a new file in the working directory, named after the
+ * time it was taken, and logs the name once it's written. Warns if the
+ * screenshot has to be dropped.
+ *
+ * @param pCapture Pointer to the capture.
+ * @param pFrame   Pointer to a framebuffer with a view drawn in it.
+ */
+void capture_takeScreenshot(
+    struct FrameCapture *restrict pCapture,
+    const struct Framebuffer *restrict pFrame
+);
+
+
+/**
+ * @brief Queues the view in the framebuffer as the next video frame, if one is due.
+ *
+ * Meant to be called once per frame shown. Video frames are due every
+ * 1/CAPTURE_VIDEO_RATE seconds; a frame that covers several of those,
+ * or follows dropped ones, is written as many times, so the video plays
+ * back in real time. Views drawn at another size than the first frame,
+ * as dynamic resolution does, are scaled to its size. Does nothing
+ * without a video path.
+ *
+ * @param pCapture Pointer to the capture.
+ * @param pFrame   Pointer to a framebuffer with a view drawn in it.
+ */
+void capture_addVideoFrame(
+    struct FrameCapture *restrict pCapture,
+    const struct Framebuffer *restrict pFrame
+);
+
+
+/**
+ * @brief Writes out the frames still queued, closes the video, and frees the capture.
+ *
+ * Logs how many video frames were captured and dropped. Sets the
+ * caller's pointer to `NULL`; does nothing if it already is.
+ *
+ * @param ppCapture Pointer to the pointer to the capture.
+ */
+void capture_destroy(struct FrameCapture **ppCapture);
+
+#endif  // CAPTURE_H
@@ -12,4 +12,11 @@
 // The title, or name, of the game
 #define GAME_TITLE  "Mazecast"
 
+// Simulation steps per second; input logs only replay at the same rate
+#define STEPS_PER_SECOND  120
+
+// Bytes per cache line on every target we ship to; data that threads
+// write side by side, or that SIMD loads, is aligned to it
+#define CACHE_LINE_SIZE  64
+
 #endif  // DEFINES_H
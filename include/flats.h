@@ -0,0 +1,103 @@
+/**
+ * @file  flats.h
+ * @brief Header for the flats module, which textures floors and ceilings.
+ *
+ * Declares the interface for the flats module. Enables the caller to
+ * pick the fastest span kernel the CPU supports and fill horizontal
+ * spans of floor or ceiling with it. Every pixel of a screen row is the
+ * same distance away, so its texture coordinates step linearly across
+ * the row, and the SIMD kernels texture four or eight pixels at a time.
+ * Spans of palette indices have kernels of their own, which work out
+ * texture coordinates the same way.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef FLATS_H
+#define FLATS_H
+
+#include <stdint.h>   // for fixed-width integer types
+#include "raycast.h"  // for the kernel choices
+
+// Pixels the widest kernel fills per step; spans are padded to this
+#define FLAT_SPAN_ALIGNMENT  8
+
+/**
+ * @brief One row's worth of floor or ceiling within a strip of the view.
+ *
+ * Texture coordinates are in texels of the level sampled, relative to
+ * any whole number of cells, since the texture repeats once per cell.
+ * Full-color spans use `pixels`, `texels`, and `shade`; indexed spans
+ * use `indices`, `indexTexels`, and `shades` instead.
+ */
+struct FlatSpan
+{
+    uint32_t       *pixels;       ///< first pixel to fill, 32-byte aligned
+    uint8_t        *indices;      ///< first palette index to fill
+    const float    *cameraXs;     ///< camera plane offset of each pixel's column
+    const uint32_t *texels;       ///< column-major mip level to sample
+    const uint8_t  *indexTexels;  ///< same level, as palette indices
+    const uint8_t  *shades;       ///< palette's shaded indices for the row
+    int             count;        ///< number of pixels to fill
+    int             sizeShift;    ///< log2 of the level's texels per side
+    float           uStart;       ///< u coordinate at the view axis
+    float           vStart;       ///< v coordinate at the view axis
+    float           uStep;        ///< u per unit of camera plane offset
+    float           vStep;        ///< v per unit of camera plane offset
+    uint32_t        shade;        ///< brightness out of 256
+};
+
+
+/**
+ * @brief Picks the span kernel for the instruction set of a ray casting kernel.
+ *
+ * Follows whichever kernel `raycast_selectKernel` settled on, so that
+ * forcing one with -simd forces the other too; the fixed-point ray
+ * casting kernel gets the scalar span kernel.
+ *
+ * @param kernel The ray casting kernel in use; not `RAYCAST_AUTO`.
+ */
+void flats_selectKernel(enum RaycastKernel kernel);
+
+
+/**
+ * @brief Textures a span with the selected kernel.
+ *
+ * The SIMD kernels fill whole groups of `FLAT_SPAN_ALIGNMENT` pixels, so
+ * the pixels and camera plane offsets must both have room for `count`
+ * rounded up to that.
+ *
+ * @param pSpan Pointer to the span.
+ */
+void flats_drawSpan(const struct FlatSpan *restrict pSpan);
+
+
+/**
+ * @brief The individual kernels, with the same contract as `flats_drawSpan`.
+ */
+void flats_drawSpanScalar(const struct FlatSpan *restrict pSpan);
+void flats_drawSpanSSE2(const struct FlatSpan *restrict pSpan);
+void flats_drawSpanAVX2(const struct FlatSpan *restrict pSpan);
+
+
+/**
+ * @brief Textures a span of palette indices with the selected kernel.
+ *
+ * Shades each index by table lookup. Pads like `flats_drawSpan`: the
+ * indices and camera plane offsets must both have room for `count`
+ * rounded up to `FLAT_SPAN_ALIGNMENT`.
+ *
+ * @param pSpan Pointer to the span.
+ */
+void flats_drawSpanIndexed(const struct FlatSpan *restrict pSpan);
+
+
+/**
+ * @brief The individual indexed kernels, with the contract of `flats_drawSpanIndexed`.
+ */
+void flats_drawSpanIndexedScalar(const struct FlatSpan *restrict pSpan);
+void flats_drawSpanIndexedSSE2(const struct FlatSpan *restrict pSpan);
+void flats_drawSpanIndexedAVX2(const struct FlatSpan *restrict pSpan);
+
+#endif  // FLATS_H
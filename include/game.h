@@ -13,6 +13,8 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "options.h"  // for the command-line options
+
 /**
  * @brief Container for all shared game properties.
  *
@@ -31,12 +33,14 @@ struct GameContext;
  * running the main game loop; i.e., don't ever pass an uninitialized or
  * null pointer to game_runMainLoop.
  *
- * @param argc  Number of command-line arguments from main(), if any.
- * @param argv  List of command-line arguments from main(); can be null.
- * @param title Title of the game.
- * @return      Pointer to the just-initialized game context; `NULL` on failure.
+ * @param pOptions Pointer to the options parsed from the command line.
+ * @param title    Title of the game.
+ * @return         Pointer to the just-initialized game context; `NULL` on failure.
  */
-struct GameContext *game_initContext(int argc, char **argv, const char *title);
+struct GameContext *game_initContext(
+    const struct GameOptions *restrict pOptions,
+    const char *title
+);
 
 
 /**
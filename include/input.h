@@ -8,6 +8,11 @@
  * one without worrying about what the specific physical inputs
  * (keypresses, mouse clicks, etc.) were.
  *
+ * The queue is a lock-free ring with one producer, `input_pumpEvents`,
+ * and one consumer, `input_loadNextAction`, so the two may be called
+ * from different threads, and as often as needed; e.g., right before
+ * every simulation step, so each step sees the freshest input.
+ *
  * @author Joseph Borjon
  * @date   2024-12-16
  */
@@ -17,6 +22,7 @@
 
 #include <stdbool.h>   // for the bool type
 #include <SDL3/SDL.h>  // for SDL3
+#include "player.h"    // for what the input asks of the player
 
 /**
  * @brief The commands the user can input through interaction with devices.
@@ -30,6 +36,19 @@ enum UserCommand
     CMD_UNKNOWN,            ///< unknown command
     CMD_TOGGLE_FULLSCREEN,  ///< toggle between full and windowed screen
     CMD_QUIT,               ///< exit the game loop
+    CMD_TOGGLE_PROFILER,    ///< show or hide the profiler overlay
+    CMD_MOVE_FORWARD,       ///< walk forward while held
+    CMD_MOVE_BACKWARD,      ///< walk backward while held
+    CMD_STRAFE_LEFT,        ///< sidestep left while held
+    CMD_STRAFE_RIGHT,       ///< sidestep right while held
+    CMD_TURN_LEFT,          ///< turn left while held
+    CMD_TURN_RIGHT,         ///< turn right while held
+    CMD_TURN_MOUSE,         ///< turn right by the mouse's motion in pixels
+    CMD_TOGGLE_MINIMAP,     ///< show or hide the minimap
+    CMD_SHOW_WAY_OUT,       ///< show the way to the exit on the minimap
+    CMD_TOGGLE_TRAIL,       ///< start or stop dropping breadcrumbs
+    CMD_TOGGLE_INTERLACE,   ///< start or stop interlacing the view
+    CMD_SCREENSHOT,         ///< save the view as a screenshot
     NUM_COMMANDS            ///< total number of commands
 };
 
@@ -43,7 +62,22 @@ enum UserCommand
 struct GameAction
 {
     enum UserCommand command;    ///< what the user wants done based on input
-    float            magnitude;  ///< relative mouse motion, or 0 if a keypress
+    float            magnitude;  ///< relative mouse motion, summed over
+                                 ///< consecutive events; for held keys,
+                                 ///< 1 when pressed and 0 when released
+};
+
+/**
+ * @brief Everything the actions that drive the player have added up to.
+ *
+ * Held keys stay held from step to step, while mouse motion is used up
+ * by the next step. Recorded or replayed actions go through this just
+ * like live ones, so they move the player exactly the same way.
+ */
+struct InputState
+{
+    bool  heldCommands[NUM_COMMANDS];  ///< which hold-down commands are held
+    float mouseTurn;                   ///< radians to turn in the next step
 };
 
 
@@ -51,18 +85,21 @@ struct GameAction
  * @brief Clears all pending events currently in the SDL event queue.
  *
  * Useful for dropping any unneeded pending events right before starting
- * the main loop and right after transitioning game states.
+ * the main loop and right after transitioning game states. Drops any
+ * actions already queued, too.
  */
 void input_clearEventQueue(void);
 
 
 /**
- * @brief Fills the action queue with all the pending user commands.
+ * @brief Adds all the pending user commands to the action queue.
  *
- * Should be called once every iteration of the main loop, immediately
- * before the loop that calls `input_loadNextAction`.
+ * Consecutive mouse motion is merged into a single action. Never drops
+ * anything: once the queue is nearly full, the remaining events wait in
+ * SDL's own queue for the next call. Must be called on the thread that
+ * created the window, at least once every iteration of the main loop.
  */
-void input_refreshActions(void);
+void input_pumpEvents(void);
 
 
 /**
@@ -76,9 +113,42 @@ void input_refreshActions(void);
  * calls.
  * 
  * Should be called in a loop that executes each action one by one until
- * no actions are left. This loop should start only after having called
- * `input_refreshActions` once within the main loop.
+ * no actions are left, typically right after `input_pumpEvents`.
  */
 bool input_loadNextAction(struct GameAction *restrict pAction);
 
+
+/**
+ * @brief Checks whether a command moves or turns the player.
+ * @param command The command.
+ * @return        True if `input_applyAction` handles it.
+ */
+bool input_drivesPlayer(enum UserCommand command);
+
+
+/**
+ * @brief Adds an action that drives the player to the input state.
+ * @param pState  Pointer to the input state.
+ * @param pAction Pointer to the action; anything that doesn't drive the
+ *                player is ignored.
+ */
+void input_applyAction(
+    struct InputState *restrict pState,
+    const struct GameAction *restrict pAction
+);
+
+
+/**
+ * @brief Gets what the input state asks of the player for the next step.
+ *
+ * Opposite keys held together cancel out. Uses up the mouse motion.
+ *
+ * @param pState Pointer to the input state.
+ * @param pInput Pointer to the player input to be filled in.
+ */
+void input_takePlayerInput(
+    struct InputState *restrict pState,
+    struct PlayerInput *restrict pInput
+);
+
 #endif  // INPUT_H
@@ -0,0 +1,276 @@
+/**
+ * @file  maze.h
+ * @brief Header for the maze module, which generates and stores mazes.
+ *
+ * Declares the interface for the maze module. Enables the caller to
+ * generate a random perfect maze (exactly one path between any two
+ * cells) of up to `MAZE_MAX_SIZE` cells per side, save it to a file and
+ * map it back in later, and query its walls. Mazes live in arenas that
+ * the caller provides.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef MAZE_H
+#define MAZE_H
+
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "utils.h"    // for arenas
+
+#define MAZE_MIN_SIZE   2      // fewest cells per side
+#define MAZE_MAX_SIZE   32768  // most cells per side
+#define MAZE_TILE_SIZE  8      // cells per side of one 64-bit tile of walls
+
+/**
+ * @brief A grid of square cells separated by thin walls, one bit per wall.
+ *
+ * Walls lie on the grid lines between cells. A vertical line x (from 0
+ * to `width`) runs along the west side of column x, and a horizontal
+ * line y (from 0 to `height`) runs along the north side of row y, so
+ * the outer walls are lines 0 and `width` or `height`. They are always
+ * closed, so anything walking the grid stays inside it.
+ *
+ * Each wall plane is split into 8x8 tiles, stored row by row, with one
+ * 64-bit word per tile and bit `(y % 8) * 8 + (x % 8)` for the wall at
+ * (x, y). Rays and players move locally, so neighboring walls usually
+ * share a word and a cache line.
+ *
+ * A maze loaded from a file points straight into the mapped file, so
+ * its walls must never be written to.
+ *
+ * A maze can also carry a distance field: for each cell, how many cells
+ * the open square centered on it reaches in every direction, that is,
+ * the Chebyshev distance to the nearest cell that has a wall within one
+ * cell of it. It's one byte per cell, capped at 255, split into 8x8
+ * tiles like the walls, so that each tile is one cache line. Rays use it
+ * to cross open space in one go instead of one cell at a time.
+ *
+ * You should consider this struct read-only. You may access its members
+ * directly for read convenience and efficiency, but let the interface
+ * functions modify them.
+ */
+struct Maze
+{
+    uint64_t *restrict westWalls;    ///< vertical wall plane
+    uint64_t *restrict northWalls;   ///< horizontal wall plane, right after
+    size_t             planeWords;   ///< 64-bit words in each plane
+    int                width;        ///< cells per row
+    int                height;       ///< number of rows
+    int                tilesPerRow;  ///< tiles per row in each plane
+    int                exitX;        ///< column of the cell to get to
+    int                exitY;        ///< row of the cell to get to
+    uint64_t           seed;         ///< seed the maze was generated from
+    void              *mapping;      ///< file holding the walls; NULL if none
+    size_t             mappingSize;  ///< size of the mapped file in bytes
+    uint8_t  *restrict distances;    ///< distance field by tile; NULL if none
+};
+
+
+/**
+ * @brief Allocates and generates a maze and returns a pointer to it.
+ *
+ * Generation is iterative and uses memory proportional to the width
+ * only, on top of the walls themselves, so it can handle the largest
+ * mazes without blowing the stack. The same seed always generates the
+ * same maze. The player starts in cell (0, 0), and the exit is in the
+ * opposite corner.
+ *
+ * Prints its own error messages on failure.
+ *
+ * @param width    Cells per row, from `MAZE_MIN_SIZE` to `MAZE_MAX_SIZE`.
+ * @param height   Number of rows, from `MAZE_MIN_SIZE` to `MAZE_MAX_SIZE`.
+ * @param seed     Seed for the random choices made while generating.
+ * @param pArena   Arena for the maze and its walls, with at least
+ *                 `maze_getArenaSize` bytes left.
+ * @param pScratch Arena for temporary data, with at least
+ *                 `maze_getScratchSize` bytes left; rewound before returning.
+ * @return         Pointer to the just-generated maze; `NULL` on failure.
+ */
+struct Maze *maze_create(
+    int width,
+    int height,
+    uint64_t seed,
+    struct Arena *restrict pArena,
+    struct Arena *restrict pScratch
+);
+
+
+/**
+ * @brief Allocates a maze with every wall closed and returns a pointer to it.
+ *
+ * For mazes whose walls are filled in from elsewhere, such as streamed
+ * chunk by chunk. The exit is in the corner opposite cell (0, 0), and
+ * the seed is 0.
+ *
+ * Prints its own error messages on failure.
+ *
+ * @param width  Cells per row, from `MAZE_MIN_SIZE` to `MAZE_MAX_SIZE`.
+ * @param height Number of rows, from `MAZE_MIN_SIZE` to `MAZE_MAX_SIZE`.
+ * @param pArena Arena for the maze and its walls, with at least
+ *               `maze_getArenaSize` bytes left.
+ * @return       Pointer to the new maze; `NULL` on failure.
+ */
+struct Maze *maze_createClosed(int width, int height, struct Arena *restrict pArena);
+
+
+/**
+ * @brief Gets the arena space `maze_create` needs for a maze, padding included.
+ *
+ * Leaves no room for a distance field, which only loaded mazes get; see
+ * `maze_getFileArenaSize`.
+ *
+ * @param width  Cells per row.
+ * @param height Number of rows.
+ * @return       Size in bytes.
+ */
+size_t maze_getArenaSize(int width, int height);
+
+
+/**
+ * @brief Gets the arena space `maze_load` needs for the maze in a file.
+ *
+ * Leaves room for the maze's distance field, from the size in the file's
+ * header. Only reads the header; if the file can't be read, gets the
+ * space for the maze itself and leaves `maze_load` to report why.
+ *
+ * @param path Path to the maze file.
+ * @return     Size in bytes.
+ */
+size_t maze_getFileArenaSize(const char *restrict path);
+
+
+/**
+ * @brief Gets the scratch space `maze_create` needs for a maze, padding included.
+ * @param width Cells per row.
+ * @return      Size in bytes.
+ */
+size_t maze_getScratchSize(int width);
+
+
+/**
+ * @brief Maps a maze saved with `maze_save` into memory and returns it.
+ *
+ * The walls are used in place, straight from the file, so loading takes
+ * about the same time regardless of the maze's size; pages are read in
+ * as rays first reach them. The file is checked for the right format,
+ * version, and byte order, and for intact outer walls.
+ *
+ * Prints its own error messages on failure.
+ *
+ * @param path   Path to the maze file.
+ * @param pArena Arena for the maze itself, with at least
+ *               `sizeof(struct Maze) + ARENA_ALIGNMENT` bytes left, or
+ *               `maze_getFileArenaSize` to build a distance field later.
+ * @return       Pointer to the loaded maze; `NULL` on failure.
+ */
+struct Maze *maze_load(const char *restrict path, struct Arena *restrict pArena);
+
+
+/**
+ * @brief Saves the maze to a file that `maze_load` can map back in.
+ *
+ * The file starts with a one-page header, followed by the west and the
+ * north wall planes exactly as they are laid out in memory.
+ *
+ * Prints its own error messages on failure.
+ *
+ * @param pMaze Pointer to the maze to be saved.
+ * @param path  Path to the file to be written, replacing any already there.
+ * @return      True on success; false on failure.
+ */
+bool maze_save(const struct Maze *restrict pMaze, const char *restrict path);
+
+
+/**
+ * @brief Builds the maze's distance field, unless it has no open space at all.
+ *
+ * Takes one pass over the maze each way, which is worth it for mazes
+ * with rooms and halls. A perfect maze, like any generated one, has no
+ * open 3x3 square anywhere, so its field would be all zeros; it's given
+ * back to the arena right away in that case and the maze is left without
+ * one.
+ *
+ * Prints its own error message on failure, in which case the maze is
+ * left without a field but otherwise fine to use.
+ *
+ * @param pMaze  Pointer to the maze, without a field yet.
+ * @param pArena Arena for the field, normally the maze's own, with room
+ *               for it as `maze_getFileArenaSize` counts it.
+ * @return       True on success, whether the maze got a field or not.
+ */
+bool maze_buildDistances(struct Maze *restrict pMaze, struct Arena *restrict pArena);
+
+
+/**
+ * @brief Unmaps a loaded maze's file and sets the maze pointer to `NULL`.
+ *
+ * The maze's memory belongs to its arena and goes away with it; call this
+ * before that, on every maze, generated or loaded.
+ *
+ * @param ppMaze Pointer to the maze pointer to be released.
+ */
+void maze_destroy(struct Maze **ppMaze);
+
+
+/**
+ * @brief Gets the index of a cell in the maze's distance field.
+ * @param tilesPerRow The maze's `tilesPerRow`.
+ * @param x           Column of the cell.
+ * @param y           Row of the cell.
+ * @return            Byte offset of the cell from the start of the field.
+ */
+static inline size_t maze_getDistanceIndex(int tilesPerRow, int x, int y)
+{
+    size_t tile = (size_t)(y >> 3) * tilesPerRow + (x >> 3);
+    return tile << 6 | (size_t)((y & 7) << 3 | (x & 7));
+}
+
+
+/**
+ * @brief Checks a bit in one of the maze's wall planes.
+ * @param plane       The wall plane, either `westWalls` or `northWalls`.
+ * @param tilesPerRow The maze's `tilesPerRow`.
+ * @param x           Column of the wall.
+ * @param y           Row of the wall.
+ * @return            True if there's a wall there.
+ */
+static inline bool maze_testWall(
+    const uint64_t *restrict plane,
+    int tilesPerRow,
+    int x,
+    int y
+) {
+    uint64_t tile = plane[(size_t)(y >> 3) * tilesPerRow + (x >> 3)];
+    return (tile >> (((y & 7) << 3) | (x & 7))) & 1;
+}
+
+
+/**
+ * @brief Checks whether there's a wall along the west side of a cell.
+ * @param pMaze Pointer to the maze.
+ * @param x     Column of the cell, or `width` for the east outer wall.
+ * @param y     Row of the cell.
+ * @return      True if there's a wall there.
+ */
+static inline bool maze_hasWestWall(const struct Maze *restrict pMaze, int x, int y)
+{
+    return maze_testWall(pMaze->westWalls, pMaze->tilesPerRow, x, y);
+}
+
+
+/**
+ * @brief Checks whether there's a wall along the north side of a cell.
+ * @param pMaze Pointer to the maze.
+ * @param x     Column of the cell.
+ * @param y     Row of the cell, or `height` for the south outer wall.
+ * @return      True if there's a wall there.
+ */
+static inline bool maze_hasNorthWall(const struct Maze *restrict pMaze, int x, int y)
+{
+    return maze_testWall(pMaze->northWalls, pMaze->tilesPerRow, x, y);
+}
+
+#endif  // MAZE_H
@@ -0,0 +1,135 @@
+/**
+ * @file  minimap.h
+ * @brief Header for the minimap module, which maps what the player has seen.
+ *
+ * Declares the interface for the minimap module. Enables the caller to
+ * mark the cells the player has seen as explored, one bit per cell, and
+ * draw the explored part of the maze around the player over the view.
+ * The map is cached as one SDL texture per chunk of cells on screen,
+ * from a small pool, and only the chunks whose cells changed are drawn
+ * and uploaded again, so even the largest maze costs a few small
+ * uploads on the frames it changes.
+ * The map can also show the first steps of a path, such as the way out.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <stdbool.h>   // for the bool type
+#include <SDL3/SDL.h>  // for the renderer
+#include "maze.h"      // for the maze being mapped
+#include "player.h"    // for the player pose
+#include "solver.h"    // for the steps of a path
+
+#define MINIMAP_CHUNK_CELLS  64   // cells per side of one cached chunk
+#define MINIMAP_PATH_STEPS   256  // most steps of a path the map shows
+
+// The state of the minimap, opaque outside its module
+struct Minimap;
+
+
+/**
+ * @brief Allocates a minimap of a maze with nothing explored yet.
+ *
+ * The explored bits take one bit per cell, but they're zeroed lazily by
+ * the system, so a huge maze only pays for the pages the player reaches.
+ * The textures are all created here, so drawing never allocates one.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pMaze     Pointer to the maze to be mapped.
+ * @param pRenderer Pointer to the renderer the textures belong to.
+ * @return          Pointer to the new minimap; `NULL` on failure.
+ */
+struct Minimap *minimap_create(
+    const struct Maze *restrict pMaze,
+    SDL_Renderer *restrict pRenderer
+);
+
+
+/**
+ * @brief Marks the cells the player can see from where they stand as explored.
+ *
+ * That's the player's cell and every cell straight down each corridor
+ * leading out of it, up to a limit. Does nothing until the player moves
+ * to another cell, so it's cheap to call every frame.
+ *
+ * @param pMinimap Pointer to the minimap.
+ * @param pMaze    Pointer to the maze being mapped.
+ * @param pPose    Pointer to the player's pose.
+ */
+void minimap_explore(
+    struct Minimap *restrict pMinimap,
+    const struct Maze *restrict pMaze,
+    const struct PlayerPose *restrict pPose
+);
+
+
+/**
+ * @brief Shows a path on the map, replacing any path shown before.
+ * @param pMinimap Pointer to the minimap.
+ * @param x        Column of the cell the path starts from.
+ * @param y        Row of the cell the path starts from.
+ * @param steps    The steps of the path, in order.
+ * @param count    Number of steps, up to `MINIMAP_PATH_STEPS`; 0 to show
+ *                 no path.
+ */
+void minimap_showPath(
+    struct Minimap *restrict pMinimap,
+    int x,
+    int y,
+    const enum SolverStep *restrict steps,
+    int count
+);
+
+
+/**
+ * @brief Moves everything on the map by whole chunks, as when the maze moves.
+ *
+ * Cells moved off the map are forgotten, and those moved onto it start
+ * out unexplored. Any path shown moves along.
+ *
+ * @param pMinimap Pointer to the minimap.
+ * @param xShift   Cells to add to every column; a multiple of
+ *                 `MINIMAP_CHUNK_CELLS`.
+ * @param yShift   Cells to add to every row.
+ */
+void minimap_shift(struct Minimap *restrict pMinimap, int xShift, int yShift);
+
+
+/**
+ * @brief Draws the map around the player in the top right of the render target.
+ *
+ * Draws and uploads any chunk on screen that changed since it was last
+ * drawn; chunks off screen wait until they're on screen again.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pMinimap  Pointer to the minimap.
+ * @param pRenderer Pointer to the renderer to draw with.
+ * @param pMaze     Pointer to the maze being mapped.
+ * @param pPose     Pointer to the player's pose, to center the map on.
+ * @return          True on success; false if a chunk's texture couldn't
+ *                  be updated.
+ */
+bool minimap_draw(
+    struct Minimap *restrict pMinimap,
+    SDL_Renderer *restrict pRenderer,
+    const struct Maze *restrict pMaze,
+    const struct PlayerPose *restrict pPose
+);
+
+
+/**
+ * @brief Frees the minimap and its textures, and sets its pointer to `NULL`.
+ *
+ * Call this before destroying the renderer its textures belong to.
+ *
+ * @param ppMinimap Pointer to the minimap pointer; can point to `NULL`.
+ */
+void minimap_destroy(struct Minimap **ppMinimap);
+
+#endif  // MINIMAP_H
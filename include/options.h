@@ -0,0 +1,78 @@
+/**
+ * @file  options.h
+ * @brief Header for the options module, which parses the command line.
+ *
+ * Declares the interface for the options module. Defines every setting
+ * the user can change from the command line and enables the caller to
+ * fill them in from the arguments passed to `main()`.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdbool.h>   // for the bool type
+#include <stdint.h>    // for fixed-width integer types
+#include "raycast.h"   // for the ray casting kernels
+
+#define DEFAULT_MAZE_SIZE      32     // cells per side unless told otherwise
+#define DEFAULT_WINDOW_WIDTH   1280   // windowed and benchmark width
+#define DEFAULT_WINDOW_HEIGHT  720    // windowed and benchmark height
+#define MAX_RESOLUTION         16384  // most pixels per side
+#define MAX_BENCH_FRAMES       1000000
+#define MAX_FPS_CAP            1000
+#define DEFAULT_TRACE_FRAMES   120    // frames in a trace unless told otherwise
+#define MAX_TRACE_FRAMES       1000
+
+/**
+ * @brief The settings chosen on the command line.
+ *
+ * You should consider this struct read-only. You may access its members
+ * directly for read convenience and efficiency, but let the interface
+ * functions modify them.
+ */
+struct GameOptions
+{
+    bool               isWindowed;     ///< -windowed: start out of full screen
+    bool               isVsyncOff;     ///< -novsync: don't wait for VSync
+    bool               isDynResOff;    ///< -nodynres: always draw at full size
+    bool               isSkipOff;      ///< -noskip: trace open space cell by cell
+    bool               isCheckOff;     ///< -nocheck: don't solve generated mazes
+    bool               isEndless;      ///< -endless: stream a maze with no edges
+    bool               isIndexed;      ///< -indexed: draw in 256 colors
+    bool               isInterlaced;   ///< -interlaced: draw every other column
+    enum RaycastKernel raycastKernel;  ///< -simd <kernel>: force a ray caster
+    int                threadCount;    ///< -threads <n>: 0 for one per core
+    int                mazeWidth;      ///< -size <w>[x<h>]: cells per row
+    int                mazeHeight;     ///< -size <w>[x<h>]: number of rows
+    bool               hasSeed;        ///< was -seed given?
+    uint64_t           seed;           ///< -seed <n>: fixes the maze
+    const char        *loadPath;       ///< -load <file>: maze file to map
+    const char        *savePath;       ///< -save <file>: where to save the maze
+    int                width;          ///< -resolution <w>x<h>: window width
+    int                height;         ///< -resolution <w>x<h>: window height
+    int                benchFrames;    ///< -bench <n>: 0 to play instead
+    int                fpsCap;         ///< -fps <n>: 0 for no cap
+    const char        *tracePath;      ///< -trace <file>: where to save a trace
+    int                traceFrames;    ///< -traceframes <n>: frames to save
+    const char        *recordPath;     ///< -record <file>: where to log input
+    const char        *replayPath;     ///< -replay <file>: input log to play
+    const char        *capturePath;    ///< -capture <file>: where to record video
+};
+
+
+/**
+ * @brief Fills in the options from the command-line arguments.
+ *
+ * Options not given on the command line keep their defaults. Invalid
+ * arguments are skipped after printing a warning, so this never fails.
+ *
+ * @param argc     Number of command-line arguments from main(), if any.
+ * @param argv     List of command-line arguments from main(); can be null.
+ * @param pOptions Pointer to the options to be filled in.
+ */
+void options_parse(int argc, char **argv, struct GameOptions *restrict pOptions);
+
+#endif  // OPTIONS_H
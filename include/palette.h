@@ -0,0 +1,152 @@
+/**
+ * @file  palette.h
+ * @brief Header for the palette module, which draws in 256 colors.
+ *
+ * Declares the interface for the palette module. Enables the caller to
+ * pick 256 colors that best cover a set of textures at every brightness
+ * they're drawn at, to look up any of those colors shaded to a light
+ * level as another of them, and to expand rows of palette indices back
+ * to full color with the fastest kernel the CPU supports.
+ *
+ * Drawing a view in indices writes a quarter of the bytes drawing it in
+ * full color does, and shading a texel takes a table lookup rather than
+ * a multiply per channel, the way the COLORMAP of the old DOS shooters
+ * did it.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "raycast.h"  // for the kernel choices
+#include "texture.h"  // for the textures to cover
+#include "utils.h"    // for arenas
+
+#define PALETTE_SIZE          256  ///< colors in the palette, index 0 included
+#define PALETTE_LIGHT_LEVELS  32   ///< brightnesses each color is shaded to
+#define PALETTE_CLEAR         0    ///< index of clear texels, which stay clear
+
+/**
+ * @brief The colors of a palette and every color shaded to every light level.
+ *
+ * Light level `l` is a brightness of `(l + 1) / PALETTE_LIGHT_LEVELS`,
+ * so the last level leaves colors as they are. You should consider this
+ * struct read-only.
+ */
+struct Palette
+{
+    uint32_t colors[PALETTE_SIZE];                        ///< 0xAARRGGBB colors
+    uint8_t  shades[PALETTE_LIGHT_LEVELS][PALETTE_SIZE];  ///< shaded indices
+};
+
+
+/**
+ * @brief Gets how much arena space `palette_create` needs.
+ * @return Bytes to reserve, alignment padding included.
+ */
+size_t palette_getArenaSize(void);
+
+
+/**
+ * @brief Picks the colors that best cover a set of textures, and shades them.
+ *
+ * Reads the largest level of each texture, skipping its clear texels,
+ * at several brightnesses, so that there are colors for distant walls
+ * as well as near ones. Takes a moment, so it's meant for startup.
+ * Prints its own error message on failure.
+ *
+ * @param textures     The textures to cover.
+ * @param textureCount Number of textures.
+ * @param pArena       Pointer to the arena that holds the palette from now on.
+ * @return             Pointer to the palette; `NULL` on failure.
+ */
+struct Palette *palette_create(
+    const struct Texture *const *textures,
+    int textureCount,
+    struct Arena *restrict pArena
+);
+
+
+/**
+ * @brief Finds the palette's closest color to any color.
+ * @param pPalette Pointer to the palette.
+ * @param color    0xAARRGGBB color; alpha is ignored.
+ * @return         Index of the closest color, never `PALETTE_CLEAR`.
+ */
+uint8_t palette_findNearest(const struct Palette *restrict pPalette, uint32_t color);
+
+
+/**
+ * @brief Gets the row of shaded indices for a brightness.
+ * @param pPalette Pointer to the palette.
+ * @param shade    Brightness out of 256, as `texture_shadeColor` takes it.
+ * @return         The row of `shades` for the nearest light level.
+ */
+static inline const uint8_t *palette_getShades(
+    const struct Palette *restrict pPalette,
+    uint32_t shade
+) {
+    int level = (int)(shade + 4) / (256 / PALETTE_LIGHT_LEVELS) - 1;
+
+    if (level < 0)
+        level = 0;
+    else if (level >= PALETTE_LIGHT_LEVELS)
+        level = PALETTE_LIGHT_LEVELS - 1;
+
+    return pPalette->shades[level];
+}
+
+
+/**
+ * @brief Picks the expansion kernel for the instruction set of a ray casting kernel.
+ *
+ * Works like `flats_selectKernel`; the fixed-point ray casting kernel
+ * gets the scalar expansion kernel.
+ *
+ * @param kernel The ray casting kernel in use; not `RAYCAST_AUTO`.
+ */
+void palette_selectKernel(enum RaycastKernel kernel);
+
+
+/**
+ * @brief Expands a row of indices to full color with the selected kernel.
+ * @param indices Indices to expand.
+ * @param pixels  Where to put their colors.
+ * @param count   Number of indices.
+ * @param colors  The palette's colors.
+ */
+void palette_expandRow(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+);
+
+
+/**
+ * @brief The individual kernels, with the same contract as `palette_expandRow`.
+ */
+void palette_expandRowScalar(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+);
+void palette_expandRowSSE2(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+);
+void palette_expandRowAVX2(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+);
+
+#endif  // PALETTE_H
@@ -3,8 +3,8 @@
  * @brief Header for the player module, which handles player-specific logic.
  *
  * Declares the interface for the player module. Enables the caller to
- * initialize a player, update player state, and clean up player-related
- * resources.
+ * initialize a player in an arena, update player state, and read back
+ * where it stands.
  * 
  * @author Joseph Borjon
  * @date   2024-12-31
@@ -13,6 +13,8 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include "maze.h"  // for the maze the player moves through
+
 /**
  * @brief Container for all player properties.
  *
@@ -22,6 +24,34 @@
  */
 struct Player;
 
+/**
+ * @brief Snapshot of where the player stands and which way it's facing.
+ *
+ * Lets other subsystems, such as the renderer, read the player's
+ * position and direction without access to the rest of its state.
+ */
+struct PlayerPose
+{
+    double xPos;  ///< x-position in the game world, in cell units
+    double yPos;  ///< y-position in the game world, in cell units
+    double xDir;  ///< x-component of the unit facing direction
+    double yDir;  ///< y-component of the unit facing direction
+};
+
+/**
+ * @brief What the user is asking the player to do, held from step to step.
+ *
+ * Each member but `look` ranges from -1 to 1, as a fraction of the
+ * player's top speed in that direction.
+ */
+struct PlayerInput
+{
+    float forward;  ///< walk forward (positive) or backward (negative)
+    float strafe;   ///< sidestep right (positive) or left (negative)
+    float turn;     ///< turn right (positive) or left (negative)
+    float look;     ///< radians to turn right on top of `turn`, this step only
+};
+
 
 /**
  * @brief Initializes a player and returns a pointer to it.
@@ -31,9 +61,13 @@ struct Player;
  * running player-specific logic; i.e., don't ever pass an uninitialized
  * or null pointer to player-related functions.
  *
- * @return Pointer to the just-initialized player context; `NULL` on failure.
+ * The player lives in the arena and goes away with it.
+ *
+ * @param pArena Arena to allocate the player from.
+ * @return       Pointer to the just-initialized player context; `NULL` on failure.
  */
 struct Player *player_init(
+    struct Arena *restrict pArena,
     double startingXPos,
     double startingYPos,
     double startingXDir,
@@ -42,16 +76,81 @@ struct Player *player_init(
 
 
 /**
- * @brief Updates the player state based on the data passed in.
+ * @brief Initializes a player at the maze's start and returns a pointer to it.
+ *
+ * Stands in the middle of cell (0, 0), facing an open passage, so every
+ * game and replay of the same maze starts out the same way.
+ *
+ * @param pArena Arena to allocate the player from.
+ * @param pMaze  Pointer to the maze the player is in.
+ * @return       Pointer to the just-initialized player context; `NULL` on failure.
+ */
+struct Player *player_initAtStart(
+    struct Arena *restrict pArena,
+    const struct Maze *restrict pMaze
+);
+
+
+/**
+ * @brief Advances the player by one simulation step.
+ *
+ * The player is a circle that slides along any walls it walks into.
+ * Meant to be called with the same step length every time, so that the
+ * player moves the same way at any frame rate.
+ *
+ * @param pPlayer Pointer to the player context.
+ * @param pInput  Pointer to what the user is asking for during the step.
+ * @param pMaze   Pointer to the maze the player is in.
+ * @param seconds Length of the step in seconds.
+ */
+void player_update(
+    struct Player *restrict pPlayer,
+    const struct PlayerInput *restrict pInput,
+    const struct Maze *restrict pMaze,
+    double seconds
+);
+
+
+/**
+ * @brief Moves the player by whole cells, without any collision.
+ *
+ * For when the maze itself moves under the player, as a streamed one
+ * does, leaving them in the same spot in it.
+ *
+ * @param pPlayer Pointer to the player context.
+ * @param xShift  Cells to move in x.
+ * @param yShift  Cells to move in y.
+ */
+void player_shift(struct Player *restrict pPlayer, int xShift, int yShift);
+
+
+/**
+ * @brief Copies the player's current position and direction into a pose.
  * @param pPlayer Pointer to the player context.
+ * @param pPose   Pointer to the pose to be filled in.
  */
-void player_update(struct Player *restrict pPlayer);
+void player_getPose(
+    const struct Player *restrict pPlayer,
+    struct PlayerPose *restrict pPose
+);
 
 
 /**
- * @brief Deallocates the player and sets its pointer to `NULL`.
- * @param ppPlayer Pointer to the player-context pointer to be deallocated.
+ * @brief Blends two poses, such as those before and after a simulation step.
+ *
+ * Lets the renderer show the player between simulation steps, so motion
+ * stays smooth when frames and steps don't line up.
+ *
+ * @param pFrom  Pointer to the pose at `alpha` 0.
+ * @param pTo    Pointer to the pose at `alpha` 1.
+ * @param alpha  How far to go from `pFrom` to `pTo`, from 0 to 1.
+ * @param pPose  Pointer to the pose to be filled in; may be either input.
  */
-void player_destroy(struct Player *restrict *ppPlayer);
+void player_interpolatePoses(
+    const struct PlayerPose *pFrom,
+    const struct PlayerPose *pTo,
+    double alpha,
+    struct PlayerPose *pPose
+);
 
 #endif  // PLAYER_H
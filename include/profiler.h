@@ -0,0 +1,157 @@
+/**
+ * @file  profiler.h
+ * @brief Header for the profiler module, which times the phases of a frame.
+ *
+ * Declares the interface for the profiler module. Enables the caller to
+ * mark where each phase of a frame (a zone) begins and ends on any
+ * thread, read back how long each zone took on average, and save the
+ * last frames as a Chrome trace (chrome://tracing or Perfetto).
+ *
+ * Build without `MAZECAST_PROFILE` defined and every macro and function
+ * here compiles to nothing.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>  // for the bool type
+
+/**
+ * @brief The phases of a frame that the profiler can time.
+ */
+enum ProfileZone
+{
+    ZONE_INPUT,       ///< input_pumpEvents, once per frame
+    ZONE_ACTIONS,     ///< processing the queued game actions
+    ZONE_SIMULATION,  ///< the fixed simulation steps, player_update included
+    ZONE_RENDER,      ///< drawing the whole view
+    ZONE_RAYCAST,     ///< casting and drawing one strip, on any thread
+    ZONE_SPRITES,     ///< drawing the sprites over one strip, on any thread
+    ZONE_UPLOAD,      ///< copying the frame into its texture
+    ZONE_PRESENT,     ///< SDL_RenderPresent
+    ZONE_CAPTURE,     ///< copying the frame for a screenshot or video
+    ZONE_WAIT,        ///< sleeping under the frame rate cap
+    NUM_PROFILE_ZONES
+};
+
+#ifdef MAZECAST_PROFILE
+
+#define PROFILER_IS_BUILT  true  // lets code check without its own #ifdef
+
+/**
+ * @brief Marks the beginning of a zone on a thread.
+ * @param zone   The zone being entered.
+ * @param thread Index of the calling thread: 0 for the main thread, or
+ *               the worker index for pool tasks.
+ */
+#define PROFILE_BEGIN(zone, thread)  profiler_record((zone), (thread), true)
+
+/**
+ * @brief Marks the end of a zone on a thread, which must have begun it.
+ * @param zone   The zone being left.
+ * @param thread Index of the calling thread, as given to `PROFILE_BEGIN`.
+ */
+#define PROFILE_END(zone, thread)  profiler_record((zone), (thread), false)
+
+
+/**
+ * @brief Allocates a buffer of recent events for each thread.
+ *
+ * Prints its own error message on failure, after which recording
+ * quietly does nothing.
+ *
+ * @param threadCount Number of threads that will record, the main one
+ *                    included.
+ * @return            True on success; false on failure.
+ */
+bool profiler_init(int threadCount);
+
+
+/**
+ * @brief Records the beginning or end of a zone; use the macros instead.
+ *
+ * Each thread writes only to its own buffer, so no locks are taken.
+ * Does nothing until `profiler_init` succeeds.
+ *
+ * @param zone    The zone.
+ * @param thread  Index of the calling thread.
+ * @param isBegin True at the beginning of the zone; false at the end.
+ */
+void profiler_record(enum ProfileZone zone, int thread, bool isBegin);
+
+
+/**
+ * @brief Closes the current frame and adds its zones to the averages.
+ *
+ * Must be called by the main thread between frames, while no other
+ * thread is recording.
+ */
+void profiler_endFrame(void);
+
+
+/**
+ * @brief Gets how long a zone has been taking per frame, recently.
+ *
+ * Zones that run on several threads add up the time across them.
+ *
+ * @param zone The zone.
+ * @return     Smoothed milliseconds per frame.
+ */
+double profiler_getZoneMs(enum ProfileZone zone);
+
+
+/**
+ * @brief Gets the name of a zone, as shown in the overlay and the trace.
+ * @param zone The zone.
+ * @return     The name; "unknown" for anything out of range.
+ */
+const char *profiler_getZoneName(enum ProfileZone zone);
+
+
+/**
+ * @brief Saves the most recent frames as Chrome trace event JSON.
+ *
+ * Frames that no longer fit in the buffers are left out. Must be called
+ * while no other thread is recording. Prints its own error messages on
+ * failure.
+ *
+ * @param path       Path to the file to be written.
+ * @param frameCount How many of the most recent frames to save.
+ * @return           True on success; false on failure.
+ */
+bool profiler_writeTrace(const char *path, int frameCount);
+
+
+/**
+ * @brief Frees the event buffers.
+ */
+void profiler_destroy(void);
+
+#else
+
+#define PROFILER_IS_BUILT            false
+#define PROFILE_BEGIN(zone, thread)  ((void)0)
+#define PROFILE_END(zone, thread)    ((void)0)
+
+static inline bool profiler_init(int threadCount) { (void)threadCount; return true; }
+static inline void profiler_endFrame(void) {}
+static inline double profiler_getZoneMs(enum ProfileZone zone) { (void)zone; return 0.0; }
+static inline const char *profiler_getZoneName(enum ProfileZone zone)
+{
+    (void)zone;
+    return "unknown";
+}
+static inline bool profiler_writeTrace(const char *path, int frameCount)
+{
+    (void)path;
+    (void)frameCount;
+    return false;
+}
+static inline void profiler_destroy(void) {}
+
+#endif  // MAZECAST_PROFILE
+
+#endif  // PROFILER_H
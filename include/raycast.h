@@ -0,0 +1,169 @@
+/**
+ * @file  raycast.h
+ * @brief Header for the raycast module, which traces rays through the map.
+ *
+ * Declares the interface for the raycast module. Enables the caller to
+ * pick the fastest ray casting kernel the CPU supports (or force a
+ * specific one), then trace whole batches of rays through a maze with
+ * it to find how far each one travels before hitting a wall.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef RAYCAST_H
+#define RAYCAST_H
+
+#include <stdbool.h>  // for the bool type
+#include <stdint.h>   // for fixed-width integer types
+#include "maze.h"     // for the maze walls
+
+// The highest number of rays traced by a single call; a multiple of 8
+#define RAY_BATCH_SIZE  64
+
+// Angles per full turn for the fixed-point kernel; a power of 2
+#define RAYCAST_FINE_ANGLES  16384
+
+// 1.0 in the Q16.16 fixed-point format: 16 integer bits, 16 fraction bits
+#define RAYCAST_FIXED_ONE  (1 << 16)
+
+/**
+ * @brief The available ray casting kernels.
+ *
+ * Each kernel walks the grid the same way, but the SIMD ones step
+ * several rays in lockstep in single precision, so their distances can
+ * differ from the scalar kernel's in the last few bits. The fixed-point
+ * kernel is only ever picked on request; it rounds each ray to the
+ * nearest fine angle, so its distances differ a little more.
+ *
+ * Where the maze has a distance field, every kernel but the fixed-point
+ * one crosses open space several cells at a time; that one still steps
+ * through it one cell at a time.
+ */
+enum RaycastKernel
+{
+    RAYCAST_AUTO,        ///< pick the best kernel the CPU supports
+    RAYCAST_SCALAR,      ///< one ray at a time, in double precision
+    RAYCAST_SSE2,        ///< four rays at a time with SSE2
+    RAYCAST_AVX2,        ///< eight rays at a time with AVX2
+    RAYCAST_FIXED,       ///< one ray at a time, in Q16.16, with no divides
+    NUM_RAYCAST_KERNELS  ///< total number of kernel choices
+};
+
+/**
+ * @brief A batch of rays to trace, along with where each one hit.
+ *
+ * Fill in `count` and the first `count` ray directions, then pass the
+ * batch to `raycast_castRays`, which fills in the hit arrays. Entries
+ * past `count`, up to the next multiple of 8, must also hold valid ray
+ * directions (repeating the last one is fine) since the SIMD kernels
+ * trace whole groups of lanes; their results are to be ignored.
+ *
+ * The fixed-point kernel reads each ray as an angle instead, plus the
+ * cosine of its angle from the view axis, so fill those in too.
+ */
+struct RayBatch
+{
+    float   xRayDirs[RAY_BATCH_SIZE];   ///< x-components of the ray directions
+    float   yRayDirs[RAY_BATCH_SIZE];   ///< y-components of the ray directions
+    int32_t angles[RAY_BATCH_SIZE];     ///< ray directions, in fine angles
+    int32_t fisheyes[RAY_BATCH_SIZE];   ///< Q16.16 cosines from the view axis
+    float   distances[RAY_BATCH_SIZE];  ///< hit distances from the camera plane
+    uint8_t isYSides[RAY_BATCH_SIZE];   ///< 1 if the wall hit faces north/south
+    int     count;                      ///< number of rays in the batch
+};
+
+
+/**
+ * @brief Chooses the kernel used by all subsequent calls to `raycast_castRays`.
+ *
+ * Detects the instruction sets the CPU supports at run time. If the
+ * requested kernel isn't supported by the CPU or the build, it prints a
+ * warning and falls back to the best kernel that is.
+ *
+ * @param requested The kernel to use, or `RAYCAST_AUTO` to let it choose.
+ * @return          The kernel actually selected; never `RAYCAST_AUTO`.
+ */
+enum RaycastKernel raycast_selectKernel(enum RaycastKernel requested);
+
+
+/**
+ * @brief Gets the name of a kernel as accepted on the command line.
+ * @param kernel The kernel to be named.
+ * @return       Lowercase name of the kernel, such as "avx2".
+ */
+const char *raycast_getKernelName(enum RaycastKernel kernel);
+
+
+/**
+ * @brief Checks whether a kernel skips open space with a maze's distance field.
+ * @param kernel The kernel in question; not `RAYCAST_AUTO`.
+ * @return       True if the kernel reads the field, false if it ignores it.
+ */
+bool raycast_usesDistances(enum RaycastKernel kernel);
+
+
+/**
+ * @brief Converts an angle to the nearest fine angle, without wrapping it.
+ * @param radians The angle in radians; positive turns from +x toward +y.
+ * @return        The angle in units of a full turn / `RAYCAST_FINE_ANGLES`.
+ */
+int32_t raycast_toFineAngle(double radians);
+
+
+/**
+ * @brief Traces every ray in the batch with the selected kernel.
+ * @param pMaze Pointer to the maze.
+ * @param xPos  x-position all rays start from; must be inside the maze.
+ * @param yPos  y-position all rays start from; must be inside the maze.
+ * @param pRays Pointer to the batch of rays, which receives the hits.
+ */
+void raycast_castRays(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+
+
+/**
+ * @brief Kernel implementations, one per instruction set.
+ *
+ * Same contract as `raycast_castRays`. Call that instead unless you need
+ * a specific kernel regardless of what the CPU supports.
+ */
+void raycast_castRaysScalar(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+void raycast_castRaysSSE2(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+void raycast_castRaysAVX2(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+void raycast_castRaysFixed(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+
+
+/**
+ * @brief Builds the tables the fixed-point kernel looks its steps up in.
+ *
+ * Called by `raycast_selectKernel` on picking that kernel; call it
+ * yourself before calling `raycast_castRaysFixed` directly.
+ */
+void raycast_initFixedTables(void);
+
+#endif  // RAYCAST_H
@@ -0,0 +1,279 @@
+/**
+ * @file  render.h
+ * @brief Header for the render module, which draws the 3D view.
+ *
+ * Declares the interface for the render module. Enables the caller to
+ * create a CPU-side framebuffer, ray cast the world into it from the
+ * player's point of view, and destroy it once it's no longer needed.
+ * Getting the pixels onto the screen is left to the caller, which can
+ * ask which of them changed since it last did, and skip drawing views
+ * that would come out the same as the one already in the framebuffer.
+ *
+ * Items in the maze are drawn over the walls as flat sprites that always
+ * face the viewer, hidden in any column where a wall is nearer.
+ *
+ * Views can be interlaced, drawing only every other column and leaving
+ * the rest as the last view drew them, for about half the rays, as long
+ * as the viewer turns slowly enough that the difference hardly shows.
+ *
+ * A framebuffer can also be drawn in 256 colors, as palette indices
+ * shaded by table lookup, and expanded to full color only as it's
+ * copied out.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "maze.h"     // for the maze to be drawn
+#include "palette.h"  // for drawing in 256 colors
+#include "player.h"   // for the player pose
+#include "sprites.h"  // for the items in the maze
+#include "texture.h"  // for the wall texture
+#include "workers.h"  // for the worker pool
+
+/**
+ * @brief Per-column ray setup that only depends on the view's size.
+ *
+ * The field of view follows the aspect ratio, so these are rebuilt
+ * along with the framebuffer and never per frame. Each table runs on
+ * into the padding at the end of a row, for kernels that overshoot.
+ */
+struct ColumnTables
+{
+    float   *cameraXs;       ///< camera plane offsets, scaled to the FOV
+    int32_t *angleOffsets;   ///< ray angles from the view axis, in fine angles
+    int32_t *fisheyes;       ///< Q16.16 cosines of those angles
+    float   *fieldCameraXs;  ///< offsets of the even columns, then the odd ones
+};
+
+
+/**
+ * @brief The textures a view is drawn with.
+ */
+struct ViewTextures
+{
+    const struct Texture *wall;                        ///< every wall
+    const struct Texture *floor;                       ///< the floor
+    const struct Texture *ceiling;                     ///< the ceiling
+    const struct Texture *sprites[SPRITE_KIND_COUNT];  ///< each kind of item
+    const struct Palette *palette;                     ///< their indices' colors
+};
+
+
+/**
+ * @brief A rectangle of pixels within a framebuffer; empty if either size is 0.
+ */
+struct FrameRegion
+{
+    int x;       ///< leftmost column
+    int y;       ///< top row
+    int width;   ///< number of columns
+    int height;  ///< number of rows
+};
+
+
+// A sprite as it lands on the screen, opaque outside the render module
+struct ScreenSprite;
+
+
+/**
+ * @brief A block of ARGB8888 pixels, or of palette indices, the renderer draws into.
+ *
+ * Rows are padded so that each one starts on its own cache line, which
+ * is why `pitch` can be larger than `width`. An indexed framebuffer has
+ * `indices` and no `pixels`, and the other way around. You should
+ * consider this struct read-only outside the render module.
+ */
+struct Framebuffer
+{
+    uint32_t *restrict    pixels;       ///< 0xAARRGGBB pixels in row-major order
+    uint8_t *restrict     indices;      ///< palette indices in row-major order
+    int                   width;        ///< visible pixels per row
+    int                   height;       ///< number of rows
+    int                   maxWidth;     ///< widest view the rows have room for
+    int                   maxHeight;    ///< tallest view there are rows for
+    int                   pitch;        ///< distance between rows, in pixels
+    int                   indexPitch;   ///< distance between rows, in indices
+    struct ColumnTables   columns;      ///< one entry per visible column
+    float                *depths;       ///< each column's wall distance, last view
+    struct ScreenSprite  *sprites;      ///< room to sort the sprites in view
+    uint32_t             *fieldRow;     ///< a row of floor for every other column
+    const struct Palette *palette;      ///< colors the indices were drawn in
+    uint64_t              texelBytes;   ///< wall texture bytes the last view read
+    int                   rayCount;     ///< rays the last view cast
+    int                   field;        ///< columns to interlace next: 0 even, 1 odd
+    struct FrameRegion    dirty;        ///< pixels changed since last taken
+    struct PlayerPose     viewPose;     ///< pose the pixels were drawn from
+    uint32_t              viewItems;    ///< generation of the items drawn
+    bool                  hasView;      ///< have the pixels been drawn at all?
+    bool                  isViewMixed;  ///< are some columns from an older pose?
+};
+
+
+/**
+ * @brief Allocates a framebuffer of the given size and its column tables.
+ *
+ * The size is also the largest the view can be set to later with
+ * `render_setViewSize`.
+ *
+ * Prints its own error message on failure, in which case the
+ * framebuffer is left empty and safe to pass to `render_destroyFramebuffer`.
+ *
+ * @param pFrame    Pointer to the framebuffer to be set up.
+ * @param width     Width in pixels; must be positive.
+ * @param height    Height in pixels; must be positive.
+ * @param isIndexed Whether to draw in palette indices rather than pixels,
+ *                  which takes textures created with indices.
+ * @return          True on success; false on failure.
+ */
+bool render_initFramebuffer(
+    struct Framebuffer *pFrame,
+    int width,
+    int height,
+    bool isIndexed
+);
+
+
+/**
+ * @brief Changes the size of the view drawn into a framebuffer, without allocating.
+ *
+ * The view is drawn into the top-left corner of the framebuffer, with
+ * the row pitch it was allocated with. Rebuilds the column tables for
+ * the new size; the next view is drawn from scratch.
+ *
+ * @param pFrame Pointer to the framebuffer.
+ * @param width  Width in pixels; from 1 to `maxWidth`.
+ * @param height Height in pixels; from 1 to `maxHeight`.
+ */
+void render_setViewSize(struct Framebuffer *restrict pFrame, int width, int height);
+
+
+/**
+ * @brief Gets how much arena space `render_createTextures` needs.
+ * @return Bytes to reserve, alignment padding included.
+ */
+size_t render_getTexturesArenaSize(void);
+
+
+/**
+ * @brief Builds every texture a view is drawn with in an arena.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pTextures Pointer to the textures to be set up.
+ * @param pArena    Pointer to the arena that holds them from now on.
+ * @param isIndexed Whether to also pick a palette for the textures and
+ *                  index them with it, for indexed framebuffers.
+ * @return          True on success; false on failure.
+ */
+bool render_createTextures(
+    struct ViewTextures *restrict pTextures,
+    struct Arena *restrict pArena,
+    bool isIndexed
+);
+
+
+/**
+ * @brief Ray casts the maze as seen from the given pose into the framebuffer.
+ * @param pFrame       Pointer to the framebuffer to draw into.
+ * @param pPose        Pointer to the pose of the viewer.
+ * @param pMaze        Pointer to the maze to be drawn.
+ * @param pTextures    Pointer to the textures to draw with.
+ * @param pSprites     Pointer to the items to draw over the walls; can be
+ *                     null to draw none.
+ * @param pPool        Pointer to the pool that draws the view in vertical
+ *                     strips; can be null to draw it on the calling thread.
+ * @param isInterlaced Whether to draw only every other column, the even
+ *                     and odd ones by turns, when the view turned only a
+ *                     little since the last one. Views that turned more,
+ *                     and first views, are drawn whole either way.
+ *
+ * Overwrites every visible pixel, or every other column of them, so
+ * there is no need to clear first, and marks all of them dirty. Only
+ * the items in cells the view could reach are looked at, and the ones
+ * in view are drawn from back to front, with no allocation. Also counts
+ * how many bytes of wall texture the view read, in whole cache lines
+ * per column, into the framebuffer's `texelBytes`, and how many rays it
+ * cast into `rayCount`.
+ */
+void render_drawView(
+    struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose,
+    const struct Maze *restrict pMaze,
+    const struct ViewTextures *restrict pTextures,
+    const struct SpriteSet *pSprites,
+    struct WorkerPool *pPool,
+    bool isInterlaced
+);
+
+
+/**
+ * @brief Checks whether drawing from a pose would leave the framebuffer as it is.
+ *
+ * True once a view has been drawn from the very same pose, to the bit,
+ * and with the items as they are now, since the framebuffer was set up,
+ * and every column was drawn that way rather than some left over from
+ * an interlaced view before. The maze and its textures are taken to stay
+ * the same for the life of the framebuffer.
+ *
+ * @param pFrame   Pointer to the framebuffer.
+ * @param pPose    Pointer to the pose the next view would be drawn from.
+ * @param pSprites Pointer to the items it would draw; can be null.
+ * @return         True if the view in the framebuffer is up to date.
+ */
+bool render_isViewCurrent(
+    const struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose,
+    const struct SpriteSet *pSprites
+);
+
+
+/**
+ * @brief Gets the region drawn since the last call, and starts over with none.
+ *
+ * Lets the caller copy out only the pixels that changed. The region is
+ * the bounding box of everything drawn, so it may include some that
+ * came out the same.
+ *
+ * @param pFrame  Pointer to the framebuffer.
+ * @param pRegion Pointer to where to store the region.
+ * @return        True if the region is not empty.
+ */
+bool render_takeDirtyRegion(
+    struct Framebuffer *restrict pFrame,
+    struct FrameRegion *restrict pRegion
+);
+
+
+/**
+ * @brief Copies a region of the framebuffer out as ARGB8888 pixels.
+ *
+ * Indices are expanded to their colors along the way, with the fastest
+ * kernel the palette module was told the CPU supports.
+ *
+ * @param pFrame   Pointer to the framebuffer.
+ * @param pRegion  Pointer to the region to copy; must lie within the frame.
+ * @param pDst     Where to copy the region's top-left pixel to.
+ * @param dstPitch Distance between rows at the destination, in bytes.
+ */
+void render_copyRegion(
+    const struct Framebuffer *restrict pFrame,
+    const struct FrameRegion *restrict pRegion,
+    void *restrict pDst,
+    int dstPitch
+);
+
+
+/**
+ * @brief Frees the framebuffer's pixels and tables and zeroes out its dimensions.
+ * @param pFrame Pointer to the framebuffer.
+ */
+void render_destroyFramebuffer(struct Framebuffer *pFrame);
+
+#endif  // RENDER_H
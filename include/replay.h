@@ -0,0 +1,143 @@
+/**
+ * @file  replay.h
+ * @brief Header for the replay module, which records and replays input.
+ *
+ * Declares the interface for the replay module. Enables the caller to
+ * record every game action to a log file, tagged with the simulation
+ * step it took effect before, and to play a log back later in place of
+ * live input. The simulation only reads input between steps, so a log
+ * played back in the same maze moves the player exactly as recorded.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>  // for the bool type
+#include <stdint.h>   // for fixed-width integer types
+#include "input.h"    // for the game actions
+#include "maze.h"     // for the maze the log was recorded in
+#include "options.h"  // for pointing the options at that maze
+
+/**
+ * @brief An input log, either being recorded or being played back.
+ */
+struct Replay;
+
+
+/**
+ * @brief Creates a log file and starts recording to it.
+ *
+ * Prints its own error messages on failure.
+ *
+ * @param path  Path to the file to be written, replacing any already there.
+ * @param pMaze Pointer to the maze being played, noted in the log.
+ * @return      Pointer to the new recording; `NULL` on failure.
+ */
+struct Replay *replay_startRecording(
+    const char *restrict path,
+    const struct Maze *restrict pMaze
+);
+
+
+/**
+ * @brief Appends an action to a recording.
+ *
+ * Actions must be recorded in order, and their steps can only go up.
+ * Prints its own error message on failure.
+ *
+ * @param pReplay Pointer to the recording.
+ * @param step    Number of simulation steps taken before the action.
+ * @param pAction Pointer to the action.
+ * @return        True on success; false on failure.
+ */
+bool replay_record(
+    struct Replay *restrict pReplay,
+    uint32_t step,
+    const struct GameAction *restrict pAction
+);
+
+
+/**
+ * @brief Reads a whole log file into memory for playback.
+ *
+ * The file is checked for the right format, version, byte order, and
+ * simulation rate, and for actions in order. Prints its own error
+ * messages on failure.
+ *
+ * @param path Path to the log file.
+ * @return     Pointer to the log; `NULL` on failure.
+ */
+struct Replay *replay_open(const char *restrict path);
+
+
+/**
+ * @brief Points the options at the maze the log was recorded in.
+ *
+ * Sets the maze size and seed unless the options load a maze file, in
+ * which case use `replay_isSameMaze` once it's loaded.
+ *
+ * @param pReplay  Pointer to the log being played.
+ * @param pOptions Pointer to the options to be changed.
+ */
+void replay_applyToOptions(
+    const struct Replay *restrict pReplay,
+    struct GameOptions *restrict pOptions
+);
+
+
+/**
+ * @brief Checks whether a maze is the one the log was recorded in.
+ *
+ * Prints a warning if it isn't, since the player would then bump into
+ * different walls than it did while recording.
+ *
+ * @param pReplay Pointer to the log being played.
+ * @param pMaze   Pointer to the maze.
+ * @return        True if the size and the seed match.
+ */
+bool replay_isSameMaze(
+    const struct Replay *restrict pReplay,
+    const struct Maze *restrict pMaze
+);
+
+
+/**
+ * @brief Copies the next action due by the given step, if any.
+ *
+ * Should be called in a loop right before each step, until it returns
+ * false, just like `input_loadNextAction`.
+ *
+ * @param pReplay Pointer to the log being played.
+ * @param step    Number of simulation steps taken so far.
+ * @param pAction Pointer to the action to be filled in.
+ * @return        True if an action was due; false when there are no more.
+ */
+bool replay_loadNextAction(
+    struct Replay *restrict pReplay,
+    uint32_t step,
+    struct GameAction *restrict pAction
+);
+
+
+/**
+ * @brief Gets how many steps the recording lasted.
+ * @param pReplay Pointer to the log being played.
+ * @return        The step of the last action in the log.
+ */
+uint32_t replay_getStepCount(const struct Replay *restrict pReplay);
+
+
+/**
+ * @brief Finishes the log and sets its pointer to `NULL`.
+ *
+ * Closes the file of a recording, printing an error if the last of it
+ * couldn't be written, or frees a log being played.
+ *
+ * @param ppReplay Pointer to the log pointer.
+ */
+void replay_destroy(struct Replay **ppReplay);
+
+#endif  // REPLAY_H
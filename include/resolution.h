@@ -0,0 +1,61 @@
+/**
+ * @file  resolution.h
+ * @brief Header for the resolution module, which scales the view to a budget.
+ *
+ * Declares the interface for the resolution module. Enables the caller
+ * to feed it how long each view took to draw and get back how much of
+ * the window's resolution to draw the next one at. The scale drops a
+ * step when the average time runs over the budget and only comes back
+ * up once the step above is expected to fit with room to spare, so it
+ * settles instead of flipping back and forth.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include <stdbool.h>  // for the bool type
+
+/**
+ * @brief The state of the scaling policy.
+ *
+ * You should consider this struct read-only. Set it up with
+ * `resolution_init` and leave it to `resolution_addSample` after that.
+ */
+struct ResolutionScaler
+{
+    double budget;        ///< seconds a view may take; 0 to never scale
+    double average;       ///< moving average of the time views take
+    int    level;         ///< current step down from full resolution
+    int    settleFrames;  ///< samples left before the scale may change again
+};
+
+
+/**
+ * @brief Starts the scaler at full resolution.
+ * @param pScaler Pointer to the scaler.
+ * @param budget  Seconds each view may take to draw, or 0 to always draw
+ *                at full resolution.
+ */
+void resolution_init(struct ResolutionScaler *pScaler, double budget);
+
+
+/**
+ * @brief Adds how long a view took to draw, and changes the scale if due.
+ * @param pScaler Pointer to the scaler.
+ * @param seconds Time it took to draw the view at the current scale.
+ * @return        True if the scale changed.
+ */
+bool resolution_addSample(struct ResolutionScaler *pScaler, double seconds);
+
+
+/**
+ * @brief Gets the fraction of the window's width and height to draw at.
+ * @param pScaler Pointer to the scaler.
+ * @return        The scale, from 1 for full resolution down to 0.5.
+ */
+double resolution_getScale(const struct ResolutionScaler *pScaler);
+
+#endif  // RESOLUTION_H
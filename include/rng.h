@@ -0,0 +1,70 @@
+/**
+ * @file  rng.h
+ * @brief Header for the rng module, a small seedable random generator.
+ *
+ * Declares the interface for the rng module. Enables the caller to seed
+ * a xoshiro256** generator and draw random numbers from it. The same
+ * seed always yields the same numbers on every platform, which is what
+ * makes mazes and performance runs reproducible.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>  // for fixed-width integer types
+
+/**
+ * @brief The state of one random number generator.
+ *
+ * Small enough to live on the stack or inside another struct. Seed it
+ * with `rng_seed` before use, then leave its state to `rng_next`.
+ */
+struct Rng
+{
+    uint64_t state[4];  ///< xoshiro256** state; never all zeros
+};
+
+
+/**
+ * @brief Seeds the generator so that it yields a fixed sequence.
+ * @param pRng Pointer to the generator.
+ * @param seed Any value, zero included.
+ */
+void rng_seed(struct Rng *pRng, uint64_t seed);
+
+
+/**
+ * @brief Returns a random number in the range [0, `bound`).
+ * @param pRng  Pointer to the generator.
+ * @param bound One more than the largest number to return; must be positive.
+ * @return      The random number.
+ */
+uint32_t rng_nextBelow(struct Rng *pRng, uint32_t bound);
+
+
+/**
+ * @brief Returns 64 random bits and advances the generator.
+ * @param pRng Pointer to the generator.
+ * @return     The random bits.
+ */
+static inline uint64_t rng_next(struct Rng *pRng)
+{
+    uint64_t *s = pRng->state;
+    uint64_t x = s[1] * 5;
+    uint64_t result = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return result;
+}
+
+#endif  // RNG_H
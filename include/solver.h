@@ -0,0 +1,127 @@
+/**
+ * @file  solver.h
+ * @brief Header for the solver module, which finds paths through mazes.
+ *
+ * Declares the interface for the solver module. Enables the caller to
+ * check that one cell can be reached from another and how far apart
+ * they are, with a breadth-first search run from both ends at once
+ * across a worker pool, or to find the steps from one cell to another
+ * with A*. Both work straight on the maze's wall planes and keep one bit
+ * per cell for what they've seen, in the same 8x8 tiles as the walls,
+ * so even the largest maze needs only a few bits per cell of scratch.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "maze.h"     // for the maze being solved
+#include "utils.h"    // for arenas
+#include "workers.h"  // for searching on every core
+
+// The ways out of a cell, one step each
+enum SolverStep
+{
+    SOLVER_EAST,   ///< one column right
+    SOLVER_SOUTH,  ///< one row down
+    SOLVER_WEST,   ///< one column left
+    SOLVER_NORTH   ///< one row up
+};
+
+
+/**
+ * @brief Gets the scratch space `solver_measurePath` needs for a maze.
+ * @param width  Cells per row.
+ * @param height Number of rows.
+ * @return       Size in bytes, padding included.
+ */
+size_t solver_getMeasureScratchSize(int width, int height);
+
+
+/**
+ * @brief Measures the shortest path between two cells, if there is one.
+ *
+ * Searches breadth first from both cells, one whole level at a time,
+ * always growing whichever side has the smaller frontier, until the two
+ * meet. Large levels are split across the pool's threads, which claim
+ * cells with atomic bit operations; small ones run on the calling thread.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pMaze    Pointer to the maze.
+ * @param xFrom    Column of the first cell.
+ * @param yFrom    Row of the first cell.
+ * @param xTo      Column of the second cell.
+ * @param yTo      Row of the second cell.
+ * @param pWorkers Pointer to the pool to search with; `NULL` to search
+ *                 on the calling thread only.
+ * @param pScratch Arena with at least `solver_getMeasureScratchSize`
+ *                 bytes left; rewound before returning.
+ * @param pLength  Where to put the number of steps in the path, or -1
+ *                 if there's no path.
+ * @return         True on success; false if the frontiers outgrew the
+ *                 scratch space.
+ */
+bool solver_measurePath(
+    const struct Maze *restrict pMaze,
+    int xFrom,
+    int yFrom,
+    int xTo,
+    int yTo,
+    struct WorkerPool *pWorkers,
+    struct Arena *restrict pScratch,
+    int64_t *restrict pLength
+);
+
+
+/**
+ * @brief Gets the scratch space `solver_findPath` needs for a maze.
+ * @param width  Cells per row.
+ * @param height Number of rows.
+ * @return       Size in bytes, padding included.
+ */
+size_t solver_getFindScratchSize(int width, int height);
+
+
+/**
+ * @brief Finds the shortest path between two cells with A*, if there is one.
+ *
+ * Searches from the second cell back toward the first, guided by the
+ * Manhattan distance, so that each cell it reaches points one step
+ * closer to the second cell. The first steps of the path can then be
+ * read off in order, starting from the first cell.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pMaze    Pointer to the maze.
+ * @param xFrom    Column of the cell the path starts from.
+ * @param yFrom    Row of the cell the path starts from.
+ * @param xTo      Column of the cell the path leads to.
+ * @param yTo      Row of the cell the path leads to.
+ * @param pScratch Arena with at least `solver_getFindScratchSize` bytes
+ *                 left; rewound before returning.
+ * @param steps    Where to put the first steps of the path, in order.
+ * @param maxSteps Most steps `steps` can hold.
+ * @param pLength  Where to put the number of steps in the whole path, or
+ *                 -1 if there's no path.
+ * @return         True on success; false if the open set outgrew the
+ *                 scratch space.
+ */
+bool solver_findPath(
+    const struct Maze *restrict pMaze,
+    int xFrom,
+    int yFrom,
+    int xTo,
+    int yTo,
+    struct Arena *restrict pScratch,
+    enum SolverStep *restrict steps,
+    int maxSteps,
+    int64_t *restrict pLength
+);
+
+#endif  // SOLVER_H
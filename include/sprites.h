@@ -0,0 +1,166 @@
+/**
+ * @file  sprites.h
+ * @brief Header for the sprites module, which keeps track of items in the maze.
+ *
+ * Declares the interface for the sprites module. Enables the caller to
+ * place items, such as breadcrumbs and the exit marker, at points in the
+ * maze, and to look up the ones in a row of cells. Items are kept sorted
+ * by the cell they're in, row by row, so the renderer can visit just the
+ * cells it might see instead of every item in a big maze.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "utils.h"    // for arenas
+
+// The kinds of items, each drawn its own way
+enum SpriteKind
+{
+    SPRITE_CRUMB,      ///< a breadcrumb on the floor
+    SPRITE_EXIT,       ///< a beacon floating over the exit
+    SPRITE_KIND_COUNT
+};
+
+
+/**
+ * @brief An item at a point in the maze.
+ *
+ * You should consider this struct read-only.
+ */
+struct Sprite
+{
+    double          xPos;   ///< x-position in the maze
+    double          yPos;   ///< y-position in the maze
+    int32_t         xCell;  ///< column of the cell it's in
+    int32_t         yCell;  ///< row of the cell it's in
+    enum SpriteKind kind;   ///< what it is
+};
+
+// The items in a maze, opaque outside its module
+struct SpriteSet;
+
+
+/**
+ * @brief Gets how much arena space `sprites_create` needs.
+ * @param capacity Most items the set can hold.
+ * @return         Bytes to reserve, alignment padding included.
+ */
+size_t sprites_getArenaSize(int capacity);
+
+
+/**
+ * @brief Allocates room for a number of items, with none placed yet.
+ *
+ * The set lives in the arena and goes away with it. Prints its own error
+ * message on failure.
+ *
+ * @param capacity Most items the set can hold; must be positive.
+ * @param pArena   Arena with at least `sprites_getArenaSize` bytes left.
+ * @return         Pointer to the new set; `NULL` on failure.
+ */
+struct SpriteSet *sprites_create(int capacity, struct Arena *restrict pArena);
+
+
+/**
+ * @brief Places an item, keeping the set sorted by cell.
+ *
+ * Moves every item after it in the set along by one, which is cheap for
+ * items placed one at a time as the game goes.
+ *
+ * @param pSprites Pointer to the set.
+ * @param xPos     x-position of the item.
+ * @param yPos     y-position of the item.
+ * @param kind     What the item is.
+ * @return         True on success; false if the set is full.
+ */
+bool sprites_add(
+    struct SpriteSet *restrict pSprites,
+    double xPos,
+    double yPos,
+    enum SpriteKind kind
+);
+
+
+/**
+ * @brief Checks whether any item of a kind is in a cell.
+ * @param pSprites Pointer to the set.
+ * @param x        Column of the cell.
+ * @param y        Row of the cell.
+ * @param kind     Kind of item to look for.
+ * @return         True if there is one.
+ */
+bool sprites_isInCell(
+    const struct SpriteSet *restrict pSprites,
+    int x,
+    int y,
+    enum SpriteKind kind
+);
+
+
+/**
+ * @brief Finds the items in a run of cells along one row.
+ * @param pSprites Pointer to the set.
+ * @param y        Row of the cells.
+ * @param xFirst   Column of the first cell of the run.
+ * @param xLast    Column of the last cell of the run.
+ * @param ppFirst  Where to put a pointer to the first item found; the
+ *                 rest follow it.
+ * @return         Number of items found.
+ */
+int sprites_findInRow(
+    const struct SpriteSet *restrict pSprites,
+    int y,
+    int xFirst,
+    int xLast,
+    const struct Sprite **ppFirst
+);
+
+
+/**
+ * @brief Gets the number of items placed so far.
+ * @param pSprites Pointer to the set.
+ * @return         Number of items.
+ */
+int sprites_getCount(const struct SpriteSet *restrict pSprites);
+
+
+/**
+ * @brief Gets a number that changes whenever the items do.
+ *
+ * Placing, moving, or dropping items changes it, so a view drawn at one
+ * generation shows the items as they still are as long as it's the same.
+ *
+ * @param pSprites Pointer to the set.
+ * @return         The set's current generation.
+ */
+uint32_t sprites_getGeneration(const struct SpriteSet *restrict pSprites);
+
+
+/**
+ * @brief Moves every item by whole cells, as when the maze moves.
+ *
+ * Items moved off the maze are dropped, making room for new ones; they
+ * don't come back if it moves back.
+ *
+ * @param pSprites Pointer to the set.
+ * @param xShift   Cells to add to every x-position.
+ * @param yShift   Cells to add to every y-position.
+ * @param width    Cells per row of the maze, after the move.
+ * @param height   Number of rows of the maze, after the move.
+ */
+void sprites_shift(
+    struct SpriteSet *restrict pSprites,
+    int xShift,
+    int yShift,
+    int width,
+    int height
+);
+
+#endif  // SPRITES_H
@@ -0,0 +1,94 @@
+/**
+ * @file  stream.h
+ * @brief Header for the stream module, which streams an endless maze in chunks.
+ *
+ * Declares the interface for the stream module. Enables the caller to
+ * play a maze with no edges: the world is split into square chunks,
+ * each generated on demand from the seed and its own coordinates, so
+ * the same chunk always comes out the same. Every chunk is a perfect
+ * maze with a door in its west and north sides, which its neighbors
+ * get the other side of, so the chunks all connect.
+ *
+ * Only a window of chunks around the player is laid out as a regular
+ * maze, walls and all, which the ray casters and collision read like
+ * any other maze, with no lookups. When the player leaves the window's
+ * middle chunk, the window moves with them, and everything in it has to
+ * be moved back by the same number of cells. Generated chunks are kept
+ * in a small cache that forgets the least recently used ones, and a
+ * background thread generates the chunks the player is heading for
+ * before they're needed, so memory stays the same however far they go.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>  // for the bool type
+#include <stdint.h>   // for fixed-width integer types
+#include "maze.h"     // for the window's maze
+#include "player.h"   // for the player pose
+
+#define STREAM_CHUNK_CELLS    128  // cells per side of one chunk
+#define STREAM_WINDOW_CHUNKS  5    // chunks per side of the window; odd
+#define STREAM_CACHE_CHUNKS   64   // chunks kept generated at once
+
+// The state of the stream, opaque outside its module
+struct MazeStream;
+
+
+/**
+ * @brief Starts streaming a maze, with its window around the first chunk.
+ *
+ * Starts the background thread too. Prints its own error messages on
+ * failure.
+ *
+ * @param seed Seed for the whole maze; each chunk's comes from it.
+ * @return     Pointer to the new stream; `NULL` on failure.
+ */
+struct MazeStream *stream_create(uint64_t seed);
+
+
+/**
+ * @brief Gets the maze laid out in the window.
+ *
+ * It's the same maze for the life of the stream, but its walls change
+ * whenever the window moves. Its seed is the stream's.
+ *
+ * @param pStream Pointer to the stream.
+ * @return        Pointer to the window's maze, owned by the stream.
+ */
+struct Maze *stream_getMaze(struct MazeStream *pStream);
+
+
+/**
+ * @brief Moves the window to keep the player in its middle chunk, if needed.
+ *
+ * Also asks the background thread for the chunks the player is facing
+ * toward, outside the window. Meant to be called after each simulation
+ * step. When the window moves, its maze gets new walls right away, and
+ * the caller must add the shift to every position in the maze, the
+ * player's included.
+ *
+ * @param pStream Pointer to the stream.
+ * @param pPose   Pointer to the player's pose in the window.
+ * @param pXShift Where to put the cells to add to every x-position.
+ * @param pYShift Where to put the cells to add to every y-position.
+ * @return        True if the window moved.
+ */
+bool stream_follow(
+    struct MazeStream *restrict pStream,
+    const struct PlayerPose *restrict pPose,
+    int *restrict pXShift,
+    int *restrict pYShift
+);
+
+
+/**
+ * @brief Stops the background thread, frees the stream, and sets its pointer to `NULL`.
+ * @param ppStream Pointer to the stream pointer; can point to `NULL`.
+ */
+void stream_destroy(struct MazeStream **ppStream);
+
+#endif  // STREAM_H
@@ -0,0 +1,161 @@
+/**
+ * @file  texture.h
+ * @brief Header for the texture module, which holds mipmapped textures.
+ *
+ * Declares the interface for the texture module. Enables the caller to
+ * build a square texture and its chain of smaller mip levels in an
+ * arena, once per level, and to pick the level that best matches how
+ * tall a wall is drawn on screen.
+ *
+ * Texels are stored column-major: going down a column of the texture
+ * walks through memory one texel at a time, just like drawing a wall
+ * slice down a screen column does. A texture can also keep a copy of
+ * its levels in palette indices, for drawing in 256 colors.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+#include <stdint.h>   // for fixed-width integer types
+#include "utils.h"    // for arenas
+
+#define TEXTURE_SIZE        64  ///< texels per side of level 0; a power of 2
+#define TEXTURE_MAX_LEVELS  7   ///< levels from TEXTURE_SIZE down to 1 texel
+
+// The palette indexed levels are drawn from, declared in palette.h
+struct Palette;
+
+/**
+ * @brief A square ARGB8888 texture and its mip levels.
+ *
+ * Level `l` is `size >> l` texels per side, and its texel at column `u`
+ * and row `v` is `levels[l][(u << (log2(size) - l)) + v]`. Each level
+ * starts on a cache line. Indexed levels are laid out the same way,
+ * one byte per texel, and are `NULL` until `texture_buildIndices` builds
+ * them. You should consider this struct read-only.
+ */
+struct Texture
+{
+    const uint32_t *levels[TEXTURE_MAX_LEVELS];       ///< column-major texels
+    const uint8_t  *indexLevels[TEXTURE_MAX_LEVELS];  ///< same, as palette indices
+    int             size;                             ///< texels per side of level 0
+    int             sizeShift;                        ///< log2 of `size`
+    int             levelCount;                       ///< number of levels
+};
+
+
+/**
+ * @brief Gets how much arena space each texture created here needs.
+ * @return Bytes to reserve, alignment padding included.
+ */
+size_t texture_getArenaSize(void);
+
+
+/**
+ * @brief Builds a sandstone brick texture and its mip levels in an arena.
+ *
+ * The bricks come from a fixed seed, so they look the same every run.
+ * Prints its own error message on failure.
+ *
+ * @param pArena Pointer to the arena that holds the texture from now on.
+ * @return       Pointer to the texture; `NULL` on failure.
+ */
+struct Texture *texture_createBricks(struct Arena *restrict pArena);
+
+
+/**
+ * @brief Builds a square tile texture of the given color in an arena.
+ *
+ * Like `texture_createBricks`, the tiles come from a fixed seed and the
+ * function prints its own error message on failure.
+ *
+ * @param pArena Pointer to the arena that holds the texture from now on.
+ * @param color  0xAARRGGBB color of the tiles; the grout is darker.
+ * @return       Pointer to the texture; `NULL` on failure.
+ */
+struct Texture *texture_createTiles(struct Arena *restrict pArena, uint32_t color);
+
+
+/**
+ * @brief Builds a shaded ball of the given color on a clear background in an arena.
+ *
+ * For sprites, which skip the clear texels. Those have an alpha of 0,
+ * and the smaller levels average alpha along with the color channels,
+ * so the ball keeps its shape at any distance. Prints its own error
+ * message on failure.
+ *
+ * @param pArena Pointer to the arena that holds the texture from now on.
+ * @param color  0xAARRGGBB color of the ball where the light hits it.
+ * @return       Pointer to the texture; `NULL` on failure.
+ */
+struct Texture *texture_createOrb(struct Arena *restrict pArena, uint32_t color);
+
+
+/**
+ * @brief Builds a copy of every level of a texture in palette indices.
+ *
+ * Texels less than half opaque become `PALETTE_CLEAR`, and every other
+ * texel the palette's nearest color. Prints its own error message on
+ * failure, in which case the texture is left without indexed levels.
+ *
+ * @param pTexture Pointer to a texture created by this module.
+ * @param pPalette Pointer to the palette to index into.
+ * @param pArena   Pointer to the arena that holds the indices from now on.
+ * @return         True on success; false on failure.
+ */
+bool texture_buildIndices(
+    struct Texture *restrict pTexture,
+    const struct Palette *restrict pPalette,
+    struct Arena *restrict pArena
+);
+
+
+/**
+ * @brief Picks the level with about one texel per pixel for a wall slice.
+ *
+ * That's the largest level that's still no smaller than the slice, so
+ * far walls read a handful of texels rather than skipping through a
+ * big level and missing the cache on every one.
+ *
+ * @param pTexture   Pointer to the texture.
+ * @param lineHeight Height of the whole wall slice in pixels, on screen
+ *                   or not.
+ * @return           The level to sample.
+ */
+static inline int texture_pickLevel(
+    const struct Texture *restrict pTexture,
+    int lineHeight
+) {
+    int level = 0;
+
+    while (level + 1 < pTexture->levelCount
+           && (pTexture->size >> (level + 1)) >= lineHeight)
+        ++level;
+
+    return level;
+}
+
+
+/**
+ * @brief Scales the RGB channels of a color, leaving alpha alone.
+ *
+ * Works on the red and blue channels together and on green by itself
+ * to get three multiplies' worth of work out of two.
+ *
+ * @param color 0xAARRGGBB color.
+ * @param level Brightness out of 256; 256 leaves the color as is.
+ * @return      The shaded color.
+ */
+static inline uint32_t texture_shadeColor(uint32_t color, uint32_t level)
+{
+    uint32_t redBlue = ( (color & 0x00FF00FFu) * level >> 8 ) & 0x00FF00FFu;
+    uint32_t green   = ( (color & 0x0000FF00u) * level >> 8 ) & 0x0000FF00u;
+    return (color & 0xFF000000u) | redBlue | green;
+}
+
+#endif  // TEXTURE_H
@@ -3,7 +3,8 @@
  * @brief Header for utils, a set of common general-purpose functions.
  *
  * Declares the interface for the utils module, which provides functions
- * for commonly performed operations.
+ * for commonly performed operations, including arenas: fixed blocks of
+ * memory handed out front to back and released all at once.
  *
  * @author Joseph Borjon
  * @date   2024-12-13
@@ -12,10 +13,99 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdbool.h>  // for the bool type
+#include <stddef.h>   // for size_t
+
+#define ARENA_ALIGNMENT  16  // default alignment, enough for any scalar or SSE
+
+/**
+ * @brief A fixed block of memory handed out front to back.
+ *
+ * Nothing handed out is freed on its own. Either the whole arena is
+ * reset or destroyed at once, or it's rewound to a mark taken earlier,
+ * which frees everything handed out since. An arena never grows, so
+ * allocating from one never calls into the heap.
+ */
+struct Arena
+{
+    unsigned char *base;      ///< start of the block
+    size_t         capacity;  ///< bytes in the block
+    size_t         used;      ///< bytes handed out so far, padding included
+};
+
+
 /**
  * @brief Frees the pointed-to pointer and sets its value to `NULL`.
  * @param ppData A pointer to the pointer being freed.
  */
 void freeMemory(void **ppData);
 
+
+/**
+ * @brief Allocates an arena's block up front.
+ *
+ * Prints its own error message on failure.
+ *
+ * @param pArena   Pointer to the arena to be initialized.
+ * @param capacity Bytes in the block, padding for alignment included.
+ * @return         True on success; false on failure.
+ */
+bool arena_init(struct Arena *restrict pArena, size_t capacity);
+
+
+/**
+ * @brief Hands out memory aligned to `ARENA_ALIGNMENT`; see `arena_allocAligned`.
+ */
+void *arena_alloc(struct Arena *restrict pArena, size_t size);
+
+
+/**
+ * @brief Hands out the next `size` bytes of the arena, uninitialized.
+ *
+ * Sets `errno` to `ENOMEM` when the arena is full, like `malloc`, so that
+ * callers can report it the same way.
+ *
+ * @param pArena    Pointer to the arena.
+ * @param size      Bytes wanted.
+ * @param alignment Power of 2 the address must be a multiple of.
+ * @return          Pointer to the memory; `NULL` if the arena is full.
+ */
+void *arena_allocAligned(struct Arena *restrict pArena, size_t size, size_t alignment);
+
+
+/**
+ * @brief Gets a mark to rewind the arena back to later.
+ * @param pArena Pointer to the arena.
+ * @return       The mark.
+ */
+static inline size_t arena_getMark(const struct Arena *restrict pArena)
+{
+    return pArena->used;
+}
+
+
+/**
+ * @brief Frees everything handed out since the mark was taken.
+ * @param pArena Pointer to the arena.
+ * @param mark   A mark from `arena_getMark` on the same arena.
+ */
+void arena_rewind(struct Arena *restrict pArena, size_t mark);
+
+
+/**
+ * @brief Frees everything handed out, keeping the block for reuse.
+ * @param pArena Pointer to the arena.
+ */
+static inline void arena_reset(struct Arena *restrict pArena)
+{
+    pArena->used = 0;
+}
+
+
+/**
+ * @brief Frees the arena's block, and with it everything handed out.
+ * @param pArena Pointer to the arena, which is left empty.
+ */
+void arena_destroy(struct Arena *restrict pArena);
+
 #endif  // UTILS_H
@@ -0,0 +1,85 @@
+/**
+ * @file  workers.h
+ * @brief Header for the workers module, a pool of persistent threads.
+ *
+ * Declares the interface for the workers module. Enables the caller to
+ * start a fixed set of worker threads once, hand them a batch of
+ * independent tasks as often as needed (such as once per frame), wait
+ * for the whole batch to finish, and stop the threads when done.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+// The highest number of threads a pool can have, the caller's included
+#define MAX_WORKER_THREADS  64
+
+/**
+ * @brief A pool of worker threads that sleep between batches of tasks.
+ *
+ * Access and mutate it through the functions provided by this header
+ * interface.
+ */
+struct WorkerPool;
+
+/**
+ * @brief A task run by the pool; called once for each task index.
+ * @param pData       Data shared by every task in the batch.
+ * @param taskIndex   Which task to run, from 0 up to the task count.
+ * @param workerIndex Which thread is running it, from 0 up to the thread
+ *                    count; 0 is always the thread that started the batch.
+ */
+typedef void (*WorkerTask)(void *pData, int taskIndex, int workerIndex);
+
+
+/**
+ * @brief Starts a pool of threads and returns a pointer to it.
+ *
+ * The thread that runs each batch always pitches in, so a pool of
+ * `threadCount` threads starts only `threadCount - 1` new ones. Prints
+ * its own error messages on failure.
+ *
+ * @param threadCount Number of threads, the caller's included; clamped
+ *                    to between 1 and `MAX_WORKER_THREADS`.
+ * @return            Pointer to the just-started pool; `NULL` on failure.
+ */
+struct WorkerPool *workers_create(int threadCount);
+
+
+/**
+ * @brief Gets the number of threads in the pool, the caller's included.
+ * @param pPool Pointer to the pool.
+ * @return      Number of threads that run each batch.
+ */
+int workers_getThreadCount(const struct WorkerPool *pPool);
+
+
+/**
+ * @brief Runs every task in a batch across the pool and waits for them.
+ * @param pPool     Pointer to the pool.
+ * @param task      Function to run once for each task index.
+ * @param pData     Data passed to every call of `task`.
+ * @param taskCount Number of tasks in the batch.
+ *
+ * Tasks are handed out one at a time to whichever thread is free, so
+ * they may run in any order and on any thread. Returns only after all
+ * of them have finished. Must not be called from within a task.
+ */
+void workers_run(
+    struct WorkerPool *pPool,
+    WorkerTask task,
+    void *pData,
+    int taskCount
+);
+
+
+/**
+ * @brief Stops and joins every thread, then frees the pool.
+ * @param ppPool Pointer to the pool pointer, which is set to `NULL`.
+ */
+void workers_destroy(struct WorkerPool **ppPool);
+
+#endif  // WORKERS_H
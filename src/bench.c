@@ -0,0 +1,453 @@
+/**
+ * @file  bench.c
+ * @brief Implementation of the bench module.
+ *
+ * Defines the interface for the bench module and provides internal
+ * helper functions to move a camera along scripted paths through the
+ * maze, time every frame, and summarize the timings.
+ *
+ * The paths depend only on the maze, so the same maze, resolution, and
+ * frame count always render exactly the same frames.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <math.h>      // for cos and sin
+#include <SDL3/SDL.h>  // for timing and logging
+#include "bench.h"     // the header implemented here
+#include "flats.h"     // for picking a floor and ceiling kernel
+#include "maze.h"      // for the maze to render
+#include "palette.h"   // for picking an index expansion kernel
+#include "player.h"    // for the camera pose
+#include "raycast.h"   // for picking a ray casting kernel
+#include "render.h"    // for drawing the view
+#include "replay.h"    // for following a recorded player
+#include "utils.h"     // for arenas and freeing pointers
+#include "workers.h"   // for rendering on every core
+#include "defines.h"   // for the simulation rate
+
+#define BENCH_SEED           1     // maze seed unless told otherwise
+#define BENCH_WARMUP_FRAMES  10    // untimed frames to fill caches first
+#define LEVEL_ARENA_SIZE     (64 * 1024)  // the maze itself, besides its walls
+#define WALK_SPEED           0.1   // cells the walking camera covers a frame
+#define PI                   3.14159265358979323846
+
+// Ways the camera can move; the first half of the frames walk
+enum CameraPath
+{
+    PATH_WALK,  // follows the right-hand wall from the start
+    PATH_SPIN   // turns around once on the spot at the start
+};
+
+// A camera that walks the maze keeping its right hand on the wall
+struct Walker
+{
+    int    x;         // column of the cell the walker last left
+    int    y;         // row of the cell the walker last left
+    int    heading;   // 0 east, 1 south, 2 west, 3 north
+    double progress;  // how far toward the next cell, from 0 to 1
+};
+
+// A camera that goes wherever a recorded player went, one step a frame
+struct ReplayCamera
+{
+    struct Replay     *replay;  // input log driving the player
+    struct Player     *player;  // the player, starting where the game does
+    struct InputState  input;   // what the replayed actions add up to
+    uint32_t           step;    // simulation steps taken so far
+};
+
+// Cell offsets for each heading, clockwise starting east
+static const int _xSteps[4] = { 1, 0, -1, 0 };
+static const int _ySteps[4] = { 0, 1, 0, -1 };
+
+
+// === Static function prototypes === //
+
+// Points the camera along the given path at the given point in time
+static void moveCamera(
+    const struct Maze *restrict pMaze,
+    enum CameraPath path,
+    double time,
+    struct Walker *restrict pWalker,
+    struct PlayerPose *restrict pPose
+);
+
+// Takes one simulation step of the replay and points the camera along it
+static void followReplay(
+    struct ReplayCamera *restrict pCamera,
+    const struct Maze *restrict pMaze,
+    struct PlayerPose *restrict pPose
+);
+
+// Advances the walker by the given distance, turning at cell centers
+static void walk(
+    const struct Maze *restrict pMaze,
+    struct Walker *restrict pWalker,
+    double distance
+);
+
+// Checks whether the walker can go from a cell toward the given heading
+static bool isOpen(const struct Maze *restrict pMaze, int x, int y, int heading);
+
+// Orders frame times from fastest to slowest for qsort
+static int compareTimes(const void *pLeft, const void *pRight);
+
+// Returns the time that `percent` percent of all times are at or below
+static double getPercentile(const double *sortedTimes, int count, double percent);
+
+
+// === Interface function definitions === //
+
+/* Times only the drawing of each frame, which is everything the CPU does
+ * per frame in this mode; warm-up frames go first so that the timed ones
+ * don't pay for cold caches and first-touch page faults.
+ *
+ * With -replay, the camera is the player, driven by the log one step per
+ * frame, and the run ends early if the log does. With -interlaced, the
+ * warm-up frames are still drawn whole, so the first timed frame has a
+ * view to fill in, and rays per second counts only the rays cast.
+ */
+bool bench_run(const struct GameOptions *restrict pOptions)
+{
+    struct GameOptions options = *pOptions;
+    struct ReplayCamera camera = { 0 };
+
+    if (options.replayPath)
+    {
+        camera.replay = replay_open(options.replayPath);
+
+        if (!camera.replay)
+            return false;
+
+        replay_applyToOptions(camera.replay, &options);
+    }
+
+    struct Arena levelArena;
+    struct Arena scratchArena;
+    size_t levelSize = LEVEL_ARENA_SIZE + render_getTexturesArenaSize();
+
+    if (options.loadPath)
+        levelSize += maze_getFileArenaSize(options.loadPath);
+    else
+        levelSize += maze_getArenaSize(options.mazeWidth, options.mazeHeight);
+
+    if (!arena_init(&levelArena, levelSize))
+    {
+        replay_destroy(&camera.replay);
+        return false;
+    }
+
+    if (!arena_init(&scratchArena, maze_getScratchSize(options.mazeWidth)))
+    {
+        replay_destroy(&camera.replay);
+        arena_destroy(&levelArena);
+        return false;
+    }
+
+    struct Maze *pMaze = options.loadPath
+        ? maze_load(options.loadPath, &levelArena)
+        : maze_create(
+            options.mazeWidth,
+            options.mazeHeight,
+            options.hasSeed ? options.seed : BENCH_SEED,
+            &levelArena,
+            &scratchArena
+          );
+    arena_destroy(&scratchArena);  // only generation needs it
+
+    if (pMaze && options.savePath)
+    {
+        if (maze_save(pMaze, options.savePath))
+        {
+            SDL_Log("Saved the maze to %s.", options.savePath);
+        }
+        else
+        {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Benchmarking on without saving the maze."
+            );
+        }
+    }
+
+    // Only loaded mazes can have open space; generated ones are perfect
+    if (pMaze && options.loadPath && !options.isSkipOff)
+        maze_buildDistances(pMaze, &levelArena);  // goes on without one if this fails
+
+    struct ViewTextures textures;
+    bool hasTextures = pMaze
+        && render_createTextures(&textures, &levelArena, options.isIndexed);
+    int frameCount = options.benchFrames;
+
+    if (pMaze && camera.replay)
+    {
+        replay_isSameMaze(camera.replay, pMaze);  // warns if it isn't
+        camera.player = player_initAtStart(&levelArena, pMaze);
+        frameCount = (int)SDL_min((Uint32)frameCount, replay_getStepCount(camera.replay));
+
+        if (frameCount == 0)
+            fprintf(stderr, "Error: %s has no steps to play.\n", options.replayPath);
+    }
+
+    bool isReplayReady = !camera.replay || (camera.player && frameCount > 0);
+
+    if (!pMaze || !hasTextures || !isReplayReady)
+    {
+        maze_destroy(&pMaze);
+        replay_destroy(&camera.replay);
+        arena_destroy(&levelArena);
+        return false;
+    }
+
+    struct Framebuffer frame = { 0 };
+    double *times = malloc((size_t)frameCount * sizeof(*times));
+    int threadCount = options.threadCount;
+    if (threadCount == 0)
+        threadCount = SDL_GetNumLogicalCPUCores();
+
+    struct WorkerPool *pWorkers = workers_create(threadCount);
+    bool isReady = pWorkers != NULL && times != NULL
+        && render_initFramebuffer(
+            &frame,
+            options.width,
+            options.height,
+            options.isIndexed
+        );
+
+    if (!isReady)
+    {
+        if (!times)
+            perror("Error: Unable to allocate the frame times");
+
+        render_destroyFramebuffer(&frame);
+        workers_destroy(&pWorkers);
+        freeMemory((void **)&times);
+        maze_destroy(&pMaze);
+        replay_destroy(&camera.replay);
+        arena_destroy(&levelArena);
+        return false;
+    }
+
+    enum RaycastKernel kernel = raycast_selectKernel(options.raycastKernel);
+    flats_selectKernel(kernel);
+    palette_selectKernel(kernel);
+    struct Walker walker = { .heading = isOpen(pMaze, 0, 0, 0) ? 0 : 1 };
+    struct PlayerPose pose;
+    const double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    double totalMs = 0.0;
+    uint64_t totalTexelBytes = 0;
+    uint64_t totalRays = 0;
+    int fieldFrames = 0;
+
+    // Warm up looking the way the first timed frame will
+    if (camera.replay)
+        player_getPose(camera.player, &pose);
+    else
+        moveCamera(pMaze, PATH_WALK, 0.0, &walker, &pose);
+
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; ++i)
+        render_drawView(&frame, &pose, pMaze, &textures, NULL, pWorkers, false);
+
+    const int walkFrames = (frameCount + 1) / 2;
+
+    for (int i = 0; i < frameCount; ++i)
+    {
+        if (camera.replay)
+        {
+            followReplay(&camera, pMaze, &pose);
+        }
+        else
+        {
+            bool isWalking = i < walkFrames;
+            double time = isWalking
+                ? (double)i / walkFrames
+                : (double)(i - walkFrames) / (frameCount - walkFrames);
+            moveCamera(pMaze, isWalking ? PATH_WALK : PATH_SPIN, time, &walker, &pose);
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        render_drawView(
+            &frame,
+            &pose,
+            pMaze,
+            &textures,
+            NULL,
+            pWorkers,
+            options.isInterlaced
+        );
+        times[i] = (SDL_GetPerformanceCounter() - start) / ticksPerMs;
+        totalMs += times[i];
+        totalTexelBytes += frame.texelBytes;
+        totalRays += (uint64_t)frame.rayCount;
+        fieldFrames += frame.rayCount < frame.width;
+    }
+
+    qsort(times, (size_t)frameCount, sizeof(*times), compareTimes);
+
+    printf(
+        "{\"frames\":%d,\"width\":%d,\"height\":%d,\"threads\":%d,"
+        "\"kernel\":\"%s\",\"maze_width\":%d,\"maze_height\":%d,\"seed\":%llu,"
+        "\"camera\":\"%s\",\"skip\":%s,\"interlaced\":%s,\"field_frames\":%d,"
+        "\"mean_ms\":%.4f,\"p50_ms\":%.4f,\"p99_ms\":%.4f,\"max_ms\":%.4f,"
+        "\"rays_per_sec\":%.0f,\"texel_bytes_per_frame\":%.0f}\n",
+        frameCount,
+        frame.width,
+        frame.height,
+        workers_getThreadCount(pWorkers),
+        raycast_getKernelName(kernel),
+        pMaze->width,
+        pMaze->height,
+        (unsigned long long)pMaze->seed,
+        camera.replay ? "replay" : "scripted",
+        pMaze->distances && raycast_usesDistances(kernel) ? "true" : "false",
+        options.isInterlaced ? "true" : "false",
+        fieldFrames,
+        totalMs / frameCount,
+        getPercentile(times, frameCount, 50.0),
+        getPercentile(times, frameCount, 99.0),
+        times[frameCount - 1],
+        (double)totalRays / (totalMs / 1000.0),
+        (double)totalTexelBytes / frameCount
+    );
+    fflush(stdout);
+
+    render_destroyFramebuffer(&frame);
+    workers_destroy(&pWorkers);
+    freeMemory((void **)&times);
+    maze_destroy(&pMaze);
+    replay_destroy(&camera.replay);
+    arena_destroy(&levelArena);
+    return true;
+}
+
+
+// === Static function definitions === //
+
+/* The walker carries the walking path from frame to frame; spinning
+ * needs nothing but the time.
+ */
+static void moveCamera(
+    const struct Maze *restrict pMaze,
+    enum CameraPath path,
+    double time,
+    struct Walker *restrict pWalker,
+    struct PlayerPose *restrict pPose
+) {
+    switch (path)
+    {
+    case PATH_WALK:
+        if (time > 0.0)
+            walk(pMaze, pWalker, WALK_SPEED);
+
+        pPose->xPos = pWalker->x + 0.5 + pWalker->progress * _xSteps[pWalker->heading];
+        pPose->yPos = pWalker->y + 0.5 + pWalker->progress * _ySteps[pWalker->heading];
+        pPose->xDir = _xSteps[pWalker->heading];
+        pPose->yDir = _ySteps[pWalker->heading];
+        break;
+    default:
+        pPose->xPos = 0.5;
+        pPose->yPos = 0.5;
+        pPose->xDir = cos(2.0 * PI * time);
+        pPose->yDir = sin(2.0 * PI * time);
+        break;
+    }
+}
+
+
+/* Feeds the replayed actions through the same input state the game
+ * uses, so the player moves exactly as it did in the game. Only actions
+ * that drive the player matter here.
+ */
+static void followReplay(
+    struct ReplayCamera *restrict pCamera,
+    const struct Maze *restrict pMaze,
+    struct PlayerPose *restrict pPose
+) {
+    struct GameAction action;
+    while (replay_loadNextAction(pCamera->replay, pCamera->step, &action))
+        input_applyAction(&pCamera->input, &action);
+
+    struct PlayerInput input;
+    input_takePlayerInput(&pCamera->input, &input);
+    player_update(pCamera->player, &input, pMaze, 1.0 / STEPS_PER_SECOND);
+    player_getPose(pCamera->player, pPose);
+    ++pCamera->step;
+}
+
+
+/* Picks a new heading on reaching a cell center: right if open, else
+ * straight, else left, else back. Keeping a hand on the wall like this
+ * visits every cell of a perfect maze without ever getting stuck, as
+ * long as the walker starts out facing an open passage.
+ */
+static void walk(
+    const struct Maze *restrict pMaze,
+    struct Walker *restrict pWalker,
+    double distance
+) {
+    pWalker->progress += distance;
+
+    while (pWalker->progress >= 1.0)
+    {
+        pWalker->x += _xSteps[pWalker->heading];
+        pWalker->y += _ySteps[pWalker->heading];
+        pWalker->progress -= 1.0;
+
+        for (int turn = 1; turn >= -2; --turn)
+        {
+            int heading = (pWalker->heading + turn + 4) % 4;
+
+            if (isOpen(pMaze, pWalker->x, pWalker->y, heading))
+            {
+                pWalker->heading = heading;
+                break;
+            }
+        }
+    }
+}
+
+
+/* East and south walls belong to the neighboring cells.
+ */
+static bool isOpen(const struct Maze *restrict pMaze, int x, int y, int heading)
+{
+    switch (heading)
+    {
+    case 0:
+        return !maze_hasWestWall(pMaze, x + 1, y);
+    case 1:
+        return !maze_hasNorthWall(pMaze, x, y + 1);
+    case 2:
+        return !maze_hasWestWall(pMaze, x, y);
+    default:
+        return !maze_hasNorthWall(pMaze, x, y);
+    }
+}
+
+
+/* Compares rather than subtracts, which could overflow an int.
+ */
+static int compareTimes(const void *pLeft, const void *pRight)
+{
+    double left = *(const double *)pLeft;
+    double right = *(const double *)pRight;
+    return (left > right) - (left < right);
+}
+
+
+/* Nearest-rank percentile, so the result is always a time that was
+ * actually measured.
+ */
+static double getPercentile(const double *sortedTimes, int count, double percent)
+{
+    int rank = (int)ceil(percent / 100.0 * count);
+
+    if (rank < 1)
+        rank = 1;
+
+    return sortedTimes[rank - 1];
+}
@@ -0,0 +1,633 @@
+/**
+ * @file  capture.c
+ * @brief Implementation of the capture module.
+ *
+ * Defines the interface for the capture module and provides internal
+ * helper functions to claim, fill, and queue slots on the caller's
+ * thread, and to convert and write them on the background thread.
+ *
+ * A slot that's free belongs to the caller's thread, and one that's
+ * queued or being written to the background thread; only the hand-offs
+ * between the two take the lock. The caller copies each frame into its
+ * slot, which is the only work a capture adds to a frame, and the
+ * background thread writes the slots in the order they were queued.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console and file I/O
+#include <stdlib.h>    // for the C standard library
+#include <time.h>      // for naming screenshots
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for threads, mutexes, semaphores, and timing
+#include "capture.h"   // the header implemented here
+#include "utils.h"     // for freeing pointers
+
+#define SCREENSHOT_PATH_SIZE  64  // room for a screenshot's file name
+#define MAX_REPEATS  CAPTURE_VIDEO_RATE  // video frames one view can fill
+
+// Who has a slot
+enum SlotState
+{
+    SLOT_FREE,     // the caller's thread, to fill
+    SLOT_QUEUED,   // the background thread, waiting to write it
+    SLOT_WRITING   // the background thread, writing it
+};
+
+// One frame waiting to be written
+struct CaptureSlot
+{
+    uint32_t      *pixels;       // copy of the view, rows packed together
+    size_t         capacity;     // pixels it has room for
+    int            width;        // pixels per row
+    int            height;       // number of rows
+    int            repeatCount;  // times to write it to the video; 0 for a screenshot
+    uint64_t       sequence;     // order it was queued in
+    enum SlotState state;        // who has it
+    char           path[SCREENSHOT_PATH_SIZE];  // where to save a screenshot
+};
+
+struct FrameCapture
+{
+    struct CaptureSlot slots[CAPTURE_SLOTS];  // the frames in flight
+    SDL_Mutex     *lock;             // guards the slots' states and the flags
+    SDL_Semaphore *wakeSignal;       // posted once per slot queued, and to quit
+    SDL_Thread    *writer;           // converts and writes the queued slots
+    const char    *videoPath;        // where to record video; NULL for none
+    FILE          *pVideo;           // the video, once created
+    uint8_t       *planes;           // one video frame's Y, Cb, and Cr planes
+    int            videoWidth;       // pixels per row of every video frame
+    int            videoHeight;      // rows of every video frame
+    uint64_t       nextSequence;     // sequence of the next slot queued
+    uint64_t       nextVideoTime;    // nanoseconds at which a video frame is due
+    int            heldRepeats;      // video frames owed by dropped ones
+    int            screenshotCount;  // screenshots taken, for their names
+    long           writtenFrames;    // video frames written
+    long           droppedFrames;    // views dropped from the video
+    bool           isVideoFailed;    // has writing the video failed?
+    bool           isQuitting;       // should the background thread exit?
+};
+
+
+// === Static function prototypes === //
+
+// Finds a free slot, or returns NULL if every one is still in flight
+static struct CaptureSlot *claimSlot(struct FrameCapture *restrict pCapture);
+
+// Copies the view in the framebuffer into a slot, making room if need be
+static bool fillSlot(
+    struct CaptureSlot *restrict pSlot,
+    const struct Framebuffer *restrict pFrame
+);
+
+// Hands a filled slot to the background thread
+static void queueSlot(
+    struct FrameCapture *restrict pCapture,
+    struct CaptureSlot *restrict pSlot
+);
+
+// Runs on the background thread, writing queued slots until told to quit
+static int SDLCALL runWriter(void *pData);
+
+// Saves a slot as a PPM screenshot, converting its pixels in place
+static bool writeScreenshot(struct CaptureSlot *restrict pSlot);
+
+// Adds a slot to the video as many times as it's due, creating the video
+// along with the first one
+static bool writeVideoFrame(
+    struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot
+);
+
+// Creates the video and writes its header for frames of the given size
+static bool openVideo(struct FrameCapture *restrict pCapture, int width, int height);
+
+// Converts a slot into the video's planes, scaling it to the video's size
+static void convertToYuv(
+    struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot
+);
+
+// Gets the slot's pixel at a point of the video, scaling by nearest neighbor
+static inline uint32_t samplePixel(
+    const struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot,
+    int x,
+    int y
+);
+
+
+// === Interface function definitions === //
+
+/* The slots start out empty; each gets its pixels on first use.
+ */
+struct FrameCapture *capture_create(const char *videoPath)
+{
+    struct FrameCapture *pCapture = calloc(1, sizeof(*pCapture));
+
+    if (!pCapture)
+    {
+        perror("Error: Unable to allocate a frame capture");
+        return NULL;
+    }
+
+    pCapture->videoPath = videoPath;
+    pCapture->lock = SDL_CreateMutex();
+    pCapture->wakeSignal = SDL_CreateSemaphore(0);
+
+    if (!pCapture->lock || !pCapture->wakeSignal)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create the frame capture's signals: %s.",
+            SDL_GetError()
+        );
+        capture_destroy(&pCapture);
+        return NULL;
+    }
+
+    pCapture->writer = SDL_CreateThread(runWriter, "capture", pCapture);
+
+    if (!pCapture->writer)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to start the frame capture's thread: %s.",
+            SDL_GetError()
+        );
+        capture_destroy(&pCapture);
+        return NULL;
+    }
+
+    return pCapture;
+}
+
+
+/* Names the screenshot now, so that it's named after when it was taken
+ * rather than when it was written.
+ */
+void capture_takeScreenshot(
+    struct FrameCapture *restrict pCapture,
+    const struct Framebuffer *restrict pFrame
+) {
+    if (!pFrame->hasView)
+        return;
+
+    struct CaptureSlot *pSlot = claimSlot(pCapture);
+
+    if (!pSlot)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Dropped a screenshot; the last frames are still being written."
+        );
+        return;
+    }
+
+    if (!fillSlot(pSlot, pFrame))
+        return;
+
+    snprintf(
+        pSlot->path,
+        sizeof(pSlot->path),
+        "screenshot-%lld-%d.ppm",
+        (long long)time(NULL),
+        ++pCapture->screenshotCount
+    );
+    pSlot->repeatCount = 0;
+    queueSlot(pCapture, pSlot);
+}
+
+
+/* Keeps video frames on a fixed schedule from the first one, however
+ * unevenly the game's frames come. Gaps longer than a second, like
+ * while the game sits idle, are cut down to a second.
+ */
+void capture_addVideoFrame(
+    struct FrameCapture *restrict pCapture,
+    const struct Framebuffer *restrict pFrame
+) {
+    if (!pCapture->videoPath || !pFrame->hasView)
+        return;
+
+    const uint64_t period = SDL_NS_PER_SECOND / CAPTURE_VIDEO_RATE;
+    uint64_t now = SDL_GetTicksNS();
+
+    if (pCapture->nextVideoTime == 0)
+        pCapture->nextVideoTime = now;
+
+    if (now < pCapture->nextVideoTime)
+        return;  // not due yet
+
+    uint64_t dueCount = (now - pCapture->nextVideoTime) / period + 1;
+    pCapture->nextVideoTime += dueCount * period;
+
+    int repeatCount = (int)SDL_min(dueCount + pCapture->heldRepeats, MAX_REPEATS);
+
+    SDL_LockMutex(pCapture->lock);
+    bool isVideoFailed = pCapture->isVideoFailed;
+    SDL_UnlockMutex(pCapture->lock);
+
+    if (isVideoFailed)
+        return;
+
+    struct CaptureSlot *pSlot = claimSlot(pCapture);
+
+    if (!pSlot || !fillSlot(pSlot, pFrame))
+    {
+        ++pCapture->droppedFrames;
+        pCapture->heldRepeats = repeatCount;  // the next view stands in for it
+        return;
+    }
+
+    pSlot->repeatCount = repeatCount;
+    pCapture->heldRepeats = 0;
+    queueSlot(pCapture, pSlot);
+}
+
+
+/* Tells the background thread to quit, which it does once it has
+ * written every slot still queued; also frees whatever a failed
+ * `capture_create` got as far as making.
+ */
+void capture_destroy(struct FrameCapture **ppCapture)
+{
+    assert(ppCapture != NULL);
+
+    struct FrameCapture *pCapture = *ppCapture;
+    if (!pCapture)
+        return;
+
+    if (pCapture->writer)
+    {
+        SDL_LockMutex(pCapture->lock);
+        pCapture->isQuitting = true;
+        SDL_UnlockMutex(pCapture->lock);
+
+        SDL_SignalSemaphore(pCapture->wakeSignal);
+        SDL_WaitThread(pCapture->writer, NULL);
+    }
+
+    if (pCapture->pVideo && fclose(pCapture->pVideo) != 0)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", pCapture->videoPath);
+        perror(NULL);
+    }
+    else if (pCapture->pVideo)
+    {
+        SDL_Log(
+            "Captured %ld frames of video to %s, dropping %ld.",
+            pCapture->writtenFrames,
+            pCapture->videoPath,
+            pCapture->droppedFrames
+        );
+    }
+
+    SDL_DestroySemaphore(pCapture->wakeSignal);
+    SDL_DestroyMutex(pCapture->lock);
+
+    for (int i = 0; i < CAPTURE_SLOTS; ++i)
+        freeMemory((void **)&pCapture->slots[i].pixels);
+
+    freeMemory((void **)&pCapture->planes);
+    freeMemory((void **)ppCapture);
+}
+
+
+// === Static function definitions === //
+
+/* Any free slot will do, since the background thread goes by the order
+ * the slots were queued in rather than where they are.
+ */
+static struct CaptureSlot *claimSlot(struct FrameCapture *restrict pCapture)
+{
+    struct CaptureSlot *pFree = NULL;
+
+    SDL_LockMutex(pCapture->lock);
+
+    for (int i = 0; i < CAPTURE_SLOTS && !pFree; ++i)
+    {
+        if (pCapture->slots[i].state == SLOT_FREE)
+            pFree = &pCapture->slots[i];
+    }
+
+    SDL_UnlockMutex(pCapture->lock);
+    return pFree;
+}
+
+
+/* Sizes the pixels for the largest view the framebuffer holds, so that
+ * dynamic resolution going back and forth never reallocates them; only
+ * a bigger window does. Indexed views come out expanded.
+ */
+static bool fillSlot(
+    struct CaptureSlot *restrict pSlot,
+    const struct Framebuffer *restrict pFrame
+) {
+    size_t pixelCount = (size_t)pFrame->maxWidth * (size_t)pFrame->maxHeight;
+
+    if (pixelCount > pSlot->capacity)
+    {
+        freeMemory((void **)&pSlot->pixels);
+        pSlot->capacity = 0;
+        pSlot->pixels = malloc(pixelCount * sizeof(*pSlot->pixels));
+
+        if (!pSlot->pixels)
+        {
+            perror("Error: Unable to allocate a captured frame");
+            return false;
+        }
+
+        pSlot->capacity = pixelCount;
+    }
+
+    struct FrameRegion whole = {
+        .x = 0, .y = 0, .width = pFrame->width, .height = pFrame->height
+    };
+    render_copyRegion(
+        pFrame,
+        &whole,
+        pSlot->pixels,
+        pFrame->width * (int)sizeof(*pSlot->pixels)
+    );
+
+    pSlot->width = pFrame->width;
+    pSlot->height = pFrame->height;
+    return true;
+}
+
+
+/* One post per slot, so the background thread wakes once for each.
+ */
+static void queueSlot(
+    struct FrameCapture *restrict pCapture,
+    struct CaptureSlot *restrict pSlot
+) {
+    SDL_LockMutex(pCapture->lock);
+    pSlot->sequence = pCapture->nextSequence++;
+    pSlot->state = SLOT_QUEUED;
+    SDL_UnlockMutex(pCapture->lock);
+
+    SDL_SignalSemaphore(pCapture->wakeSignal);
+}
+
+
+/* Takes the slot queued first and writes it without the lock, so that
+ * the caller can fill the other slots meanwhile. Only quits once there
+ * are no slots left queued, so nothing captured is lost on the way out.
+ * Once the video fails, its slots still queued are let go unwritten.
+ * The video is only ever touched from here until the thread exits.
+ */
+static int SDLCALL runWriter(void *pData)
+{
+    struct FrameCapture *pCapture = pData;
+
+    for (;;)
+    {
+        SDL_WaitSemaphore(pCapture->wakeSignal);
+
+        SDL_LockMutex(pCapture->lock);
+        struct CaptureSlot *pSlot = NULL;
+
+        for (int i = 0; i < CAPTURE_SLOTS; ++i)
+        {
+            struct CaptureSlot *pCandidate = &pCapture->slots[i];
+
+            if (pCandidate->state == SLOT_QUEUED
+                && (!pSlot || pCandidate->sequence < pSlot->sequence))
+                pSlot = pCandidate;
+        }
+
+        if (pSlot)
+            pSlot->state = SLOT_WRITING;
+
+        bool isQuitting = pCapture->isQuitting;
+        bool isVideoFailed = pCapture->isVideoFailed;
+        SDL_UnlockMutex(pCapture->lock);
+
+        if (!pSlot && isQuitting)
+            return 0;
+
+        if (!pSlot)
+            continue;
+
+        if (pSlot->repeatCount > 0 && !isVideoFailed)
+            isVideoFailed = !writeVideoFrame(pCapture, pSlot);
+
+        if (pSlot->repeatCount == 0)
+            writeScreenshot(pSlot);  // prints its own errors
+
+        SDL_LockMutex(pCapture->lock);
+        pSlot->state = SLOT_FREE;
+        pCapture->isVideoFailed = pCapture->isVideoFailed || isVideoFailed;
+        SDL_UnlockMutex(pCapture->lock);
+    }
+}
+
+
+/* Packs each pixel down to three bytes over the slot's own pixels, front
+ * to back, which never overwrites one before it's read, and writes them
+ * all at once.
+ */
+static bool writeScreenshot(struct CaptureSlot *restrict pSlot)
+{
+    size_t pixelCount = (size_t)pSlot->width * (size_t)pSlot->height;
+    uint8_t *bytes = (uint8_t *)pSlot->pixels;
+
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        uint32_t color = pSlot->pixels[i];
+        bytes[3 * i]     = (uint8_t)(color >> 16);
+        bytes[3 * i + 1] = (uint8_t)(color >> 8);
+        bytes[3 * i + 2] = (uint8_t)color;
+    }
+
+    FILE *pFile = fopen(pSlot->path, "wb");
+
+    if (!pFile)
+    {
+        fprintf(stderr, "Error: Unable to create %s: ", pSlot->path);
+        perror(NULL);
+        return false;
+    }
+
+    bool isWritten =
+        fprintf(pFile, "P6\n%d %d\n255\n", pSlot->width, pSlot->height) > 0
+        && fwrite(bytes, 3, pixelCount, pFile) == pixelCount;
+
+    if (fclose(pFile) != 0 || !isWritten)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", pSlot->path);
+        perror(NULL);
+        return false;
+    }
+
+    SDL_Log("Saved a screenshot to %s.", pSlot->path);
+    return true;
+}
+
+
+/* Converts the slot once, however many times it's written.
+ */
+static bool writeVideoFrame(
+    struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot
+) {
+    if (!pCapture->pVideo && !openVideo(pCapture, pSlot->width, pSlot->height))
+        return false;
+
+    convertToYuv(pCapture, pSlot);
+
+    size_t lumaSize = (size_t)pCapture->videoWidth * (size_t)pCapture->videoHeight;
+    size_t chromaSize = (size_t)( (pCapture->videoWidth + 1) / 2 )
+                        * (size_t)( (pCapture->videoHeight + 1) / 2 );
+    size_t frameSize = lumaSize + 2 * chromaSize;
+    bool isWritten = true;
+
+    for (int i = 0; i < pSlot->repeatCount && isWritten; ++i)
+    {
+        isWritten = fputs("FRAME\n", pCapture->pVideo) >= 0
+                    && fwrite(pCapture->planes, 1, frameSize, pCapture->pVideo)
+                       == frameSize;
+    }
+
+    if (!isWritten)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", pCapture->videoPath);
+        perror(NULL);
+        return false;
+    }
+
+    pCapture->writtenFrames += pSlot->repeatCount;
+    return true;
+}
+
+
+/* Full-range 4:2:0 with the chroma sited like JPEG's, which is what the
+ * conversion below produces. Leaves no video or planes behind on failure.
+ */
+static bool openVideo(struct FrameCapture *restrict pCapture, int width, int height)
+{
+    size_t lumaSize = (size_t)width * (size_t)height;
+    size_t chromaSize = (size_t)( (width + 1) / 2 ) * (size_t)( (height + 1) / 2 );
+    pCapture->planes = malloc(lumaSize + 2 * chromaSize);
+
+    if (!pCapture->planes)
+    {
+        perror("Error: Unable to allocate a video frame");
+        return false;
+    }
+
+    pCapture->pVideo = fopen(pCapture->videoPath, "wb");
+
+    if (!pCapture->pVideo)
+    {
+        fprintf(stderr, "Error: Unable to create %s: ", pCapture->videoPath);
+        perror(NULL);
+        freeMemory((void **)&pCapture->planes);
+        return false;
+    }
+
+    if (fprintf(
+            pCapture->pVideo,
+            "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XYSCSS=420JPEG XCOLORRANGE=FULL\n",
+            width,
+            height,
+            CAPTURE_VIDEO_RATE
+        ) < 0)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", pCapture->videoPath);
+        perror(NULL);
+        fclose(pCapture->pVideo);
+        pCapture->pVideo = NULL;
+        freeMemory((void **)&pCapture->planes);
+        return false;
+    }
+
+    pCapture->videoWidth = width;
+    pCapture->videoHeight = height;
+    SDL_Log("Recording video to %s at %dx%d.", pCapture->videoPath, width, height);
+    return true;
+}
+
+
+/* Uses the full-range BT.601 weights, in Q16.16, as JPEG does. Each
+ * chroma sample comes from the average color of the 2x2 block of pixels
+ * it covers, or as much of one as fits at the edges.
+ */
+static void convertToYuv(
+    struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot
+) {
+    const int width = pCapture->videoWidth;
+    const int height = pCapture->videoHeight;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    uint8_t *restrict yPlane = pCapture->planes;
+    uint8_t *restrict cbPlane = yPlane + (size_t)width * height;
+    uint8_t *restrict crPlane = cbPlane + (size_t)chromaWidth * chromaHeight;
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            uint32_t color = samplePixel(pCapture, pSlot, x, y);
+            int32_t red = (int32_t)(color >> 16 & 0xFFu);
+            int32_t green = (int32_t)(color >> 8 & 0xFFu);
+            int32_t blue = (int32_t)(color & 0xFFu);
+
+            yPlane[(size_t)y * width + x] =
+                (uint8_t)((19595 * red + 38470 * green + 7471 * blue + 32768) >> 16);
+        }
+    }
+
+    for (int y = 0; y < chromaHeight; ++y)
+    {
+        for (int x = 0; x < chromaWidth; ++x)
+        {
+            int32_t red = 0, green = 0, blue = 0, count = 0;
+
+            for (int row = 2 * y; row < SDL_min(2 * y + 2, height); ++row)
+            {
+                for (int column = 2 * x; column < SDL_min(2 * x + 2, width); ++column)
+                {
+                    uint32_t color = samplePixel(pCapture, pSlot, column, row);
+                    red += (int32_t)(color >> 16 & 0xFFu);
+                    green += (int32_t)(color >> 8 & 0xFFu);
+                    blue += (int32_t)(color & 0xFFu);
+                    ++count;
+                }
+            }
+
+            red = (red + count / 2) / count;
+            green = (green + count / 2) / count;
+            blue = (blue + count / 2) / count;
+
+            // Saturated blue and red round up to 256, one past the top
+            int32_t cb =
+                (-11059 * red - 21709 * green + 32768 * blue + (128 << 16) + 32768) >> 16;
+            int32_t cr =
+                (32768 * red - 27439 * green - 5329 * blue + (128 << 16) + 32768) >> 16;
+
+            size_t i = (size_t)y * chromaWidth + x;
+            cbPlane[i] = (uint8_t)SDL_clamp(cb, 0, 255);
+            crPlane[i] = (uint8_t)SDL_clamp(cr, 0, 255);
+        }
+    }
+}
+
+
+/* Maps straight through when the slot is the video's size.
+ */
+static inline uint32_t samplePixel(
+    const struct FrameCapture *restrict pCapture,
+    const struct CaptureSlot *restrict pSlot,
+    int x,
+    int y
+) {
+    int xSource = (int)((int64_t)x * pSlot->width / pCapture->videoWidth);
+    int ySource = (int)((int64_t)y * pSlot->height / pCapture->videoHeight);
+
+    return pSlot->pixels[(size_t)ySource * pSlot->width + xSource];
+}
@@ -0,0 +1,109 @@
+/**
+ * @file  flats.c
+ * @brief Implementation of the flats module.
+ *
+ * Defines the interface for the flats module: kernel selection and the
+ * scalar kernels every other kernel must agree with. The SIMD kernels
+ * live in their own files so that each can be compiled for its own
+ * instruction set.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <math.h>     // for floorf
+#include <assert.h>   // for debugging assertions
+#include "flats.h"    // the header implemented here
+#include "texture.h"  // for shading texels
+
+// Signature shared by all the kernels
+typedef void (*DrawSpanFunction)(const struct FlatSpan *restrict pSpan);
+
+// The kernels in use; scalar until told otherwise
+static DrawSpanFunction _drawSpan = flats_drawSpanScalar;
+static DrawSpanFunction _drawSpanIndexed = flats_drawSpanIndexedScalar;
+
+
+// === Interface function definitions === //
+
+/* Trusts the ray casting module to have checked the CPU already.
+ */
+void flats_selectKernel(enum RaycastKernel kernel)
+{
+    assert(kernel != RAYCAST_AUTO);
+
+    switch (kernel)
+    {
+#ifdef MAZECAST_X86_SIMD
+    case RAYCAST_AVX2:
+        _drawSpan = flats_drawSpanAVX2;
+        _drawSpanIndexed = flats_drawSpanIndexedAVX2;
+        break;
+    case RAYCAST_SSE2:
+        _drawSpan = flats_drawSpanSSE2;
+        _drawSpanIndexed = flats_drawSpanIndexedSSE2;
+        break;
+#endif
+    default:
+        _drawSpan = flats_drawSpanScalar;
+        _drawSpanIndexed = flats_drawSpanIndexedScalar;
+        break;
+    }
+}
+
+
+/* Forwards the span to whichever kernel was last selected.
+ */
+void flats_drawSpan(const struct FlatSpan *restrict pSpan)
+{
+    assert(pSpan->count >= 0);
+    _drawSpan(pSpan);
+}
+
+
+/* Forwards the span to whichever indexed kernel was last selected.
+ */
+void flats_drawSpanIndexed(const struct FlatSpan *restrict pSpan)
+{
+    assert(pSpan->count >= 0);
+    _drawSpanIndexed(pSpan);
+}
+
+
+/* Rounds texture coordinates down rather than toward zero, so that the
+ * texture doesn't stutter where they cross zero, and then wraps them
+ * onto the level.
+ */
+void flats_drawSpanScalar(const struct FlatSpan *restrict pSpan)
+{
+    const int32_t mask = (1 << pSpan->sizeShift) - 1;
+
+    for (int i = 0; i < pSpan->count; ++i)
+    {
+        float cameraX = pSpan->cameraXs[i];
+        int32_t u = (int32_t)floorf(pSpan->uStart + pSpan->uStep * cameraX) & mask;
+        int32_t v = (int32_t)floorf(pSpan->vStart + pSpan->vStep * cameraX) & mask;
+        uint32_t texel = pSpan->texels[(u << pSpan->sizeShift) + v];
+
+        pSpan->pixels[i] = texture_shadeColor(texel, pSpan->shade);
+    }
+}
+
+
+/* Steps through the texture exactly like the scalar kernel, so the two
+ * modes line up texel for texel.
+ */
+void flats_drawSpanIndexedScalar(const struct FlatSpan *restrict pSpan)
+{
+    const int32_t mask = (1 << pSpan->sizeShift) - 1;
+
+    for (int i = 0; i < pSpan->count; ++i)
+    {
+        float cameraX = pSpan->cameraXs[i];
+        int32_t u = (int32_t)floorf(pSpan->uStart + pSpan->uStep * cameraX) & mask;
+        int32_t v = (int32_t)floorf(pSpan->vStart + pSpan->vStep * cameraX) & mask;
+        uint8_t texel = pSpan->indexTexels[(u << pSpan->sizeShift) + v];
+
+        pSpan->indices[i] = pSpan->shades[texel];
+    }
+}
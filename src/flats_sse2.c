@@ -0,0 +1,123 @@
+/**
+ * @file  flats_sse2.c
+ * @brief SSE2 span kernel for the flats module.
+ *
+ * Textures four pixels at a time. SSE2 has no gather, so the texels are
+ * read one lane at a time; everything else runs on all four lanes. That
+ * goes for indexed spans too, whose texels and shades are both lookups.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <emmintrin.h>  // for SSE2 intrinsics
+#include "flats.h"      // the header implemented here
+
+#define LANES  4  // pixels textured per iteration
+
+
+// === Static function prototypes === //
+
+// Rounds each lane down to a whole number, which SSE2 has no instruction for
+static inline __m128i floorToInt(__m128 values);
+
+
+// === Interface function definitions === //
+
+/* Mirrors flats_drawSpanScalar lane for lane. Shading widens each color
+ * channel to 16 bits, so that a single multiply covers two whole pixels.
+ */
+void flats_drawSpanSSE2(const struct FlatSpan *restrict pSpan)
+{
+    const __m128 uStart = _mm_set1_ps(pSpan->uStart);
+    const __m128 vStart = _mm_set1_ps(pSpan->vStart);
+    const __m128 uStep  = _mm_set1_ps(pSpan->uStep);
+    const __m128 vStep  = _mm_set1_ps(pSpan->vStep);
+    const __m128i mask  = _mm_set1_epi32((1 << pSpan->sizeShift) - 1);
+    const __m128i shift = _mm_cvtsi32_si128(pSpan->sizeShift);
+    const __m128i shade = _mm_set1_epi16((short)pSpan->shade);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i zero  = _mm_setzero_si128();
+    const uint32_t *restrict texels = pSpan->texels;
+
+    for (int i = 0; i < pSpan->count; i += LANES)
+    {
+        __m128 cameraX = _mm_loadu_ps(pSpan->cameraXs + i);
+        __m128i u = floorToInt(_mm_add_ps(uStart, _mm_mul_ps(uStep, cameraX)));
+        __m128i v = floorToInt(_mm_add_ps(vStart, _mm_mul_ps(vStep, cameraX)));
+        u = _mm_and_si128(u, mask);
+        v = _mm_and_si128(v, mask);
+
+        int32_t indices[LANES];
+        _mm_storeu_si128(
+            (__m128i *)indices,
+            _mm_add_epi32(_mm_sll_epi32(u, shift), v)
+        );
+        __m128i colors = _mm_setr_epi32(
+            (int)texels[indices[0]],
+            (int)texels[indices[1]],
+            (int)texels[indices[2]],
+            (int)texels[indices[3]]
+        );
+
+        // Scale every channel, alpha included, then put alpha back
+        __m128i low  = _mm_mullo_epi16(_mm_unpacklo_epi8(colors, zero), shade);
+        __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(colors, zero), shade);
+        __m128i shaded = _mm_packus_epi16(
+            _mm_srli_epi16(low, 8),
+            _mm_srli_epi16(high, 8)
+        );
+        shaded = _mm_or_si128(shaded, alpha);
+
+        _mm_store_si128((__m128i *)(pSpan->pixels + i), shaded);
+    }
+}
+
+
+/* Mirrors flats_drawSpanIndexedScalar lane for lane. Only the texture
+ * coordinates run on all four lanes; the two lookups per pixel can't.
+ */
+void flats_drawSpanIndexedSSE2(const struct FlatSpan *restrict pSpan)
+{
+    const __m128 uStart = _mm_set1_ps(pSpan->uStart);
+    const __m128 vStart = _mm_set1_ps(pSpan->vStart);
+    const __m128 uStep  = _mm_set1_ps(pSpan->uStep);
+    const __m128 vStep  = _mm_set1_ps(pSpan->vStep);
+    const __m128i mask  = _mm_set1_epi32((1 << pSpan->sizeShift) - 1);
+    const __m128i shift = _mm_cvtsi32_si128(pSpan->sizeShift);
+    const uint8_t *restrict texels = pSpan->indexTexels;
+    const uint8_t *restrict shades = pSpan->shades;
+
+    for (int i = 0; i < pSpan->count; i += LANES)
+    {
+        __m128 cameraX = _mm_loadu_ps(pSpan->cameraXs + i);
+        __m128i u = floorToInt(_mm_add_ps(uStart, _mm_mul_ps(uStep, cameraX)));
+        __m128i v = floorToInt(_mm_add_ps(vStart, _mm_mul_ps(vStep, cameraX)));
+        u = _mm_and_si128(u, mask);
+        v = _mm_and_si128(v, mask);
+
+        int32_t offsets[LANES];
+        _mm_storeu_si128(
+            (__m128i *)offsets,
+            _mm_add_epi32(_mm_sll_epi32(u, shift), v)
+        );
+
+        pSpan->indices[i]     = shades[texels[offsets[0]]];
+        pSpan->indices[i + 1] = shades[texels[offsets[1]]];
+        pSpan->indices[i + 2] = shades[texels[offsets[2]]];
+        pSpan->indices[i + 3] = shades[texels[offsets[3]]];
+    }
+}
+
+
+// === Static function definitions === //
+
+/* Truncating rounds negative numbers up, so those lanes get one taken
+ * back off; the comparison's all-ones mask is that -1.
+ */
+static inline __m128i floorToInt(__m128 values)
+{
+    __m128i truncated = _mm_cvttps_epi32(values);
+    __m128 isRoundedUp = _mm_cmplt_ps(values, _mm_cvtepi32_ps(truncated));
+    return _mm_add_epi32(truncated, _mm_castps_si128(isRoundedUp));
+}
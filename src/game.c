@@ -10,23 +10,90 @@
  * @date   2024-12-10
  */
 
-#include <stdio.h>     // for console I/O
-#include <stdlib.h>    // for the C standard library
-#include <stdbool.h>   // for the bool type
-#include <assert.h>    // for debugging assertions
-#include <SDL3/SDL.h>  // for SDL3
-#include "game.h"      // the header implemented here
-#include "input.h"     // for handling user input
-#include "player.h"    // for the player module
-#include "utils.h"     // for freeing pointers
+#include <stdio.h>       // for console I/O
+#include <stdlib.h>      // for the C standard library
+#include <stdbool.h>     // for the bool type
+#include <stdint.h>      // for fixed-width integer types
+#include <assert.h>      // for debugging assertions
+#include <SDL3/SDL.h>    // for SDL3
+#include "game.h"        // the header implemented here
+#include "capture.h"     // for screenshots and video
+#include "flats.h"       // for picking a floor and ceiling kernel
+#include "input.h"       // for handling user input
+#include "maze.h"        // for generating the maze
+#include "minimap.h"     // for mapping what the player has seen
+#include "palette.h"     // for picking an index expansion kernel
+#include "options.h"     // for the command-line options
+#include "player.h"      // for the player module
+#include "profiler.h"    // for timing each phase of a frame
+#include "raycast.h"     // for picking a ray casting kernel
+#include "render.h"      // for drawing the 3D view
+#include "replay.h"      // for recording and replaying input
+#include "resolution.h"  // for scaling the view to the frame time
+#include "solver.h"      // for checking the maze and showing the way
+#include "sprites.h"     // for breadcrumbs and the exit marker
+#include "stream.h"      // for streaming endless mazes
+#include "utils.h"       // for arenas
+#include "workers.h"     // for rendering on every core
+#include "defines.h"     // for the simulation rate
+
+#define MAX_FRAME_TIME    0.25  // most seconds simulated in one frame
+#define OVERLAY_MARGIN    8.0f  // pixels between the overlay and the edges
+#define OVERLAY_LINE      10.0f // pixels from one overlay line to the next
+#define IDLE_TIMEOUT_MS   100   // longest an idle frame waits for events
+#define RENDER_SHARE      0.75  // share of each frame's time the view may take
+#define FALLBACK_REFRESH  60.0f // frames per second when the display won't say
+#define LEVEL_ARENA_SIZE  (64 * 1024)       // level data besides generated walls
+#define FRAME_ARENA_SIZE  (4 * 1024 * 1024) // scratch data for a single frame
+#define MAX_SPRITES       65536             // breadcrumbs and markers per level
+
+struct WayOutSearch
+{
+    SDL_Thread        *thread;       // runs the searches; NULL if none can run
+    SDL_Semaphore     *wakeSignal;   // posted once per search, and once to quit
+    const struct Maze *maze;         // the maze being searched
+    int                xFrom;        // column the search starts from
+    int                yFrom;        // row the search starts from
+    int64_t            length;       // steps in the whole way out; -1 if none
+    bool               isFound;      // did the search finish at all?
+    bool               isSearching;  // is a search under way or uncollected?
+    SDL_AtomicInt      isDone;       // has the thread stopped touching the rest?
+    SDL_AtomicInt      isQuitting;   // should the thread exit when woken?
+    enum SolverStep    steps[MINIMAP_PATH_STEPS];  // first steps of the way out
+};
 
 struct GameContext
 {
     SDL_Window    *restrict window;            // the program window
     SDL_Renderer  *restrict renderer;          // the renderer for the window
+    SDL_Texture   *restrict frameTexture;      // streaming copy of the frame
     struct Player *restrict player;            // the user's in-game avatar
-    bool                    isFullscreen : 1;  // is the game at full screen?
-    bool                    isRunning    : 1;  // is the game currently running?
+    struct WorkerPool      *workers;           // threads that share the work
+    struct Framebuffer      frame;             // CPU-side render target
+    struct Maze            *maze;              // the level being explored
+    struct MazeStream      *stream;            // lays out the maze if endless
+    struct Minimap         *minimap;           // what the player has seen of it
+    struct SpriteSet       *sprites;           // the items placed in it
+    struct ViewTextures     textures;          // what the level looks like
+    struct GameOptions      options;           // command-line settings
+    struct PlayerPose       previousPose;      // pose before the last step
+    struct PlayerPose       currentPose;       // pose after the last step
+    struct Arena            levelArena;        // holds everything above, too
+    struct Arena            frameArena;        // scratch space, reset per frame
+    struct InputState       input;             // what the actions add up to
+    struct Replay          *recording;         // input log being written
+    struct Replay          *replay;            // input log driving the player
+    struct FrameCapture    *capture;           // screenshots and video being saved
+    struct ResolutionScaler scaler;            // how much of the window to draw
+    struct WayOutSearch     wayOut;            // the search for the exit, if any
+    uint32_t                step;              // simulation steps taken so far
+    bool                    isFullscreen    : 1;  // is the game at full screen?
+    bool                    isRunning       : 1;  // is the game currently running?
+    bool                    isProfilerShown : 1;  // is the profiler overlay shown?
+    bool                    isMinimapShown  : 1;  // is the minimap shown?
+    bool                    isTrailOn       : 1;  // are breadcrumbs being dropped?
+    bool                    isInterlaced    : 1;  // is every other column drawn?
+    bool                    isScreenshotDue : 1;  // should the next frame be saved?
 };
 
 
@@ -38,14 +105,92 @@ static bool setDefaultValues(struct GameContext *pGame, const char *title);
 // Executes the user's requested actions one by one each frame
 static void processGameActions(struct GameContext *restrict pGame);
 
+// Executes a single action, whether live, replayed, or both
+static void executeGameAction(
+    struct GameContext *restrict pGame,
+    const struct GameAction *restrict pAction
+);
+
+// Advances the simulation by one fixed step
+static void stepSimulation(struct GameContext *restrict pGame, double seconds);
+
+// Sleeps until the next frame is due under the frame rate cap
+static void waitForNextFrame(Uint64 *restrict pNextFrame, Uint64 frameTicks);
+
+// Checks whether the next frame can wait for events instead of running
+static bool canIdle(const struct GameContext *restrict pGame, bool isViewCurrent);
+
+// Drops a breadcrumb in the player's cell if the trail is on and it has none
+static void dropCrumb(struct GameContext *restrict pGame);
+
+// Moves an endless maze along with the player, and everything in it with it
+static void followPlayer(struct GameContext *restrict pGame);
+
+// Loads or generates the maze the options ask for, and saves it if asked
+static struct Maze *loadMaze(
+    const struct GameOptions *restrict pOptions,
+    struct WorkerPool *pWorkers,
+    struct Arena *restrict pArena,
+    struct Arena *restrict pScratch
+);
+
+// Checks that the exit can be reached from the start, printing any errors
+static bool hasExitPath(const struct Maze *restrict pMaze, struct WorkerPool *pWorkers);
+
+// Starts the thread that looks for the way out whenever asked to
+static void startWayOutSearch(struct GameContext *restrict pGame);
+
+// Stops the thread that looks for the way out, once it's done searching
+static void stopWayOutSearch(struct WayOutSearch *restrict pSearch);
+
+// Starts looking for the way from the player to the exit in the background
+static void showWayOut(struct GameContext *restrict pGame);
+
+// Finds the way out each time the search's own thread is woken
+static int SDLCALL findWayOut(void *pData);
+
+// Shows the way out on the minimap once the search for it is done
+static void collectWayOut(struct GameContext *restrict pGame);
+
+// Gets how long drawing the view may take before its resolution drops
+static double getRenderBudget(const struct GameContext *restrict pGame);
+
+// Matches the framebuffer and its texture to the renderer's output size,
+// and the view within them to that size scaled down as far as the frame
+// time calls for
+static bool resizeFrame(struct GameContext *restrict pGame);
+
+// Allocates the framebuffer and its streaming texture at the given size
+static bool createFrame(struct GameContext *restrict pGame, int width, int height);
+
+// Copies the framebuffer into the streaming texture and presents it,
+// with any overlays drawn over it
+static void presentFrame(
+    struct GameContext *restrict pGame,
+    const struct PlayerPose *restrict pPose
+);
+
+// Hands the frame just presented to the capture, for a screenshot if one
+// was asked for and for the video if one is being recorded
+static void captureFrame(struct GameContext *restrict pGame);
+
+// Draws each profiler zone's recent time per frame over the view
+static void drawProfilerOverlay(SDL_Renderer *restrict pRenderer);
+
 
 // === Interface function definitions === //
 
-/* Parses the command-line arguments, if any are given. Allocates and
- * initializes the data structures required for a playable game context.
+/* Keeps its own copy of the options. Allocates and initializes the data
+ * structures required for a playable game context.
+ *
+ * The context is the first thing in its own level arena, which is sized
+ * up front for everything the level needs, generated walls included, so
+ * that nothing else is allocated until the next level.
  */
-struct GameContext *game_initContext(int argc, char **argv, const char *title)
-{
+struct GameContext *game_initContext(
+    const struct GameOptions *restrict pOptions,
+    const char *title
+) {
     if (!SDL_Init(SDL_INIT_VIDEO))  // implies event init too
     {
         SDL_LogError(
@@ -56,18 +201,74 @@ struct GameContext *game_initContext(int argc, char **argv, const char *title)
         return NULL;
     }
 
-    struct GameContext *pGame = malloc(sizeof(*pGame));
+    struct GameOptions options = *pOptions;
+    struct Replay *pReplay = NULL;
 
-    if (pGame)
+    // Replay in the maze the log was recorded in
+    if (options.replayPath)
     {
-        if (!setDefaultValues(pGame, title))  // ensure setting values succeeds
-        {
-            freeMemory((void **)&pGame);      // sets pGame back to to NULL
-        }
+        pReplay = replay_open(options.replayPath);
+
+        if (!pReplay)
+            return NULL;
+
+        replay_applyToOptions(pReplay, &options);
     }
-    else
+
+    // Logs can only point to mazes that stay put
+    if (options.isEndless && (options.replayPath || options.recordPath))
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Ignoring -endless while recording or replaying."
+        );
+        options.isEndless = false;
+    }
+
+    size_t levelSize = LEVEL_ARENA_SIZE + render_getTexturesArenaSize()
+                       + sprites_getArenaSize(MAX_SPRITES);
+    if (options.loadPath)
+        levelSize += maze_getFileArenaSize(options.loadPath);
+    else if (!options.isEndless)
+        levelSize += maze_getArenaSize(options.mazeWidth, options.mazeHeight);
+
+    struct Arena levelArena;
+
+    if (!arena_init(&levelArena, levelSize))
+    {
+        replay_destroy(&pReplay);
+        return NULL;
+    }
+
+    struct GameContext *pGame = arena_alloc(&levelArena, sizeof(*pGame));
+
+    if (!pGame)
     {
         perror("Error: Unable to allocate a game context");
+        replay_destroy(&pReplay);
+        arena_destroy(&levelArena);
+        return NULL;
+    }
+
+    // From here on, the context's own copy of the arena is the real one
+    pGame->levelArena = levelArena;
+    pGame->options = options;
+    pGame->replay = pReplay;
+
+    if (!arena_init(&pGame->frameArena, FRAME_ARENA_SIZE))
+    {
+        replay_destroy(&pGame->replay);
+        arena_destroy(&pGame->levelArena);
+        return NULL;
+    }
+
+    if (!setDefaultValues(pGame, title))  // ensure setting values succeeds
+    {
+        replay_destroy(&pGame->replay);
+        arena_destroy(&pGame->frameArena);
+        levelArena = pGame->levelArena;   // the context is about to vanish
+        arena_destroy(&levelArena);
+        return NULL;
     }
 
     return pGame;
@@ -77,38 +278,177 @@ struct GameContext *game_initContext(int argc, char **argv, const char *title)
 /* Continuously calls the functions required to play, update, and render
  * the game. The loop ends when the user enters the right inputs to
  * terminate the game.
+ *
+ * The simulation advances in fixed steps, as many per frame as the time
+ * since the last frame covers, so it plays out the same at any frame
+ * rate. The view is drawn between the last two steps, as far along as
+ * the time left over, which keeps motion smooth when the display's
+ * refresh rate isn't a multiple of the step rate.
+ *
+ * A steady frame allocates nothing from the heap: whatever it needs was
+ * sized up front, and any scratch comes from the frame arena. The only
+ * exceptions are resizing the window, which sizes the framebuffer and
+ * its texture again, and the first frame each capture slot takes at a
+ * new window size. The capture writer and the way-out search allocate
+ * on their own threads, off the frame's path.
  */
 void game_runMainLoop(struct GameContext *restrict pGame)
 {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 stepTicks = frequency / STEPS_PER_SECOND;
+    const Uint64 maxFrameTicks = (Uint64)(frequency * MAX_FRAME_TIME);
+    const Uint64 frameTicks = pGame->options.fpsCap > 0
+        ? frequency / pGame->options.fpsCap
+        : 0;
+    const double stepSeconds = 1.0 / STEPS_PER_SECOND;  // exact, for replays
+
     input_clearEventQueue();  // start with a blank events slate
 
+    Uint64 lastTime = SDL_GetPerformanceCounter();
+    Uint64 nextFrame = lastTime;
+    Uint64 unsimulatedTicks = 0;
+
     // Run the main loop
     while (pGame->isRunning)
     {
-        // React to the user's input
-        input_refreshActions();
+        arena_reset(&pGame->frameArena);  // last frame's scratch is garbage now
+
+        // Catch up on the time since the last frame, but not after a stall
+        Uint64 now = SDL_GetPerformanceCounter();
+        unsimulatedTicks += SDL_min(now - lastTime, maxFrameTicks);
+        lastTime = now;
+
+        // React to the user's input, even on frames too short for a step
+        PROFILE_BEGIN(ZONE_INPUT, 0);
+        input_pumpEvents();
+        PROFILE_END(ZONE_INPUT, 0);
+
+        PROFILE_BEGIN(ZONE_ACTIONS, 0);
         processGameActions(pGame);
+        PROFILE_END(ZONE_ACTIONS, 0);
+
+        PROFILE_BEGIN(ZONE_SIMULATION, 0);
+        while (unsimulatedTicks >= stepTicks)
+        {
+            stepSimulation(pGame, stepSeconds);
+            unsimulatedTicks -= stepTicks;
+
+            // Sample the input again right before any step still to come
+            if (unsimulatedTicks >= stepTicks)
+            {
+                input_pumpEvents();
+                processGameActions(pGame);
+            }
+        }
+        PROFILE_END(ZONE_SIMULATION, 0);
+
+        // Map what the player can see from where they ended up
+        minimap_explore(pGame->minimap, pGame->maze, &pGame->currentPose);
+        collectWayOut(pGame);
 
-        // Render to the window
-        SDL_SetRenderDrawColor(
-            pGame->renderer,
-            0x00,
-            0x80,
-            0x80,
-            SDL_ALPHA_OPAQUE
+        // Render to the window, following it through any size changes
+        if (!resizeFrame(pGame))
+        {
+            pGame->isRunning = false;
+            break;
+        }
+
+        struct PlayerPose pose;
+        player_interpolatePoses(
+            &pGame->previousPose,
+            &pGame->currentPose,
+            (double)unsimulatedTicks / stepTicks,
+            &pose
         );
-        SDL_RenderClear(pGame->renderer);
-        SDL_RenderPresent(pGame->renderer);
-        SDL_Delay(16);
+        // Draw only if the view changed; presenting still shows the last one
+        bool isViewCurrent = render_isViewCurrent(&pGame->frame, &pose, pGame->sprites);
+        if (!isViewCurrent)
+        {
+            Uint64 renderStart = SDL_GetPerformanceCounter();
+            PROFILE_BEGIN(ZONE_RENDER, 0);
+            render_drawView(
+                &pGame->frame,
+                &pose,
+                pGame->maze,
+                &pGame->textures,
+                pGame->sprites,
+                pGame->workers,
+                pGame->isInterlaced
+            );
+            PROFILE_END(ZONE_RENDER, 0);
+
+            // Any change of scale resizes the frame on the next one
+            Uint64 renderTicks = SDL_GetPerformanceCounter() - renderStart;
+            resolution_addSample(&pGame->scaler, (double)renderTicks / frequency);
+        }
+
+        presentFrame(pGame, &pose);
+        captureFrame(pGame);
+
+        if (canIdle(pGame, isViewCurrent))
+        {
+            // Sleep until there's something to react to, and don't
+            // simulate the time slept, so a key pressed now doesn't
+            // move the player as if it had been held the whole while
+            PROFILE_BEGIN(ZONE_WAIT, 0);
+            SDL_WaitEventTimeout(NULL, IDLE_TIMEOUT_MS);  // leaves it queued
+            lastTime = SDL_GetPerformanceCounter();
+            PROFILE_END(ZONE_WAIT, 0);
+        }
+        else if (frameTicks > 0)
+        {
+            PROFILE_BEGIN(ZONE_WAIT, 0);
+            waitForNextFrame(&nextFrame, frameTicks);
+            PROFILE_END(ZONE_WAIT, 0);
+        }
+
+        profiler_endFrame();
+    }
+
+    // End the log with a quit, however the game ended, to mark its length
+    if (pGame->recording)
+    {
+        struct GameAction quit = { .command = CMD_QUIT, .magnitude = 0.0f };
+        replay_record(pGame->recording, pGame->step, &quit);
+        replay_destroy(&pGame->recording);
+        SDL_Log("Recorded %u steps of input.", (unsigned)pGame->step);
+    }
+
+    if (pGame->options.tracePath)
+    {
+        const char *path = pGame->options.tracePath;
+
+        if (profiler_writeTrace(path, pGame->options.traceFrames))
+            SDL_Log("Saved a trace of the last frames to %s.", path);
+        else if (!PROFILER_IS_BUILT)
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Ignoring -trace; this build has no profiler."
+            );
     }
 }
 
 
 /* Deallocates every bit of memory allocated for the game and nullifies
- * all pointers to that memory.
+ * all pointers to that memory. Whatever lives in the level arena, the
+ * context included, goes away with it at the very end.
  */
 void game_destroy(struct GameContext * restrict *ppGame)
 {
+    stopWayOutSearch(&(*ppGame)->wayOut);  // it reads the maze
+    workers_destroy(&(*ppGame)->workers);
+    profiler_destroy();
+    render_destroyFramebuffer(&(*ppGame)->frame);
+    maze_destroy(&(*ppGame)->maze);  // unmaps it if it was loaded
+    stream_destroy(&(*ppGame)->stream);
+    replay_destroy(&(*ppGame)->recording);
+    replay_destroy(&(*ppGame)->replay);
+    capture_destroy(&(*ppGame)->capture);  // writes out what's still queued
+    minimap_destroy(&(*ppGame)->minimap);  // before the renderer of its textures
+
+    SDL_DestroyTexture((*ppGame)->frameTexture);
+    (*ppGame)->frameTexture = NULL;
+
     SDL_DestroyRenderer((*ppGame)->renderer);
     (*ppGame)->renderer = NULL;
 
@@ -116,7 +456,11 @@ void game_destroy(struct GameContext * restrict *ppGame)
     (*ppGame)->window = NULL;
 
     SDL_Quit();
-    freeMemory((void **)ppGame);
+
+    struct Arena levelArena = (*ppGame)->levelArena;
+    arena_destroy(&(*ppGame)->frameArena);
+    arena_destroy(&levelArena);
+    *ppGame = NULL;
 }
 
 
@@ -136,13 +480,18 @@ static bool setDefaultValues(struct GameContext *pGame, const char *title)
 {
     assert(pGame != NULL);
 
-    pGame->isFullscreen = false;
+    pGame->isFullscreen = !pGame->options.isWindowed;
     SDL_WindowFlags windowFlags =
         ( SDL_WINDOW_FULLSCREEN * pGame->isFullscreen )
         | SDL_WINDOW_KEYBOARD_GRABBED;
 
     // Allocate a window
-    pGame->window = SDL_CreateWindow(title, 1280, 720, windowFlags);
+    pGame->window = SDL_CreateWindow(
+        title,
+        pGame->options.width,
+        pGame->options.height,
+        windowFlags
+    );
 
     if (!pGame->window)
     {
@@ -164,47 +513,865 @@ static bool setDefaultValues(struct GameContext *pGame, const char *title)
             "Failed to initialize a renderer for the game window: %s.",
             SDL_GetError()
         );
-        free(pGame->window);
+        SDL_DestroyWindow(pGame->window);
         return false;
     }
 
-    // Allocate the player
-    pGame->player = player_init(32.0, 64.0, 0.0, -1.0);
+    // Sync to the display unless told not to; not every driver can
+    if (!SDL_SetRenderVSync(pGame->renderer, pGame->options.isVsyncOff ? 0 : 1))
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Failed to change the VSync setting: %s.",
+            SDL_GetError()
+        );
+    }
 
-    if (!pGame->player)
+    // Hide the cursor and report raw motion, so the mouse can turn freely
+    if (!SDL_SetWindowRelativeMouseMode(pGame->window, true))
     {
-        SDL_LogError(
-            SDL_LOG_CATEGORY_ERROR,
-            "Failed to initialize a player: %s.",
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Failed to capture the mouse for turning: %s.",
             SDL_GetError()
         );
-        free(pGame->renderer);  // free first to avoid a dangling window pointer
-        free(pGame->window);
+    }
+
+    // Draw smaller when drawing at full size can't keep up, if allowed
+    double budget = getRenderBudget(pGame);
+    resolution_init(&pGame->scaler, budget);
+
+    if (budget > 0.0)
+        SDL_Log("Scaling the view down if it takes over %.1f ms.", budget * 1000.0);
+
+    // Pick the fastest ray casting kernel this CPU can run
+    enum RaycastKernel kernel = raycast_selectKernel(pGame->options.raycastKernel);
+    SDL_Log("Ray casting with the %s kernel.", raycast_getKernelName(kernel));
+    flats_selectKernel(kernel);
+    palette_selectKernel(kernel);
+
+    if (pGame->options.isIndexed)
+        SDL_Log("Drawing in 256 colors.");
+
+    // Start the worker threads, one per logical core unless told otherwise
+    int threadCount = pGame->options.threadCount;
+    if (threadCount == 0)
+        threadCount = SDL_GetNumLogicalCPUCores();
+
+    pGame->workers = workers_create(threadCount);
+
+    if (!pGame->workers)
+    {
+        SDL_DestroyRenderer(pGame->renderer);
+        SDL_DestroyWindow(pGame->window);
+        return false;
+    }
+
+    // Generate the level; the frame itself is sized on the first frame
+    pGame->frameTexture = NULL;
+    pGame->frame = (struct Framebuffer) { 0 };
+    pGame->stream = NULL;
+
+    if (pGame->options.isEndless)
+    {
+        const struct GameOptions *pOptions = &pGame->options;
+        uint64_t seed = pOptions->hasSeed ? pOptions->seed : SDL_GetPerformanceCounter();
+        pGame->stream = stream_create(seed);
+        pGame->maze = pGame->stream ? stream_getMaze(pGame->stream) : NULL;
+
+        if (pGame->maze)
+        {
+            SDL_Log(
+                "Streaming an endless maze from seed %llu.",
+                (unsigned long long)seed
+            );
+        }
+    }
+    else
+    {
+        pGame->maze = loadMaze(
+            &pGame->options,
+            pGame->workers,
+            &pGame->levelArena,
+            &pGame->frameArena
+        );
+    }
+
+    if (!pGame->maze)
+    {
+        workers_destroy(&pGame->workers);
+        stream_destroy(&pGame->stream);
+        SDL_DestroyRenderer(pGame->renderer);
+        SDL_DestroyWindow(pGame->window);
         return false;
     }
 
+    if (pGame->replay)
+        replay_isSameMaze(pGame->replay, pGame->maze);  // warns if it isn't
+
+    // Build the textures once, along with the rest of the level
+    bool isIndexed = pGame->options.isIndexed;
+
+    if (!render_createTextures(&pGame->textures, &pGame->levelArena, isIndexed))
+    {
+        workers_destroy(&pGame->workers);
+        maze_destroy(&pGame->maze);
+        stream_destroy(&pGame->stream);
+        SDL_DestroyRenderer(pGame->renderer);
+        SDL_DestroyWindow(pGame->window);
+        return false;
+    }
+
+    // Allocate the player, standing still
+    pGame->player = player_initAtStart(&pGame->levelArena, pGame->maze);
+
+    if (!pGame->player)
+    {
+        workers_destroy(&pGame->workers);
+        maze_destroy(&pGame->maze);
+        stream_destroy(&pGame->stream);
+        SDL_DestroyRenderer(pGame->renderer);  // before the window it renders to
+        SDL_DestroyWindow(pGame->window);
+        return false;
+    }
+
+    // Start the map with nothing explored, hidden until asked for
+    pGame->minimap = minimap_create(pGame->maze, pGame->renderer);
+    pGame->isMinimapShown = false;
+
+    if (!pGame->minimap)
+    {
+        workers_destroy(&pGame->workers);
+        maze_destroy(&pGame->maze);
+        stream_destroy(&pGame->stream);
+        SDL_DestroyRenderer(pGame->renderer);
+        SDL_DestroyWindow(pGame->window);
+        return false;
+    }
+
+    // Mark the exit, if there is one, and drop no crumbs until asked to
+    pGame->sprites = sprites_create(MAX_SPRITES, &pGame->levelArena);
+    pGame->isTrailOn = false;
+
+    if (!pGame->sprites)
+    {
+        workers_destroy(&pGame->workers);
+        maze_destroy(&pGame->maze);
+        stream_destroy(&pGame->stream);
+        minimap_destroy(&pGame->minimap);
+        SDL_DestroyRenderer(pGame->renderer);
+        SDL_DestroyWindow(pGame->window);
+        return false;
+    }
+
+    if (!pGame->stream)
+    {
+        sprites_add(
+            pGame->sprites,
+            pGame->maze->exitX + 0.5,
+            pGame->maze->exitY + 0.5,
+            SPRITE_EXIT
+        );
+    }
+
+    SDL_Log("Rendering on %d threads.", workers_getThreadCount(pGame->workers));
+    pGame->isInterlaced = pGame->options.isInterlaced;
+
+    // Profile every thread; the game runs fine without it
+    profiler_init(workers_getThreadCount(pGame->workers));
+    pGame->isProfilerShown = false;
+
+    player_getPose(pGame->player, &pGame->currentPose);
+    pGame->previousPose = pGame->currentPose;
+    followPlayer(pGame);  // into the middle of an endless maze
+    pGame->input = (struct InputState) { 0 };
+    pGame->step = 0;
+
+    // Record the input if asked to; the game can go on without it
+    pGame->recording = NULL;
+
+    if (pGame->options.recordPath && pGame->replay)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Ignoring -record while replaying.");
+    }
+    else if (pGame->options.recordPath)
+    {
+        pGame->recording = replay_startRecording(pGame->options.recordPath, pGame->maze);
+
+        if (!pGame->recording)
+        {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Playing on without recording the input."
+            );
+        }
+    }
+
+    // Save screenshots and video without waiting on the disk; the game can
+    // go on without either
+    pGame->capture = capture_create(pGame->options.capturePath);
+    pGame->isScreenshotDue = false;
+
+    if (!pGame->capture)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Playing on without screenshots or video."
+        );
+    }
+
+    // Look for the way out in the background when asked to; the game can
+    // go on without it
+    startWayOutSearch(pGame);
+
     pGame->isRunning = true;  // and we're on
     return true;
 }
 
 
 /* Converts the abstract actions in the input module's action queue into
- * concrete in-game actions.
+ * concrete in-game actions, recording each one against the step it comes
+ * before. While replaying, the log drives the player instead, and live
+ * input can only do what doesn't touch the simulation, like quitting.
  */
 static void processGameActions(struct GameContext *restrict pGame)
 {
     struct GameAction action;
     while (input_loadNextAction(&action))
     {
-        switch (action.command)
+        if (pGame->replay && input_drivesPlayer(action.command))
+            continue;
+
+        if (pGame->recording && !replay_record(pGame->recording, pGame->step, &action))
         {
-        case CMD_TOGGLE_FULLSCREEN:
-            pGame->isFullscreen = !pGame->isFullscreen;
-            SDL_SetWindowFullscreen(pGame->window, pGame->isFullscreen);
-            break;
-        case CMD_QUIT:
-            pGame->isRunning = false;
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Stopped recording the input.");
+            replay_destroy(&pGame->recording);
+        }
+
+        executeGameAction(pGame, &action);
+    }
+
+    if (pGame->replay)
+    {
+        while (replay_loadNextAction(pGame->replay, pGame->step, &action))
+            executeGameAction(pGame, &action);
+    }
+}
+
+
+/* Leaves whatever drives the player to the input state.
+ */
+static void executeGameAction(
+    struct GameContext *restrict pGame,
+    const struct GameAction *restrict pAction
+) {
+    switch (pAction->command)
+    {
+    case CMD_TOGGLE_FULLSCREEN:
+        pGame->isFullscreen = !pGame->isFullscreen;
+        SDL_SetWindowFullscreen(pGame->window, pGame->isFullscreen);
+        break;
+    case CMD_QUIT:
+        pGame->isRunning = false;
+        break;
+    case CMD_TOGGLE_PROFILER:
+        if (PROFILER_IS_BUILT)
+            pGame->isProfilerShown = !pGame->isProfilerShown;
+        else
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "This build has no profiler.");
+        break;
+    case CMD_TOGGLE_MINIMAP:
+        pGame->isMinimapShown = !pGame->isMinimapShown;
+        break;
+    case CMD_SHOW_WAY_OUT:
+        showWayOut(pGame);
+        break;
+    case CMD_TOGGLE_TRAIL:
+        pGame->isTrailOn = !pGame->isTrailOn;
+        break;
+    case CMD_TOGGLE_INTERLACE:
+        pGame->isInterlaced = !pGame->isInterlaced;
+        break;
+    case CMD_SCREENSHOT:
+        pGame->isScreenshotDue = true;  // of the frame about to be drawn
+        break;
+    default:
+        input_applyAction(&pGame->input, pAction);
+        break;
+    }
+}
+
+
+/* Mouse motion since the last step is all turned in this one. Keeps the
+ * pose from before the step around for the renderer to interpolate from.
+ */
+static void stepSimulation(struct GameContext *restrict pGame, double seconds)
+{
+    struct PlayerInput input;
+    input_takePlayerInput(&pGame->input, &input);
+
+    pGame->previousPose = pGame->currentPose;
+    player_update(pGame->player, &input, pGame->maze, seconds);
+    player_getPose(pGame->player, &pGame->currentPose);
+    followPlayer(pGame);
+    dropCrumb(pGame);
+    ++pGame->step;
+}
+
+
+/* Schedules frames on a fixed grid rather than sleeping a fixed time
+ * after each one, so that time spent drawing doesn't add up to drift.
+ * After falling more than a frame behind, it starts the grid over
+ * instead of racing to catch up.
+ */
+static void waitForNextFrame(Uint64 *restrict pNextFrame, Uint64 frameTicks)
+{
+    *pNextFrame += frameTicks;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (now < *pNextFrame)
+    {
+        Uint64 nanoseconds = (*pNextFrame - now) * SDL_NS_PER_SECOND
+                             / SDL_GetPerformanceFrequency();
+        SDL_DelayPrecise(nanoseconds);
+    }
+    else if (now - *pNextFrame > frameTicks)
+    {
+        *pNextFrame = now;
+    }
+}
+
+
+/* A frame is idle when it showed the same view as the one before it.
+ * The profiler overlay changes every frame, so it keeps the game awake,
+ * and so does a replay, which moves the player without any events.
+ */
+static bool canIdle(const struct GameContext *restrict pGame, bool isViewCurrent)
+{
+    return isViewCurrent && !pGame->isProfilerShown && !pGame->replay;
+}
+
+
+/* One crumb per cell, in the middle of it, so the trail reads as a path
+ * on the floor however the player wanders through. Turns the trail off
+ * once there's no room for more.
+ */
+static void dropCrumb(struct GameContext *restrict pGame)
+{
+    int x = (int)pGame->currentPose.xPos;
+    int y = (int)pGame->currentPose.yPos;
+
+    if (!pGame->isTrailOn || sprites_isInCell(pGame->sprites, x, y, SPRITE_CRUMB))
+        return;
+
+    if (!sprites_add(pGame->sprites, x + 0.5, y + 0.5, SPRITE_CRUMB))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "No room for more breadcrumbs.");
+        pGame->isTrailOn = false;
+    }
+}
+
+
+/* Moves both poses too, so the view interpolates between them as if
+ * nothing had moved, and the minimap, which would otherwise show what
+ * was explored in the wrong place. Crumbs left behind off the window go
+ * for good, so a long trail never fills the sprite set.
+ */
+static void followPlayer(struct GameContext *restrict pGame)
+{
+    int xShift, yShift;
+
+    if (!pGame->stream
+        || !stream_follow(pGame->stream, &pGame->currentPose, &xShift, &yShift))
+    {
+        return;
+    }
+
+    player_shift(pGame->player, xShift, yShift);
+    player_getPose(pGame->player, &pGame->currentPose);
+    pGame->previousPose.xPos += xShift;
+    pGame->previousPose.yPos += yShift;
+    minimap_shift(pGame->minimap, xShift, yShift);
+    sprites_shift(
+        pGame->sprites,
+        xShift,
+        yShift,
+        pGame->maze->width,
+        pGame->maze->height
+    );
+}
+
+
+/* Logs the seed of every generated maze, so that any run can be
+ * reproduced with -seed, and checks it before saving it, so a broken
+ * generator never gets as far as a file. Failing to save is only worth
+ * a warning; the game can go on without the file.
+ */
+static struct Maze *loadMaze(
+    const struct GameOptions *restrict pOptions,
+    struct WorkerPool *pWorkers,
+    struct Arena *restrict pArena,
+    struct Arena *restrict pScratch
+) {
+    struct Maze *pMaze;
+
+    if (pOptions->loadPath)
+    {
+        pMaze = maze_load(pOptions->loadPath, pArena);
+
+        if (pMaze)
+        {
+            SDL_Log(
+                "Loaded a %dx%d maze from %s.",
+                pMaze->width,
+                pMaze->height,
+                pOptions->loadPath
+            );
+        }
+
+        // Only loaded mazes can have open space; generated ones are perfect
+        if (pMaze && !pOptions->isSkipOff)
+        {
+            maze_buildDistances(pMaze, pArena);  // goes on without one if this fails
+
+            if (pMaze->distances)
+                SDL_Log("Skipping open space with a distance field.");
+        }
+    }
+    else
+    {
+        uint64_t seed = pOptions->hasSeed ? pOptions->seed : SDL_GetPerformanceCounter();
+        pMaze = maze_create(
+            pOptions->mazeWidth,
+            pOptions->mazeHeight,
+            seed,
+            pArena,
+            pScratch
+        );
+
+        if (pMaze)
+        {
+            SDL_Log(
+                "Generated a %dx%d maze from seed %llu.",
+                pMaze->width,
+                pMaze->height,
+                (unsigned long long)seed
+            );
+        }
+
+        if (pMaze && !pOptions->isCheckOff && !hasExitPath(pMaze, pWorkers))
+            maze_destroy(&pMaze);
+    }
+
+    if (pMaze && pOptions->savePath)
+    {
+        if (maze_save(pMaze, pOptions->savePath))
+        {
+            SDL_Log("Saved the maze to %s.", pOptions->savePath);
+        }
+        else
+        {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Playing on without saving the maze."
+            );
+        }
+    }
+
+    return pMaze;
+}
+
+
+/* Gives the search its own scratch space for the one search, since it
+ * takes a few bits per cell, far more than the frame arena has room for.
+ */
+static bool hasExitPath(const struct Maze *restrict pMaze, struct WorkerPool *pWorkers)
+{
+    struct Arena scratch;
+
+    if (!arena_init(&scratch, solver_getMeasureScratchSize(pMaze->width, pMaze->height)))
+        return false;
+
+    int64_t length;
+    bool isMeasured = solver_measurePath(
+        pMaze,
+        0,
+        0,
+        pMaze->exitX,
+        pMaze->exitY,
+        pWorkers,
+        &scratch,
+        &length
+    );
+    arena_destroy(&scratch);
+
+    if (!isMeasured)
+        return false;
+
+    if (length < 0)
+    {
+        fprintf(stderr, "Error: The maze has no way from the start to the exit.\n");
+        return false;
+    }
+
+    SDL_Log("The exit is %lld steps from the start.", (long long)length);
+    return true;
+}
+
+
+/* The thread is started once, with the game, so that asking for the way
+ * out starts no threads. Endless mazes have no way out to look for.
+ */
+static void startWayOutSearch(struct GameContext *restrict pGame)
+{
+    struct WayOutSearch *pSearch = &pGame->wayOut;
+
+    pSearch->thread = NULL;
+    pSearch->isSearching = false;
+    SDL_SetAtomicInt(&pSearch->isQuitting, 0);
+
+    if (pGame->stream)
+    {
+        pSearch->wakeSignal = NULL;
+        return;
+    }
+
+    pSearch->wakeSignal = SDL_CreateSemaphore(0);
+
+    if (pSearch->wakeSignal)
+        pSearch->thread = SDL_CreateThread(findWayOut, "way out", pSearch);
+
+    if (!pSearch->thread)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Playing on without a way to find the exit: %s.",
+            SDL_GetError()
+        );
+        SDL_DestroySemaphore(pSearch->wakeSignal);
+        pSearch->wakeSignal = NULL;
+    }
+}
+
+
+/* Lets a search under way finish rather than cutting it short, since
+ * the solver can't be interrupted.
+ */
+static void stopWayOutSearch(struct WayOutSearch *restrict pSearch)
+{
+    if (!pSearch->thread)
+        return;
+
+    SDL_SetAtomicInt(&pSearch->isQuitting, 1);
+    SDL_SignalSemaphore(pSearch->wakeSignal);
+    SDL_WaitThread(pSearch->thread, NULL);
+    SDL_DestroySemaphore(pSearch->wakeSignal);
+    pSearch->thread = NULL;
+    pSearch->wakeSignal = NULL;
+}
+
+
+/* Searching a large maze takes a while, clearing its scratch space
+ * included, so the search runs on a thread of its own while the game
+ * goes on, and the way out shows up once it's done. Asking again while
+ * a search is under way does nothing. The maze can't change under the
+ * search, since only endless mazes change, and those have no way out.
+ */
+static void showWayOut(struct GameContext *restrict pGame)
+{
+    struct WayOutSearch *pSearch = &pGame->wayOut;
+
+    if (pGame->stream)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "An endless maze has no way out.");
+        return;
+    }
+
+    if (!pSearch->thread || pSearch->isSearching)
+        return;  // no way to look, or the way out is already on its way
+
+    pSearch->maze  = pGame->maze;
+    pSearch->xFrom = (int)pGame->currentPose.xPos;
+    pSearch->yFrom = (int)pGame->currentPose.yPos;
+    pSearch->isSearching = true;
+    SDL_SetAtomicInt(&pSearch->isDone, 0);
+    SDL_SignalSemaphore(pSearch->wakeSignal);
+}
+
+
+/* Owns the search's scratch space for just as long as each search runs,
+ * so the frame loop never waits on allocating or clearing it.
+ */
+static int SDLCALL findWayOut(void *pData)
+{
+    struct WayOutSearch *pSearch = pData;
+
+    for (;;)
+    {
+        SDL_WaitSemaphore(pSearch->wakeSignal);
+
+        if (SDL_GetAtomicInt(&pSearch->isQuitting))
             break;
+
+        const struct Maze *pMaze = pSearch->maze;
+        struct Arena scratch;
+
+        pSearch->isFound = arena_init(
+            &scratch,
+            solver_getFindScratchSize(pMaze->width, pMaze->height)
+        );
+
+        if (pSearch->isFound)
+        {
+            pSearch->isFound = solver_findPath(
+                pMaze,
+                pSearch->xFrom,
+                pSearch->yFrom,
+                pMaze->exitX,
+                pMaze->exitY,
+                &scratch,
+                pSearch->steps,
+                MINIMAP_PATH_STEPS,
+                &pSearch->length
+            );
+            arena_destroy(&scratch);
         }
+
+        SDL_SetAtomicInt(&pSearch->isDone, 1);  // publishes the results too
+    }
+
+    return 0;
+}
+
+
+/* Checks in without waiting, so a search still under way costs nothing.
+ */
+static void collectWayOut(struct GameContext *restrict pGame)
+{
+    struct WayOutSearch *pSearch = &pGame->wayOut;
+
+    if (!pSearch->isSearching || !SDL_GetAtomicInt(&pSearch->isDone))
+        return;
+
+    pSearch->isSearching = false;
+
+    if (pSearch->isFound && pSearch->length >= 0)
+    {
+        int stepCount = (int)SDL_min(pSearch->length, MINIMAP_PATH_STEPS);
+        minimap_showPath(
+            pGame->minimap,
+            pSearch->xFrom,
+            pSearch->yFrom,
+            pSearch->steps,
+            stepCount
+        );
+        pGame->isMinimapShown = true;
+        SDL_Log("The exit is %lld steps away.", (long long)pSearch->length);
+    }
+    else if (pSearch->isFound)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "There's no way to the exit from here."
+        );
+    }
+}
+
+
+/* Leaves the rest of each frame's time for everything but the view,
+ * presenting included. Under a frame rate cap the frame's time is set;
+ * otherwise it's as long as the display shows each frame, whether or
+ * not VSync waits for it.
+ */
+static double getRenderBudget(const struct GameContext *restrict pGame)
+{
+    if (pGame->options.isDynResOff)
+        return 0.0;
+
+    float frameRate = (float)pGame->options.fpsCap;
+
+    if (frameRate <= 0.0f)
+    {
+        SDL_DisplayID display = SDL_GetDisplayForWindow(pGame->window);
+        const SDL_DisplayMode *pMode = SDL_GetCurrentDisplayMode(display);
+        frameRate = pMode && pMode->refresh_rate > 0.0f
+            ? pMode->refresh_rate
+            : FALLBACK_REFRESH;
+    }
+
+    return RENDER_SHARE / frameRate;
+}
+
+
+/* Checks the output size every frame rather than waiting on window
+ * events, since toggling full screen resizes the window asynchronously,
+ * and the scale can change after any frame. Recreates the framebuffer
+ * and the streaming texture only when the window's size changes; a
+ * change of scale only shrinks or grows the view inside them, since it
+ * comes just when the frame is already over budget. The view's corner
+ * of the texture is stretched over the whole window when presented.
+ */
+static bool resizeFrame(struct GameContext *restrict pGame)
+{
+    int outputWidth, outputHeight;
+    if (!SDL_GetCurrentRenderOutputSize(pGame->renderer, &outputWidth, &outputHeight))
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to get the size of the game window: %s.",
+            SDL_GetError()
+        );
+        return false;
+    }
+
+    outputWidth = SDL_max(outputWidth, 1);  // a minimized window may have none
+    outputHeight = SDL_max(outputHeight, 1);
+
+    double scale = resolution_getScale(&pGame->scaler);
+    int width = SDL_clamp((int)(outputWidth * scale + 0.5), 1, outputWidth);
+    int height = SDL_clamp((int)(outputHeight * scale + 0.5), 1, outputHeight);
+
+    if (outputWidth != pGame->frame.maxWidth || outputHeight != pGame->frame.maxHeight)
+    {
+        SDL_DestroyTexture(pGame->frameTexture);
+        render_destroyFramebuffer(&pGame->frame);
+
+        if (!createFrame(pGame, outputWidth, outputHeight))
+            return false;
+    }
+
+    render_setViewSize(&pGame->frame, width, height);
+    return true;
+}
+
+
+/* Blending neighboring pixels when scaling up beats repeating them.
+ */
+static bool createFrame(struct GameContext *restrict pGame, int width, int height)
+{
+    pGame->frameTexture = SDL_CreateTexture(
+        pGame->renderer,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STREAMING,
+        width,
+        height
+    );
+
+    if (!pGame->frameTexture)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create a texture for the game view: %s.",
+            SDL_GetError()
+        );
+        return false;
+    }
+
+    SDL_SetTextureScaleMode(pGame->frameTexture, SDL_SCALEMODE_LINEAR);
+
+    return render_initFramebuffer(&pGame->frame, width, height, pGame->options.isIndexed);
+}
+
+
+/* Locks the part of the texture the framebuffer changed in, if any, and
+ * copies the framebuffer straight into it, which beats issuing a draw
+ * call per column by a wide margin. An indexed framebuffer is expanded
+ * to full color in the same pass. An unchanged frame skips the upload
+ * and presents the texture as it was. The overlays are drawn over it
+ * afresh every time.
+ */
+static void presentFrame(
+    struct GameContext *restrict pGame,
+    const struct PlayerPose *restrict pPose
+) {
+    struct Framebuffer *pFrame = &pGame->frame;
+    struct FrameRegion dirty;
+    bool isLocked = false;
+    void *pTexels;
+    int texturePitch;
+
+    PROFILE_BEGIN(ZONE_UPLOAD, 0);
+
+    if (render_takeDirtyRegion(pFrame, &dirty))
+    {
+        SDL_Rect rect = { dirty.x, dirty.y, dirty.width, dirty.height };
+        isLocked = SDL_LockTexture(pGame->frameTexture, &rect, &pTexels, &texturePitch);
+    }
+
+    if (isLocked)
+    {
+        render_copyRegion(pFrame, &dirty, pTexels, texturePitch);
+        SDL_UnlockTexture(pGame->frameTexture);
+    }
+
+    SDL_FRect view = { 0.0f, 0.0f, (float)pFrame->width, (float)pFrame->height };
+    SDL_RenderTexture(pGame->renderer, pGame->frameTexture, &view, NULL);
+    PROFILE_END(ZONE_UPLOAD, 0);
+
+    if (pGame->isMinimapShown
+        && !minimap_draw(pGame->minimap, pGame->renderer, pGame->maze, pPose))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Hiding the minimap.");
+        pGame->isMinimapShown = false;
+    }
+
+    if (pGame->isProfilerShown)
+        drawProfilerOverlay(pGame->renderer);
+
+    PROFILE_BEGIN(ZONE_PRESENT, 0);
+    SDL_RenderPresent(pGame->renderer);
+    PROFILE_END(ZONE_PRESENT, 0);
+}
+
+
+/* Captures the framebuffer rather than the window, so neither the
+ * overlays nor the stretch to the window's size end up in it. Runs after
+ * presenting, so the copy it makes never holds up a frame being shown.
+ */
+static void captureFrame(struct GameContext *restrict pGame)
+{
+    if (!pGame->capture)
+        return;
+
+    PROFILE_BEGIN(ZONE_CAPTURE, 0);
+
+    if (pGame->isScreenshotDue)
+        capture_takeScreenshot(pGame->capture, &pGame->frame);
+
+    capture_addVideoFrame(pGame->capture, &pGame->frame);
+    pGame->isScreenshotDue = false;
+    PROFILE_END(ZONE_CAPTURE, 0);
+}
+
+
+/* Uses SDL's built-in debug font, which needs no assets, on a dark
+ * backdrop so that it stays readable over any wall.
+ */
+static void drawProfilerOverlay(SDL_Renderer *restrict pRenderer)
+{
+    SDL_FRect backdrop = {
+        .x = OVERLAY_MARGIN / 2,
+        .y = OVERLAY_MARGIN / 2,
+        .w = 24 * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + OVERLAY_MARGIN,
+        .h = NUM_PROFILE_ZONES * OVERLAY_LINE + OVERLAY_MARGIN
+    };
+
+    SDL_SetRenderDrawBlendMode(pRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(pRenderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(pRenderer, &backdrop);
+    SDL_SetRenderDrawColor(pRenderer, 255, 255, 255, 255);
+
+    for (int zone = 0; zone < NUM_PROFILE_ZONES; ++zone)
+    {
+        char line[32];
+        SDL_snprintf(
+            line,
+            sizeof(line),
+            "%-10s %8.3f ms",
+            profiler_getZoneName(zone),
+            profiler_getZoneMs(zone)
+        );
+        float y = OVERLAY_MARGIN + zone * OVERLAY_LINE;
+        SDL_RenderDebugText(pRenderer, OVERLAY_MARGIN, y, line);
     }
 }
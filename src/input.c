@@ -3,7 +3,7 @@
  * @brief Implementation of the input module.
  *
  * Defines the interface for the input module and provides internal
- * helper functions to clear, refresh, and read the action queue.
+ * helper functions to clear, fill, and read the action ring.
  *
  * @author Joseph Borjon
  * @date   2024-12-16
@@ -11,62 +11,96 @@
 
 #include <stdbool.h>    // for the bool type
 #include <assert.h>     // for debugging assertions
-#include <SDL3/SDL.h>   // for SDL3 events
+#include <SDL3/SDL.h>   // for SDL3 events and atomics
 #include "input.h"      // the header implemented here
 
-#define MAX_ACTIONS  32  // the highest possible number of actions in the queue
+#define RING_SIZE       256  // actions the ring holds; must be a power of 2
+#define ROOM_PER_EVENT  3    // most ring slots one event can take: its own
+                             // action, a motion flushed before it, and a
+                             // motion flushed when pumping stops
+#define MOUSE_TURN_SPEED  0.0025f  // radians turned per pixel of mouse motion
 
-// Container for the game actions to be executed
-struct ActionQueue
+// Single-producer, single-consumer queue of the game actions to execute.
+// Each side publishes its count only after it's done with the slot, so
+// the two can run on different threads without locks.
+struct ActionRing
 {
-    struct GameAction actions[MAX_ACTIONS];  // container for the actions
-    int               size;                  // number of actions in the queue
-    int               head;                  // index of the current action
+    struct GameAction actions[RING_SIZE];  // slots, indexed by count % size
+    SDL_AtomicU32     readCount;           // actions ever read; consumer only
+    SDL_AtomicU32     writeCount;          // actions ever written; producer only
+    struct GameAction pendingMotion;       // motion merged but not yet written
+    bool              hasPendingMotion;    // is pendingMotion worth writing?
 };
 
-// The action queue itself
-static struct ActionQueue _actionQueue = {
-    .actions = {},
-    .size    = 0,
-    .head    = 0
-};
+// The action ring itself
+static struct ActionRing _actionRing = { 0 };
 
 
 // === Static function prototypes === //
 
-// Adds an action with the specified value to the end of the queue if not full
-void appendGameAction(enum UserCommand command, float magnitude);
+// Checks that the ring has at least `count` free slots
+static bool hasRoom(Uint32 count);
+
+// Writes an action to the ring, after any motion merged before it
+static void appendGameAction(enum UserCommand command, float magnitude);
+
+// Merges motion into the pending motion, or starts a new one
+static void appendMotion(enum UserCommand command, float magnitude);
+
+// Writes the pending motion to the ring, if any
+static void flushMotion(void);
+
+// Maps a key to the command it holds down, or CMD_UNKNOWN if none
+static enum UserCommand getHeldCommand(SDL_Keycode key);
 
 
 // === Interface function definitions === //
 
 /* Reads all the events currently in SDL3's event queue and does nothing
- * with them, effectively discarding them.
+ * with them, effectively discarding them, along with any actions that
+ * were already queued.
  */
 void input_clearEventQueue(void)
 {
     SDL_Event discardedEvent;
     while (SDL_PollEvent(&discardedEvent))
         ;  // empty on purpose
+
+    struct GameAction discardedAction;
+    while (input_loadNextAction(&discardedAction))
+        ;  // empty on purpose
+
+    _actionRing.hasPendingMotion = false;
 }
 
 
 /* Reads user device inputs, converts them to game actions, and puts the
- * actions in the action queue in FIFO order.
+ * actions in the action ring in FIFO order.
+ *
+ * Stops reading once the ring is nearly full, leaving the rest of the
+ * events in SDL3's own queue for the next call, so nothing is dropped.
  */
-void input_refreshActions(void)
+void input_pumpEvents(void)
 {
     // To keep track of the two fullscreen-toggling keys
     static bool isFullscrKey1Down = false;
     static bool isFullscrKey2Down = false;
 
-    // Reset the queue
-    _actionQueue.size = 0;
-    _actionQueue.head = 0;
-
     SDL_Event event;
-    while (SDL_PollEvent(&event))
+    while (hasRoom(ROOM_PER_EVENT) && SDL_PollEvent(&event))
     {
+        // Movement keys report both ends of a press, but not key repeats
+        bool isKeyEvent =
+            event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP;
+
+        if (isKeyEvent && !event.key.repeat)
+        {
+            enum UserCommand heldCommand = getHeldCommand(event.key.key);
+
+            if (heldCommand != CMD_UNKNOWN)
+                appendGameAction(heldCommand, event.key.down ? 1.0f : 0.0f);
+        }
+
         switch (event.type)
         {
         case SDL_EVENT_KEY_DOWN:
@@ -82,6 +116,30 @@ void input_refreshActions(void)
             case SDLK_ESCAPE:
                 appendGameAction(CMD_QUIT, 0.0);
                 break;
+            case SDLK_F3:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_TOGGLE_PROFILER, 0.0);
+                break;
+            case SDLK_TAB:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_TOGGLE_MINIMAP, 0.0);
+                break;
+            case SDLK_H:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_SHOW_WAY_OUT, 0.0);
+                break;
+            case SDLK_B:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_TOGGLE_TRAIL, 0.0);
+                break;
+            case SDLK_I:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_TOGGLE_INTERLACE, 0.0);
+                break;
+            case SDLK_F12:
+                if (!event.key.repeat)
+                    appendGameAction(CMD_SCREENSHOT, 0.0);
+                break;
             }
 
             // Toggle full screen
@@ -106,43 +164,178 @@ void input_refreshActions(void)
                 break;
             }
             break;  // SDL_EVENT_KEY_UP
+        case SDL_EVENT_MOUSE_MOTION:
+            appendMotion(CMD_TURN_MOUSE, event.motion.xrel);
+            break;
         case SDL_EVENT_QUIT:
             appendGameAction(CMD_QUIT, 0.0);
             break;
         }
     }
 
-    assert(_actionQueue.size <= MAX_ACTIONS);
+    flushMotion();
 }
 
 
-/* TODO: Document
+/* Copies the slot out before publishing the new read count, which hands
+ * the slot back to the producer.
  */
 bool input_loadNextAction(struct GameAction *restrict pAction)
 {
-    if (_actionQueue.head >= _actionQueue.size)  // at the end of the queue
+    Uint32 readCount = SDL_GetAtomicU32(&_actionRing.readCount);
+
+    if (readCount == SDL_GetAtomicU32(&_actionRing.writeCount))  // ring is empty
     {
         return false;
     }
 
-    assert(_actionQueue.head < _actionQueue.size);
-    *pAction = _actionQueue.actions[_actionQueue.head++];
+    *pAction = _actionRing.actions[readCount & (RING_SIZE - 1)];
+    SDL_SetAtomicU32(&_actionRing.readCount, readCount + 1);
 
     return true;
 }
 
 
+/* Every hold-down command, plus mouse turning.
+ */
+bool input_drivesPlayer(enum UserCommand command)
+{
+    switch (command)
+    {
+    case CMD_MOVE_FORWARD:
+    case CMD_MOVE_BACKWARD:
+    case CMD_STRAFE_LEFT:
+    case CMD_STRAFE_RIGHT:
+    case CMD_TURN_LEFT:
+    case CMD_TURN_RIGHT:
+    case CMD_TURN_MOUSE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+
+/* Held keys report 1 when pressed and 0 when released; mouse motion
+ * adds up until the next step uses it.
+ */
+void input_applyAction(
+    struct InputState *restrict pState,
+    const struct GameAction *restrict pAction
+) {
+    if (pAction->command == CMD_TURN_MOUSE)
+        pState->mouseTurn += pAction->magnitude * MOUSE_TURN_SPEED;
+    else if (input_drivesPlayer(pAction->command))
+        pState->heldCommands[pAction->command] = pAction->magnitude != 0.0f;
+}
+
+
+/* Converts each pair of opposite commands into one signed fraction of
+ * top speed.
+ */
+void input_takePlayerInput(
+    struct InputState *restrict pState,
+    struct PlayerInput *restrict pInput
+) {
+    const bool *held = pState->heldCommands;
+
+    pInput->forward = (float)held[CMD_MOVE_FORWARD] - (float)held[CMD_MOVE_BACKWARD];
+    pInput->strafe  = (float)held[CMD_STRAFE_RIGHT] - (float)held[CMD_STRAFE_LEFT];
+    pInput->turn    = (float)held[CMD_TURN_RIGHT] - (float)held[CMD_TURN_LEFT];
+    pInput->look    = pState->mouseTurn;
+    pState->mouseTurn = 0.0f;
+}
+
+
 // === Static function definitions === //
 
-/* TODO: Document
+/* The counts are unsigned and only ever grow, so their difference is
+ * the number of unread actions even after they wrap around.
+ */
+static bool hasRoom(Uint32 count)
+{
+    Uint32 unread = SDL_GetAtomicU32(&_actionRing.writeCount)
+                    - SDL_GetAtomicU32(&_actionRing.readCount);
+    return RING_SIZE - unread >= count;
+}
+
+
+/* Flushes any pending motion first to keep the actions in order. The
+ * caller makes sure there's room for both.
+ */
+static void appendGameAction(enum UserCommand command, float magnitude)
+{
+    flushMotion();
+
+    assert(hasRoom(1));
+
+    Uint32 writeCount = SDL_GetAtomicU32(&_actionRing.writeCount);
+    _actionRing.actions[writeCount & (RING_SIZE - 1)] = (struct GameAction) {
+        .command   = command,
+        .magnitude = magnitude
+    };
+    SDL_SetAtomicU32(&_actionRing.writeCount, writeCount + 1);
+}
+
+
+/* Motion only ever adds up, so any run of the same motion in a row can
+ * be summed into a single action without losing anything. A 1000 Hz
+ * mouse then takes one slot per pump instead of one per report.
+ */
+static void appendMotion(enum UserCommand command, float magnitude)
+{
+    if (_actionRing.hasPendingMotion && _actionRing.pendingMotion.command == command)
+    {
+        _actionRing.pendingMotion.magnitude += magnitude;
+        return;
+    }
+
+    flushMotion();
+    _actionRing.pendingMotion = (struct GameAction) {
+        .command   = command,
+        .magnitude = magnitude
+    };
+    _actionRing.hasPendingMotion = true;
+}
+
+
+/* Clears the pending flag before appending, which would otherwise flush
+ * the same motion all over again.
+ */
+static void flushMotion(void)
+{
+    if (_actionRing.hasPendingMotion)
+    {
+        _actionRing.hasPendingMotion = false;
+        appendGameAction(
+            _actionRing.pendingMotion.command,
+            _actionRing.pendingMotion.magnitude
+        );
+    }
+}
+
+
+/* WASD moves and strafes, and the arrow keys move and turn.
  */
-void appendGameAction(enum UserCommand command, float magnitude)
+static enum UserCommand getHeldCommand(SDL_Keycode key)
 {
-    if (_actionQueue.size < MAX_ACTIONS)
+    switch (key)
     {
-        _actionQueue.actions[_actionQueue.size++] = (struct GameAction) {
-            .command   = command,
-            .magnitude = magnitude
-        };
+    case SDLK_W:
+    case SDLK_UP:
+        return CMD_MOVE_FORWARD;
+    case SDLK_S:
+    case SDLK_DOWN:
+        return CMD_MOVE_BACKWARD;
+    case SDLK_A:
+        return CMD_STRAFE_LEFT;
+    case SDLK_D:
+        return CMD_STRAFE_RIGHT;
+    case SDLK_LEFT:
+        return CMD_TURN_LEFT;
+    case SDLK_RIGHT:
+        return CMD_TURN_RIGHT;
+    default:
+        return CMD_UNKNOWN;
     }
 }
@@ -13,7 +13,9 @@
 #include <stdio.h>          // for console I/O
 #include <stdlib.h>         // for EXIT_FAILURE
 #include <SDL3/SDL_main.h>  // for SDL3 to handle the program entry point
+#include "bench.h"          // for running headless benchmarks
 #include "game.h"           // for handling the game context
+#include "options.h"        // for parsing the command line
 #include "defines.h"        // for the game title
 
 
@@ -23,17 +25,76 @@
  * as long as the arguments are valid. Invalid arguments will be ignored
  * after issuing a warning. The possible argument values, prefixed with
  * a dash, are:
- *   - windowed: Turn off fullscreen mode.
- *   - novsync : Turn off VSync.
+ *   - windowed     : Turn off fullscreen mode.
+ *   - novsync      : Turn off VSync, so frames go out as soon as they're
+ *                    drawn, unless capped with -fps.
+ *   - nodynres     : Always draw at the window's full resolution. By
+ *                    default, the view is drawn smaller and scaled up
+ *                    whenever it takes too long to keep up with the
+ *                    frame rate cap, or the display's refresh rate.
+ *   - fps <n>      : Draw at most n frames per second, from 1 to 1000.
+ *                    Defaults to no cap besides VSync.
+ *   - simd <kernel>: Force a ray casting kernel: auto, scalar, sse2,
+ *                    avx2, or fixed (Q16.16 fixed point). Defaults to
+ *                    auto, the best the CPU supports.
+ *   - threads <n>  : Render on n threads, from 1 to 64. Defaults to one
+ *                    per logical CPU core.
+ *   - size <w>[x<h>]: Generate a maze w cells wide and h tall, each from
+ *                    2 to 32768. Defaults to 32x32; h defaults to w.
+ *   - seed <n>     : Generate the same maze every time from seed n.
+ *                    Defaults to a different seed every run.
+ *   - load <file>  : Play the maze saved in file instead of generating
+ *                    one; overrides size and seed.
+ *   - save <file>  : Save the maze being played or benchmarked to file.
+ *   - nocheck      : Play a generated maze without first solving it to
+ *                    make sure the exit can be reached. Press H in game
+ *                    to see the way out on the minimap (Tab).
+ *   - endless      : Play a maze with no edges and no exit, generated in
+ *                    chunks as the player goes, from the seed if given.
+ *                    Overrides size, load, and save; not for benchmarks,
+ *                    recordings, or replays.
+ *   - indexed      : Draw in 256 colors picked to suit the textures,
+ *                    shading by table lookup, and expand them to full
+ *                    color only to put the view on screen.
+ *   - interlaced   : Cast only the even or the odd columns of each view,
+ *                    by turns, keeping the rest from the view before,
+ *                    unless the player turns too fast for that to pass
+ *                    unnoticed. Press I in game to switch it on or off.
+ *   - noskip       : Trace rays one cell at a time through the open
+ *                    space of a loaded maze, instead of skipping it with
+ *                    a distance field. For benchmarking the difference.
+ *   - resolution <w>x<h>: Open a window w by h pixels. Defaults to
+ *                    1280x720.
+ *   - bench <n>    : Render n frames at the resolution above with no
+ *                    window, print their timings as JSON, and exit.
+ *                    Uses seed 1 unless given a seed or a maze file.
+ *   - trace <file> : On exit, save the last frames' profiler zones to
+ *                    file as Chrome trace JSON. Press F3 in game to see
+ *                    the zones live.
+ *   - traceframes <n>: Save the last n frames with -trace, from 1 to
+ *                    1000. Defaults to 120.
+ *   - record <file>: Log every input to file, to be played back with
+ *                    -replay.
+ *   - replay <file>: Play back the input logged in file instead of taking
+ *                    the user's, in the maze it was recorded in. With
+ *                    -bench, renders one frame per simulation step of
+ *                    the log, up to n.
+ *   - capture <file>: Record the game to file as Y4M video at 30 frames
+ *                    per second, dropping frames the disk can't keep up
+ *                    with. Press F12 in game to save a screenshot,
+ *                    with or without it. Ignored by -bench.
  */
 int main(int argc, char **argv)
 {
+    struct GameOptions options;
+    options_parse(argc, argv, &options);
+
+    // Benchmark without a window if asked to
+    if (options.benchFrames > 0)
+        return bench_run(&options) ? 0 : EXIT_FAILURE;
+
     // Initialize the game
-    struct GameContext *restrict pGame = game_initContext(
-        argc,
-        argv,
-        GAME_TITLE
-    );
+    struct GameContext *restrict pGame = game_initContext(&options, GAME_TITLE);
 
     if (!pGame)
     {
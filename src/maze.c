@@ -0,0 +1,834 @@
+/**
+ * @file  maze.c
+ * @brief Implementation of the maze module.
+ *
+ * Defines the interface for the maze module and provides internal
+ * helper functions to carve a perfect maze with Eller's algorithm. It
+ * works one row at a time, tracking which cells of the current row are
+ * already connected through the rows above, so it needs only two arrays
+ * as wide as the maze and runs in time linear in the cells.
+ *
+ * Also reads and writes maze files. Loading maps the file into memory
+ * rather than reading it, which is done with the platform's own calls.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <string.h>    // for memset, memcmp, and memcpy
+#include <assert.h>    // for debugging assertions
+#include "maze.h"      // the header implemented here
+#include "rng.h"       // for the random choices
+#include "utils.h"     // for arenas
+#include "defines.h"   // for the cache line size
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>   // for file mapping
+#else
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#endif
+
+#define MAX_DISTANCE  UINT8_MAX  // distances saturate at what a byte can hold
+
+#define MAZE_FILE_VERSION    1           // bump on any change to the layout
+#define MAZE_FILE_ALIGNMENT  4096        // header size; puts walls on a page
+#define MAZE_FILE_MAGIC      "MAZECAST"  // first 8 bytes of every maze file
+#define BYTE_ORDER_MARK      0x0102030405060708ull  // reads back swapped
+                                                    // on the wrong endianness
+
+// Per-row bookkeeping for Eller's algorithm, indexed by column. Cells
+// in the same set form a ring, in column order, through these links.
+struct RowSets
+{
+    int *lefts;   // previous cell of the same set, wrapping around
+    int *rights;  // next cell of the same set, wrapping around
+};
+
+// Source of random bits, handed out one at a time
+struct CoinFlipper
+{
+    struct Rng rng;    // where the bits come from
+    uint64_t   bits;   // unused random bits
+    int        count;  // how many bits are left in `bits`
+};
+
+// Start of a maze file, padded with zeros up to MAZE_FILE_ALIGNMENT
+struct MazeFileHeader
+{
+    char     magic[8];       // MAZE_FILE_MAGIC, without the terminator
+    uint64_t byteOrderMark;  // BYTE_ORDER_MARK in the writer's byte order
+    uint32_t version;        // MAZE_FILE_VERSION
+    uint32_t wallsOffset;    // where the west plane starts in the file
+    uint64_t planeWords;     // 64-bit words in each plane
+    uint64_t seed;           // seed the maze was generated from
+    int32_t  width;          // cells per row
+    int32_t  height;         // number of rows
+    int32_t  exitX;          // column of the exit
+    int32_t  exitY;          // row of the exit
+};
+
+
+// === Static function prototypes === //
+
+// Allocates the per-row arrays from scratch, printing an error on failure
+static bool allocateRowSets(
+    struct RowSets *restrict pRows,
+    int width,
+    struct Arena *restrict pScratch
+);
+
+// Carves passages into a maze whose walls are all closed
+static void carveEller(
+    struct Maze *restrict pMaze,
+    struct RowSets *restrict pRows,
+    uint64_t seed
+);
+
+// Removes the wall at (x, y) from a wall plane
+static inline void openWall(uint64_t *plane, int tilesPerRow, int x, int y);
+
+// Returns a random true or false
+static inline bool flipCoin(struct CoinFlipper *pCoin);
+
+// Gets the arena space a distance field takes, padding and spare line included
+static size_t getFieldSize(size_t planeWords);
+
+// Checks the header of a maze file, printing why it's invalid if it is
+static bool isValidHeader(
+    const struct MazeFileHeader *restrict pHeader,
+    size_t fileSize,
+    const char *restrict path
+);
+
+// Checks that no wall is missing around the maze
+static bool hasClosedOuterWalls(const struct Maze *restrict pMaze);
+
+// Checks that no wall lies inside the 3x3 square centered on an inner cell
+static bool isOpenAround(const struct Maze *restrict pMaze, int x, int y);
+
+// Gets the smallest distance among the neighbors a pass has already been
+// through: those before the cell, in the direction the pass runs against
+static int getNearestDistance(
+    const uint8_t *restrict distances,
+    int tilesPerRow,
+    int x,
+    int y,
+    int direction
+);
+
+// Maps a whole file into memory, read-only, printing an error on failure
+static void *mapFile(const char *restrict path, size_t *restrict pSize);
+
+// Unmaps a file mapped by mapFile
+static void unmapFile(void *pData, size_t size);
+
+
+// === Interface function definitions === //
+
+/* Starts with every wall closed and lets the generator knock walls out.
+ */
+struct Maze *maze_create(
+    int width,
+    int height,
+    uint64_t seed,
+    struct Arena *restrict pArena,
+    struct Arena *restrict pScratch
+) {
+    struct Maze *pMaze = maze_createClosed(width, height, pArena);
+
+    if (!pMaze)
+        return NULL;
+
+    pMaze->seed = seed;
+
+    struct RowSets rows;
+    size_t scratchMark = arena_getMark(pScratch);
+
+    if (!allocateRowSets(&rows, width, pScratch))
+    {
+        arena_rewind(pScratch, scratchMark);
+        return NULL;
+    }
+
+    carveEller(pMaze, &rows, seed);
+    arena_rewind(pScratch, scratchMark);
+
+    return pMaze;
+}
+
+
+/* Both wall planes share one allocation, the north plane right after
+ * the west one, so a single base pointer and offset can reach either.
+ */
+struct Maze *maze_createClosed(int width, int height, struct Arena *restrict pArena)
+{
+    if (width < MAZE_MIN_SIZE || width > MAZE_MAX_SIZE
+        || height < MAZE_MIN_SIZE || height > MAZE_MAX_SIZE)
+    {
+        fprintf(stderr, "Error: Maze size %dx%d is out of range.\n", width, height);
+        return NULL;
+    }
+
+    struct Maze *pMaze = arena_alloc(pArena, sizeof(*pMaze));
+
+    if (!pMaze)
+    {
+        perror("Error: Unable to allocate a maze");
+        return NULL;
+    }
+
+    // One more line than cells in each direction, for the outer walls
+    pMaze->width       = width;
+    pMaze->height      = height;
+    pMaze->tilesPerRow = width / MAZE_TILE_SIZE + 1;
+    pMaze->planeWords  = (size_t)pMaze->tilesPerRow * (height / MAZE_TILE_SIZE + 1);
+    pMaze->exitX       = width - 1;
+    pMaze->exitY       = height - 1;
+    pMaze->seed        = 0;
+    pMaze->mapping     = NULL;
+    pMaze->mappingSize = 0;
+    pMaze->distances   = NULL;
+
+    size_t planeSize = pMaze->planeWords * sizeof(uint64_t);
+    pMaze->westWalls = arena_allocAligned(pArena, 2 * planeSize, CACHE_LINE_SIZE);
+
+    if (!pMaze->westWalls)
+    {
+        perror("Error: Unable to allocate the maze walls");
+        return NULL;
+    }
+
+    pMaze->northWalls = pMaze->westWalls + pMaze->planeWords;
+    memset(pMaze->westWalls, 0xFF, 2 * planeSize);
+
+    return pMaze;
+}
+
+
+/* Counts the worst-case padding before each block too.
+ */
+size_t maze_getArenaSize(int width, int height)
+{
+    size_t planeWords = (size_t)(width / MAZE_TILE_SIZE + 1)
+                        * (height / MAZE_TILE_SIZE + 1);
+
+    return sizeof(struct Maze) + ARENA_ALIGNMENT
+           + 2 * planeWords * sizeof(uint64_t) + CACHE_LINE_SIZE;
+}
+
+
+/* Reads just the header; whatever's wrong with the file is left for
+ * `maze_load` to report.
+ */
+size_t maze_getFileArenaSize(const char *restrict path)
+{
+    size_t size = sizeof(struct Maze) + ARENA_ALIGNMENT;
+    struct MazeFileHeader header;
+    FILE *pFile = fopen(path, "rb");
+
+    if (!pFile)
+        return size;
+
+    bool isRead = fread(&header, sizeof(header), 1, pFile) == 1;
+    fclose(pFile);
+
+    if (isRead
+        && header.width >= MAZE_MIN_SIZE && header.width <= MAZE_MAX_SIZE
+        && header.height >= MAZE_MIN_SIZE && header.height <= MAZE_MAX_SIZE)
+    {
+        size += getFieldSize(
+            (size_t)(header.width / MAZE_TILE_SIZE + 1)
+            * (header.height / MAZE_TILE_SIZE + 1)
+        );
+    }
+
+    return size;
+}
+
+
+/* Width alone sets how much scratch space generation takes.
+ */
+size_t maze_getScratchSize(int width)
+{
+    return 2 * ((size_t)width * sizeof(int) + ARENA_ALIGNMENT);
+}
+
+
+/* Validates everything the rest of the game takes for granted before
+ * pointing the wall planes into the mapping; in particular, rays rely on
+ * the outer walls to stop them, so a hole in those would send them off
+ * the end of the planes.
+ */
+struct Maze *maze_load(const char *restrict path, struct Arena *restrict pArena)
+{
+    size_t fileSize;
+    uint8_t *pFile = mapFile(path, &fileSize);
+
+    if (!pFile)
+        return NULL;
+
+    struct MazeFileHeader header;
+
+    if (fileSize < sizeof(header))
+    {
+        fprintf(stderr, "Error: %s is too short to be a maze file.\n", path);
+        unmapFile(pFile, fileSize);
+        return NULL;
+    }
+
+    memcpy(&header, pFile, sizeof(header));
+
+    if (!isValidHeader(&header, fileSize, path))
+    {
+        unmapFile(pFile, fileSize);
+        return NULL;
+    }
+
+    struct Maze *pMaze = arena_alloc(pArena, sizeof(*pMaze));
+
+    if (!pMaze)
+    {
+        perror("Error: Unable to allocate a maze");
+        unmapFile(pFile, fileSize);
+        return NULL;
+    }
+
+    pMaze->westWalls   = (uint64_t *)(pFile + header.wallsOffset);
+    pMaze->northWalls  = pMaze->westWalls + header.planeWords;
+    pMaze->planeWords  = header.planeWords;
+    pMaze->width       = header.width;
+    pMaze->height      = header.height;
+    pMaze->tilesPerRow = header.width / MAZE_TILE_SIZE + 1;
+    pMaze->exitX       = header.exitX;
+    pMaze->exitY       = header.exitY;
+    pMaze->seed        = header.seed;
+    pMaze->mapping     = pFile;
+    pMaze->mappingSize = fileSize;
+    pMaze->distances   = NULL;
+
+    if (!hasClosedOuterWalls(pMaze))
+    {
+        fprintf(stderr, "Error: The maze in %s has holes in its outer walls.\n", path);
+        maze_destroy(&pMaze);
+        return NULL;
+    }
+
+    return pMaze;
+}
+
+
+/* Writes the header, zero padding up to the walls, and both planes in
+ * one go, since they're contiguous in memory.
+ */
+bool maze_save(const struct Maze *restrict pMaze, const char *restrict path)
+{
+    assert(pMaze != NULL);
+
+    struct MazeFileHeader header = {
+        .byteOrderMark = BYTE_ORDER_MARK,
+        .version       = MAZE_FILE_VERSION,
+        .wallsOffset   = MAZE_FILE_ALIGNMENT,
+        .planeWords    = pMaze->planeWords,
+        .seed          = pMaze->seed,
+        .width         = pMaze->width,
+        .height        = pMaze->height,
+        .exitX         = pMaze->exitX,
+        .exitY         = pMaze->exitY
+    };
+    memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+
+    uint8_t page[MAZE_FILE_ALIGNMENT] = { 0 };
+    memcpy(page, &header, sizeof(header));
+
+    FILE *pFile = fopen(path, "wb");
+
+    if (!pFile)
+    {
+        fprintf(stderr, "Error: Unable to create %s: ", path);
+        perror(NULL);
+        return false;
+    }
+
+    size_t wordCount = 2 * pMaze->planeWords;
+    bool isWritten =
+        fwrite(page, sizeof(page), 1, pFile) == 1
+        && fwrite(pMaze->westWalls, sizeof(uint64_t), wordCount, pFile) == wordCount;
+
+    if (fclose(pFile) != 0 || !isWritten)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", path);
+        perror(NULL);
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Cells next to the outer walls always have a wall within one cell, so
+ * only the inner cells start out open. From there, it's the classic
+ * two-pass chessboard distance transform: each pass carries distances
+ * over from the four neighbors it has already visited, forward in
+ * reading order and then backward, which is exact for this metric.
+ *
+ * The field gets a spare cache line at the end, for SIMD kernels that
+ * read a whole 32-bit word at the last cell's byte. A field that turns
+ * out to be all zeros is rewound off the arena.
+ */
+bool maze_buildDistances(struct Maze *restrict pMaze, struct Arena *restrict pArena)
+{
+    assert(pMaze != NULL && pMaze->distances == NULL);
+
+    const int width = pMaze->width;
+    const int height = pMaze->height;
+    const int tilesPerRow = pMaze->tilesPerRow;
+    size_t fieldSize = pMaze->planeWords * CACHE_LINE_SIZE;
+    size_t mark = arena_getMark(pArena);
+    uint8_t *distances =
+        arena_allocAligned(pArena, fieldSize + CACHE_LINE_SIZE, CACHE_LINE_SIZE);
+
+    if (!distances)
+    {
+        perror("Error: Unable to allocate the maze's distance field");
+        return false;
+    }
+
+    memset(distances, 0, fieldSize + CACHE_LINE_SIZE);
+
+    bool hasOpenSpace = false;
+
+    for (int y = 1; y < height - 1; ++y)
+    {
+        for (int x = 1; x < width - 1; ++x)
+        {
+            if (isOpenAround(pMaze, x, y))
+            {
+                int nearest = getNearestDistance(distances, tilesPerRow, x, y, -1);
+                distances[maze_getDistanceIndex(tilesPerRow, x, y)] =
+                    (uint8_t)(nearest < MAX_DISTANCE ? nearest + 1 : MAX_DISTANCE);
+                hasOpenSpace = true;
+            }
+        }
+    }
+
+    if (!hasOpenSpace)
+    {
+        arena_rewind(pArena, mark);
+        return true;
+    }
+
+    for (int y = height - 2; y >= 1; --y)
+    {
+        for (int x = width - 2; x >= 1; --x)
+        {
+            uint8_t *pDistance = &distances[maze_getDistanceIndex(tilesPerRow, x, y)];
+            int nearest = getNearestDistance(distances, tilesPerRow, x, y, 1);
+
+            if (*pDistance > nearest + 1)
+                *pDistance = (uint8_t)(nearest + 1);
+        }
+    }
+
+    pMaze->distances = distances;
+    return true;
+}
+
+
+/* Everything else a maze has, generated walls and distance field
+ * included, lives in its arena, so only a loaded maze's file is left to
+ * release.
+ */
+void maze_destroy(struct Maze **ppMaze)
+{
+    assert(ppMaze != NULL);
+
+    if (*ppMaze)
+    {
+        if ((*ppMaze)->mapping)
+            unmapFile((*ppMaze)->mapping, (*ppMaze)->mappingSize);
+
+        *ppMaze = NULL;
+    }
+}
+
+
+// === Static function definitions === //
+
+
+/* Allocates everything, then checks once; the caller rewinds the
+ * scratch arena either way.
+ */
+static bool allocateRowSets(
+    struct RowSets *restrict pRows,
+    int width,
+    struct Arena *restrict pScratch
+) {
+    size_t size = (size_t)width * sizeof(int);
+
+    pRows->lefts  = arena_alloc(pScratch, size);
+    pRows->rights = arena_alloc(pScratch, size);
+
+    if (!pRows->lefts || !pRows->rights)
+    {
+        perror("Error: Unable to allocate memory to generate the maze");
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Eller's algorithm. Each cell of the current row belongs to a set of
+ * cells already connected to each other through the rows above. For
+ * each cell, from west to east:
+ *   1. Randomly join it to its east neighbor, unless they're already
+ *      in the same set.
+ *   2. Randomly close the passage down from it, unless it's the last
+ *      cell of its set still going down, in which case it must stay open.
+ * A cell with its passage down closed starts a set of its own in the
+ * next row. The last row joins every pair of neighbors in different
+ * sets, which leaves a single set, i.e., every cell reachable exactly
+ * one way.
+ *
+ * Each set is kept as a ring of its cells that either go down or have
+ * yet to be visited. Passages never cross, so sets never interleave and
+ * every ring stays in column order. That makes every question above a
+ * single comparison: a cell and its east neighbor share a set exactly
+ * when the neighbor is next in the ring, and a cell is the last one of
+ * its set going down exactly when it's alone in its ring.
+ */
+static void carveEller(
+    struct Maze *restrict pMaze,
+    struct RowSets *restrict pRows,
+    uint64_t seed
+) {
+    const int width = pMaze->width;
+    const int height = pMaze->height;
+    const int tilesPerRow = pMaze->tilesPerRow;
+    int *restrict lefts = pRows->lefts;
+    int *restrict rights = pRows->rights;
+    struct CoinFlipper coin = { .bits = 0, .count = 0 };
+    rng_seed(&coin.rng, seed);
+
+    // Every cell of the first row starts out alone
+    for (int x = 0; x < width; ++x)
+    {
+        lefts[x] = x;
+        rights[x] = x;
+    }
+
+    for (int y = 0; y < height - 1; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            // 1. Join the east neighbor's ring in after this cell
+            int east = x + 1;
+
+            if (east < width && rights[x] != east && flipCoin(&coin))
+            {
+                rights[lefts[east]] = rights[x];
+                lefts[rights[x]] = lefts[east];
+                rights[x] = east;
+                lefts[east] = x;
+                openWall(pMaze->westWalls, tilesPerRow, east, y);
+            }
+
+            // 2. Leave the ring, or keep the passage down open
+            if (rights[x] != x && flipCoin(&coin))
+            {
+                rights[lefts[x]] = rights[x];
+                lefts[rights[x]] = lefts[x];
+                rights[x] = x;
+                lefts[x] = x;
+            }
+            else
+            {
+                openWall(pMaze->northWalls, tilesPerRow, x, y + 1);
+            }
+        }
+    }
+
+    // The last row joins whatever is still apart
+    for (int x = 0; x < width - 1; ++x)
+    {
+        int east = x + 1;
+
+        if (rights[x] != east)
+        {
+            rights[lefts[east]] = rights[x];
+            lefts[rights[x]] = lefts[east];
+            rights[x] = east;
+            lefts[east] = x;
+            openWall(pMaze->westWalls, tilesPerRow, east, height - 1);
+        }
+    }
+}
+
+
+/* Clears the wall's bit in its tile.
+ */
+static inline void openWall(uint64_t *plane, int tilesPerRow, int x, int y)
+{
+    plane[(size_t)(y >> 3) * tilesPerRow + (x >> 3)] &=
+        ~( (uint64_t)1 << (((y & 7) << 3) | (x & 7)) );
+}
+
+
+/* Spends each 64-bit random number on 64 coin flips, since the
+ * generator needs a random bit per cell and little else.
+ */
+static inline bool flipCoin(struct CoinFlipper *pCoin)
+{
+    if (pCoin->count == 0)
+    {
+        pCoin->bits = rng_next(&pCoin->rng);
+        pCoin->count = 64;
+    }
+
+    bool isHeads = pCoin->bits & 1;
+    pCoin->bits >>= 1;
+    --pCoin->count;
+    return isHeads;
+}
+
+
+/* The field has a byte per cell, padded out to the tiles like the wall
+ * planes, or a cache line per tile; then comes the spare line, and the
+ * worst-case padding before it all.
+ */
+static size_t getFieldSize(size_t planeWords)
+{
+    return planeWords * CACHE_LINE_SIZE + 2 * CACHE_LINE_SIZE;
+}
+
+
+/* Rejects anything this build can't use in place: other formats, other
+ * versions, the other byte order, and sizes that don't add up to the
+ * file's own.
+ */
+static bool isValidHeader(
+    const struct MazeFileHeader *restrict pHeader,
+    size_t fileSize,
+    const char *restrict path
+) {
+    const char *problem = NULL;
+
+    if (memcmp(pHeader->magic, MAZE_FILE_MAGIC, sizeof(pHeader->magic)) != 0)
+        problem = "it isn't a maze file";
+    else if (pHeader->byteOrderMark != BYTE_ORDER_MARK)
+        problem = "it was saved with the opposite byte order";
+    else if (pHeader->version != MAZE_FILE_VERSION)
+        problem = "its version isn't supported";
+    else if (pHeader->width < MAZE_MIN_SIZE || pHeader->width > MAZE_MAX_SIZE
+             || pHeader->height < MAZE_MIN_SIZE || pHeader->height > MAZE_MAX_SIZE)
+        problem = "its size is out of range";
+    else if (pHeader->exitX < 0 || pHeader->exitX >= pHeader->width
+             || pHeader->exitY < 0 || pHeader->exitY >= pHeader->height)
+        problem = "its exit is outside the maze";
+    else if (pHeader->wallsOffset < sizeof(*pHeader)
+             || pHeader->wallsOffset % CACHE_LINE_SIZE != 0)
+        problem = "its walls are misplaced";
+    else if (pHeader->planeWords != (uint64_t)(pHeader->width / MAZE_TILE_SIZE + 1)
+                                    * (pHeader->height / MAZE_TILE_SIZE + 1))
+        problem = "its walls don't match its size";
+    else if (fileSize < pHeader->wallsOffset
+             || (fileSize - pHeader->wallsOffset) / sizeof(uint64_t) / 2
+                < pHeader->planeWords)
+        problem = "it's truncated";
+
+    if (problem)
+    {
+        fprintf(stderr, "Error: Unable to load %s: %s.\n", path, problem);
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Walks the four sides once; cheap next to anything else done with a
+ * maze, even one loaded in place.
+ */
+static bool hasClosedOuterWalls(const struct Maze *restrict pMaze)
+{
+    for (int x = 0; x < pMaze->width; ++x)
+    {
+        if (!maze_hasNorthWall(pMaze, x, 0) || !maze_hasNorthWall(pMaze, x, pMaze->height))
+            return false;
+    }
+
+    for (int y = 0; y < pMaze->height; ++y)
+    {
+        if (!maze_hasWestWall(pMaze, 0, y) || !maze_hasWestWall(pMaze, pMaze->width, y))
+            return false;
+    }
+
+    return true;
+}
+
+
+/* The square holds six walls across each axis: the west sides of its
+ * middle and right columns and the north sides of its middle and bottom
+ * rows, all three cells deep. Its own edges don't count.
+ */
+static bool isOpenAround(const struct Maze *restrict pMaze, int x, int y)
+{
+    for (int i = -1; i <= 1; ++i)
+    {
+        if (maze_hasWestWall(pMaze, x, y + i)
+            || maze_hasWestWall(pMaze, x + 1, y + i)
+            || maze_hasNorthWall(pMaze, x + i, y)
+            || maze_hasNorthWall(pMaze, x + i, y + 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/* Going forward, those are the cell to the west and the three above it;
+ * going backward, the cell to the east and the three below it.
+ */
+static int getNearestDistance(
+    const uint8_t *restrict distances,
+    int tilesPerRow,
+    int x,
+    int y,
+    int direction
+) {
+    int neighbors[4] = {
+        distances[maze_getDistanceIndex(tilesPerRow, x + direction, y)],
+        distances[maze_getDistanceIndex(tilesPerRow, x + direction, y + direction)],
+        distances[maze_getDistanceIndex(tilesPerRow, x, y + direction)],
+        distances[maze_getDistanceIndex(tilesPerRow, x - direction, y + direction)]
+    };
+    int nearest = neighbors[0];
+
+    for (int i = 1; i < 4; ++i)
+    {
+        if (neighbors[i] < nearest)
+            nearest = neighbors[i];
+    }
+
+    return nearest;
+}
+
+
+#ifdef _WIN32
+
+/* Closes both handles right away; the view keeps the mapping alive.
+ */
+static void *mapFile(const char *restrict path, size_t *restrict pSize)
+{
+    HANDLE file = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        fprintf(stderr, "Error: Unable to open %s (error %lu).\n", path, GetLastError());
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    void *pData = NULL;
+
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (mapping)
+        {
+            pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+
+    if (pData)
+        *pSize = (size_t)size.QuadPart;
+    else
+        fprintf(stderr, "Error: Unable to map %s (error %lu).\n", path, GetLastError());
+
+    CloseHandle(file);
+    return pData;
+}
+
+
+/* Windows only needs the start of the view.
+ */
+static void unmapFile(void *pData, size_t size)
+{
+    (void)size;
+    UnmapViewOfFile(pData);
+}
+
+#else
+
+/* Closes the file right away; the mapping stays valid without it.
+ */
+static void *mapFile(const char *restrict path, size_t *restrict pSize)
+{
+    int file = open(path, O_RDONLY);
+
+    if (file < 0)
+    {
+        fprintf(stderr, "Error: Unable to open %s: ", path);
+        perror(NULL);
+        return NULL;
+    }
+
+    struct stat status;
+    void *pData = NULL;
+
+    if (fstat(file, &status) != 0)
+    {
+        fprintf(stderr, "Error: Unable to read %s: ", path);
+        perror(NULL);
+    }
+    else if (status.st_size == 0)
+    {
+        fprintf(stderr, "Error: %s is empty.\n", path);
+    }
+    else
+    {
+        pData = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (pData != MAP_FAILED)
+        {
+            *pSize = (size_t)status.st_size;
+        }
+        else
+        {
+            fprintf(stderr, "Error: Unable to map %s: ", path);
+            perror(NULL);
+            pData = NULL;
+        }
+    }
+
+    close(file);
+    return pData;
+}
+
+
+/* Unmaps the whole file at once.
+ */
+static void unmapFile(void *pData, size_t size)
+{
+    munmap(pData, size);
+}
+
+#endif  // _WIN32
@@ -0,0 +1,700 @@
+/**
+ * @file  minimap.c
+ * @brief Implementation of the minimap module.
+ *
+ * Defines the interface for the minimap module and provides internal
+ * helper functions to mark cells explored, keep track of which chunks
+ * that changed, and draw a chunk's cells and walls into its texture.
+ *
+ * Each cell takes a few pixels, with walls drawn on the grid lines
+ * between cells. A chunk's texture covers the grid lines on both of its
+ * edges, so neighboring chunks overlap by a pixel, which they both draw
+ * the same.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>      // for console I/O
+#include <stdlib.h>     // for the C standard library
+#include <stdint.h>     // for fixed-width integer types
+#include <string.h>     // for memset
+#include <math.h>       // for floor
+#include <assert.h>     // for debugging assertions
+#include "minimap.h"    // the header implemented here
+#include "utils.h"      // for freeing pointers
+
+#define CELL_PIXELS    4    // pixels per cell, grid line included
+#define CHUNK_PIXELS   ( MINIMAP_CHUNK_CELLS * CELL_PIXELS + 1 )  // both edges
+#define SIGHT_CELLS    32   // most cells seen down a straight corridor
+#define CHUNK_TEXTURES 8    // textures in the pool; the map shows at most 4 chunks
+
+// Chunks it takes to cover a number of cells
+#define CHUNKS_SPANNING(cells) \
+    ( ((cells) + MINIMAP_CHUNK_CELLS - 1) / MINIMAP_CHUNK_CELLS )
+
+#define MAP_SIZE       256.0f  // pixels per side of the map on screen
+#define MAP_MARGIN     8.0f    // pixels between the map and the edges
+#define MARKER_SIZE    4.0f    // pixels per side of the player's marker
+#define MARKER_LENGTH  8.0f    // pixels the facing line reaches out
+
+#define FLOOR_COLOR    0xFF505050u  // explored floor
+#define WALL_COLOR     0xFFE0E0E0u  // walls next to explored cells
+
+// Whether a chunk has anything to draw, and whether it's behind the explored bits
+struct Chunk
+{
+    bool isTouched;  // has any cell it draws been explored?
+    bool isDirty;    // have its cells changed since it was drawn?
+};
+
+// A texture from the pool, and the chunk drawn into it
+struct ChunkTexture
+{
+    SDL_Texture *texture;  // created with the minimap
+    size_t       chunk;    // index of the chunk drawn; SIZE_MAX for none
+    uint32_t     lastUse;  // draw count when last on screen
+};
+
+struct Minimap
+{
+    uint64_t     *explored;     // one bit per cell, row by row
+    struct Chunk *chunks;       // row by row
+    uint32_t     *pixels;       // where a chunk is drawn before uploading
+    int           wordsPerRow;  // explored words per row of cells
+    int           chunksPerRow; // chunks per row of chunks
+    int           chunkRows;    // number of rows of chunks
+    int           width;        // cells per row of the maze
+    int           height;       // number of rows of the maze
+    int           xLast;        // column explored from last; -1 for none
+    int           yLast;        // row explored from last
+    uint8_t       pathSteps[MINIMAP_PATH_STEPS];  // steps of the path shown
+    int           pathCount;    // steps in the path; 0 for none
+    int           xPath;        // column the path starts from
+    int           yPath;        // row the path starts from
+    uint32_t      drawCount;    // number of times drawn, to age the textures
+    struct ChunkTexture textures[CHUNK_TEXTURES];  // shared by the chunks
+};
+
+// Steps to the next cell east, south, west, and north
+static const int _xSteps[4] = { 1, 0, -1,  0 };
+static const int _ySteps[4] = { 0, 1,  0, -1 };
+
+
+// === Static function prototypes === //
+
+// Checks whether a cell is explored; cells off the maze never are
+static bool isExplored(const struct Minimap *restrict pMinimap, int x, int y);
+
+// Marks a cell explored, along with every chunk that draws any of it
+static void markExplored(struct Minimap *restrict pMinimap, int x, int y);
+
+// Checks whether there's no wall on the given side of a cell
+static bool isOpen(const struct Maze *restrict pMaze, int x, int y, int direction);
+
+// Finds the texture holding a chunk, or else the one on screen longest ago
+static struct ChunkTexture *findTexture(struct Minimap *restrict pMinimap, size_t chunk);
+
+// Draws a chunk into the pixel buffer and uploads it to a texture
+static bool drawChunk(
+    struct Minimap *restrict pMinimap,
+    SDL_Texture *restrict pTexture,
+    const struct Maze *restrict pMaze,
+    int xChunk,
+    int yChunk
+);
+
+// Draws the walls and openings along the grid lines of a chunk
+static void drawGridLines(
+    const struct Minimap *restrict pMinimap,
+    const struct Maze *restrict pMaze,
+    int xFirst,
+    int yFirst
+);
+
+// Fills a rectangle of the pixel buffer with a color
+static void fillPixels(
+    uint32_t *restrict pixels,
+    int x,
+    int y,
+    int width,
+    int height,
+    uint32_t color
+);
+
+
+// === Interface function definitions === //
+
+/* Uses calloc for the explored bits, which gets fresh zeroed pages from
+ * the system for large blocks instead of writing zeros itself. The
+ * textures are all created up front, with nearest-pixel scaling so that
+ * walls stay sharp, and passed from chunk to chunk as the player moves,
+ * so that drawing never has to create one.
+ */
+struct Minimap *minimap_create(
+    const struct Maze *restrict pMaze,
+    SDL_Renderer *restrict pRenderer
+) {
+    assert(pMaze != NULL);
+    assert(pRenderer != NULL);
+
+    struct Minimap *pMinimap = malloc(sizeof(*pMinimap));
+
+    if (!pMinimap)
+    {
+        perror("Error: Unable to allocate a minimap");
+        return NULL;
+    }
+
+    pMinimap->width        = pMaze->width;
+    pMinimap->height       = pMaze->height;
+    pMinimap->wordsPerRow  = (pMaze->width + 63) / 64;
+    pMinimap->chunksPerRow = CHUNKS_SPANNING(pMaze->width);
+    pMinimap->chunkRows    = CHUNKS_SPANNING(pMaze->height);
+    pMinimap->xLast        = -1;
+    pMinimap->yLast        = -1;
+    pMinimap->pathCount    = 0;
+    pMinimap->xPath        = 0;
+    pMinimap->yPath        = 0;
+    pMinimap->drawCount    = 0;
+
+    for (int i = 0; i < CHUNK_TEXTURES; ++i)
+    {
+        pMinimap->textures[i].texture = NULL;
+        pMinimap->textures[i].chunk   = SIZE_MAX;
+        pMinimap->textures[i].lastUse = 0;
+    }
+
+    size_t chunkCount = (size_t)pMinimap->chunksPerRow * pMinimap->chunkRows;
+    pMinimap->explored = calloc(
+        (size_t)pMinimap->wordsPerRow * pMaze->height,
+        sizeof(*pMinimap->explored)
+    );
+    pMinimap->chunks = calloc(chunkCount, sizeof(*pMinimap->chunks));
+    pMinimap->pixels = malloc((size_t)CHUNK_PIXELS * CHUNK_PIXELS * sizeof(uint32_t));
+
+    if (!pMinimap->explored || !pMinimap->chunks || !pMinimap->pixels)
+    {
+        perror("Error: Unable to allocate a minimap");
+        minimap_destroy(&pMinimap);
+        return NULL;
+    }
+
+    for (int i = 0; i < CHUNK_TEXTURES; ++i)
+    {
+        SDL_Texture *pTexture = SDL_CreateTexture(
+            pRenderer,
+            SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STATIC,
+            CHUNK_PIXELS,
+            CHUNK_PIXELS
+        );
+
+        if (!pTexture)
+        {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_ERROR,
+                "Failed to create a texture for the minimap: %s.",
+                SDL_GetError()
+            );
+            minimap_destroy(&pMinimap);
+            return NULL;
+        }
+
+        SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(pTexture, SDL_SCALEMODE_NEAREST);
+        pMinimap->textures[i].texture = pTexture;
+    }
+
+    return pMinimap;
+}
+
+
+/* Looks down each of the four directions in turn, stopping at the first
+ * wall, which the outer walls guarantee within the maze.
+ */
+void minimap_explore(
+    struct Minimap *restrict pMinimap,
+    const struct Maze *restrict pMaze,
+    const struct PlayerPose *restrict pPose
+) {
+    int x = (int)pPose->xPos;
+    int y = (int)pPose->yPos;
+
+    if (x == pMinimap->xLast && y == pMinimap->yLast)
+        return;
+
+    pMinimap->xLast = x;
+    pMinimap->yLast = y;
+    markExplored(pMinimap, x, y);
+
+    for (int direction = 0; direction < 4; ++direction)
+    {
+        int xSeen = x;
+        int ySeen = y;
+
+        for (int i = 0; i < SIGHT_CELLS && isOpen(pMaze, xSeen, ySeen, direction); ++i)
+        {
+            xSeen += _xSteps[direction];
+            ySeen += _ySteps[direction];
+            markExplored(pMinimap, xSeen, ySeen);
+        }
+    }
+}
+
+
+/* Keeps its own copy of the steps, one byte each.
+ */
+void minimap_showPath(
+    struct Minimap *restrict pMinimap,
+    int x,
+    int y,
+    const enum SolverStep *restrict steps,
+    int count
+) {
+    assert(count >= 0 && count <= MINIMAP_PATH_STEPS);
+
+    for (int i = 0; i < count; ++i)
+        pMinimap->pathSteps[i] = (uint8_t)steps[i];
+
+    pMinimap->pathCount = count;
+    pMinimap->xPath = x;
+    pMinimap->yPath = y;
+}
+
+
+/* Moves whole words of explored bits, which the shift being a multiple
+ * of a chunk makes possible, and clears the ones that come in from off
+ * the maze. Every chunk gets drawn again, since they all changed.
+ */
+void minimap_shift(struct Minimap *restrict pMinimap, int xShift, int yShift)
+{
+    assert(xShift % MINIMAP_CHUNK_CELLS == 0);
+
+    int wordShift = xShift / 64;
+    int wordsPerRow = pMinimap->wordsPerRow;
+    int wordsKept = SDL_max(wordsPerRow - SDL_abs(wordShift), 0);
+    int rowsKept = SDL_max(pMinimap->height - SDL_abs(yShift), 0);
+    size_t rowSize = (size_t)wordsPerRow * sizeof(*pMinimap->explored);
+
+    // Move the rows first, then the words within each row
+    if (yShift != 0)
+    {
+        uint64_t *pFrom = pMinimap->explored + (size_t)SDL_max(-yShift, 0) * wordsPerRow;
+        uint64_t *pTo = pMinimap->explored + (size_t)SDL_max(yShift, 0) * wordsPerRow;
+        memmove(pTo, pFrom, rowsKept * rowSize);
+
+        size_t clearRow = yShift > 0 ? 0 : (size_t)rowsKept;
+        memset(
+            pMinimap->explored + clearRow * wordsPerRow,
+            0,
+            (size_t)(pMinimap->height - rowsKept) * rowSize
+        );
+    }
+
+    for (int y = 0; y < pMinimap->height && wordShift != 0; ++y)
+    {
+        uint64_t *pRow = pMinimap->explored + (size_t)y * wordsPerRow;
+        memmove(
+            pRow + SDL_max(wordShift, 0),
+            pRow + SDL_max(-wordShift, 0),
+            wordsKept * sizeof(*pRow)
+        );
+        memset(
+            pRow + (wordShift > 0 ? 0 : wordsKept),
+            0,
+            (size_t)(wordsPerRow - wordsKept) * sizeof(*pRow)
+        );
+    }
+
+    size_t chunkCount = (size_t)pMinimap->chunksPerRow * pMinimap->chunkRows;
+    for (size_t i = 0; i < chunkCount; ++i)
+    {
+        pMinimap->chunks[i].isTouched = true;
+        pMinimap->chunks[i].isDirty = true;
+    }
+
+    pMinimap->xLast = -1;
+    pMinimap->xPath += xShift;
+    pMinimap->yPath += yShift;
+}
+
+
+/* Keeps the player in the middle of the map, on whole pixels so that
+ * the chunks line up crisply, and clips the chunks to the map's square.
+ * Only the chunks that overlap the square are looked at, at most four,
+ * so the pool never takes back a texture already drawn this time.
+ */
+bool minimap_draw(
+    struct Minimap *restrict pMinimap,
+    SDL_Renderer *restrict pRenderer,
+    const struct Maze *restrict pMaze,
+    const struct PlayerPose *restrict pPose
+) {
+    int outputWidth, outputHeight;
+    if (!SDL_GetCurrentRenderOutputSize(pRenderer, &outputWidth, &outputHeight))
+        outputWidth = (int)(MAP_SIZE + 2 * MAP_MARGIN);
+
+    SDL_FRect frame = {
+        .x = outputWidth - MAP_SIZE - MAP_MARGIN,
+        .y = MAP_MARGIN,
+        .w = MAP_SIZE,
+        .h = MAP_SIZE
+    };
+    SDL_Rect clip = { (int)frame.x, (int)frame.y, (int)frame.w, (int)frame.h };
+
+    // Where the map's origin lands on screen
+    double xCenter = pPose->xPos * CELL_PIXELS;
+    double yCenter = pPose->yPos * CELL_PIXELS;
+    float xOrigin = (float)floor(frame.x + 0.5 * MAP_SIZE - xCenter);
+    float yOrigin = (float)floor(frame.y + 0.5 * MAP_SIZE - yCenter);
+
+    const double chunkSpan = MINIMAP_CHUNK_CELLS * CELL_PIXELS;
+    int xFirst = SDL_max(0, (int)floor((xCenter - 0.5 * MAP_SIZE) / chunkSpan));
+    int yFirst = SDL_max(0, (int)floor((yCenter - 0.5 * MAP_SIZE) / chunkSpan));
+    int xLast = SDL_min(
+        pMinimap->chunksPerRow - 1,
+        (int)floor((xCenter + 0.5 * MAP_SIZE) / chunkSpan)
+    );
+    int yLast = SDL_min(
+        pMinimap->chunkRows - 1,
+        (int)floor((yCenter + 0.5 * MAP_SIZE) / chunkSpan)
+    );
+
+    SDL_SetRenderDrawBlendMode(pRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(pRenderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(pRenderer, &frame);
+    SDL_SetRenderClipRect(pRenderer, &clip);
+
+    bool isDrawn = true;
+    ++pMinimap->drawCount;
+
+    for (int yChunk = yFirst; yChunk <= yLast; ++yChunk)
+    {
+        for (int xChunk = xFirst; xChunk <= xLast; ++xChunk)
+        {
+            size_t index = (size_t)yChunk * pMinimap->chunksPerRow + xChunk;
+            struct Chunk *pChunk = &pMinimap->chunks[index];
+
+            if (!pChunk->isTouched)
+                continue;  // nothing explored there yet
+
+            struct ChunkTexture *pTexture = findTexture(pMinimap, index);
+            pTexture->lastUse = pMinimap->drawCount;
+
+            if (pTexture->chunk != index)
+            {
+                pTexture->chunk = index;
+                pChunk->isDirty = true;  // holds some other chunk
+            }
+
+            if (pChunk->isDirty
+                && !drawChunk(pMinimap, pTexture->texture, pMaze, xChunk, yChunk))
+                isDrawn = false;
+
+            SDL_FRect target = {
+                .x = xOrigin + (float)(xChunk * chunkSpan),
+                .y = yOrigin + (float)(yChunk * chunkSpan),
+                .w = CHUNK_PIXELS,
+                .h = CHUNK_PIXELS
+            };
+            SDL_RenderTexture(pRenderer, pTexture->texture, NULL, &target);
+        }
+    }
+
+    // The path, from the middle of one cell to the next
+    if (pMinimap->pathCount > 0)
+    {
+        SDL_FPoint points[MINIMAP_PATH_STEPS + 1];
+        int x = pMinimap->xPath;
+        int y = pMinimap->yPath;
+
+        for (int i = 0; i <= pMinimap->pathCount; ++i)
+        {
+            points[i].x = xOrigin + (x + 0.5f) * CELL_PIXELS;
+            points[i].y = yOrigin + (y + 0.5f) * CELL_PIXELS;
+
+            if (i < pMinimap->pathCount)
+            {
+                x += _xSteps[pMinimap->pathSteps[i]];
+                y += _ySteps[pMinimap->pathSteps[i]];
+            }
+        }
+
+        SDL_SetRenderDrawColor(pRenderer, 255, 208, 64, 255);
+        SDL_RenderLines(pRenderer, points, pMinimap->pathCount + 1);
+    }
+
+    SDL_SetRenderClipRect(pRenderer, NULL);
+
+    // The player, and a line toward where they face
+    float xMarker = frame.x + 0.5f * MAP_SIZE;
+    float yMarker = frame.y + 0.5f * MAP_SIZE;
+    SDL_FRect marker = {
+        .x = xMarker - 0.5f * MARKER_SIZE,
+        .y = yMarker - 0.5f * MARKER_SIZE,
+        .w = MARKER_SIZE,
+        .h = MARKER_SIZE
+    };
+
+    SDL_SetRenderDrawColor(pRenderer, 255, 64, 64, 255);
+    SDL_RenderFillRect(pRenderer, &marker);
+    SDL_RenderLine(
+        pRenderer,
+        xMarker,
+        yMarker,
+        xMarker + MARKER_LENGTH * (float)pPose->xDir,
+        yMarker + MARKER_LENGTH * (float)pPose->yDir
+    );
+
+    return isDrawn;
+}
+
+
+/* Textures go before the rest, in case the renderer goes next.
+ */
+void minimap_destroy(struct Minimap **ppMinimap)
+{
+    assert(ppMinimap != NULL);
+
+    struct Minimap *pMinimap = *ppMinimap;
+    if (!pMinimap)
+        return;
+
+    for (int i = 0; i < CHUNK_TEXTURES; ++i)
+        SDL_DestroyTexture(pMinimap->textures[i].texture);
+
+    freeMemory((void **)&pMinimap->explored);
+    freeMemory((void **)&pMinimap->chunks);
+    freeMemory((void **)&pMinimap->pixels);
+    freeMemory((void **)ppMinimap);
+}
+
+
+// === Static function definitions === //
+
+/* Rows of cells start on a fresh word.
+ */
+static bool isExplored(const struct Minimap *restrict pMinimap, int x, int y)
+{
+    if ((unsigned)x >= (unsigned)pMinimap->width
+        || (unsigned)y >= (unsigned)pMinimap->height)
+        return false;
+
+    uint64_t word = pMinimap->explored[(size_t)y * pMinimap->wordsPerRow + (x >> 6)];
+    return (word >> (x & 63)) & 1;
+}
+
+
+/* A cell's chunk draws its floor, but the grid lines along its east and
+ * south sides, and the corner between them, can belong to the chunks to
+ * the east and south, which draw those lines too.
+ */
+static void markExplored(struct Minimap *restrict pMinimap, int x, int y)
+{
+    uint64_t *pWord = &pMinimap->explored[(size_t)y * pMinimap->wordsPerRow + (x >> 6)];
+    uint64_t bit = (uint64_t)1 << (x & 63);
+
+    if (*pWord & bit)
+        return;
+
+    *pWord |= bit;
+
+    int xChunk = x / MINIMAP_CHUNK_CELLS;
+    int yChunk = y / MINIMAP_CHUNK_CELLS;
+    int xNext = SDL_min((x + 1) / MINIMAP_CHUNK_CELLS, pMinimap->chunksPerRow - 1);
+    int yNext = SDL_min((y + 1) / MINIMAP_CHUNK_CELLS, pMinimap->chunkRows - 1);
+
+    for (int yDirty = yChunk; yDirty <= yNext; ++yDirty)
+    {
+        struct Chunk *row = &pMinimap->chunks[(size_t)yDirty * pMinimap->chunksPerRow];
+
+        for (int xDirty = xChunk; xDirty <= xNext; ++xDirty)
+        {
+            row[xDirty].isTouched = true;
+            row[xDirty].isDirty = true;
+        }
+    }
+}
+
+
+/* East and south are the west and north walls of the next cell over.
+ */
+static bool isOpen(const struct Maze *restrict pMaze, int x, int y, int direction)
+{
+    switch (direction)
+    {
+    case 0:
+        return !maze_hasWestWall(pMaze, x + 1, y);
+    case 1:
+        return !maze_hasNorthWall(pMaze, x, y + 1);
+    case 2:
+        return !maze_hasWestWall(pMaze, x, y);
+    default:
+        return !maze_hasNorthWall(pMaze, x, y);
+    }
+}
+
+
+/* The pool is small enough to search whole; ties go to the first
+ * texture, so unused ones get taken in order.
+ */
+static struct ChunkTexture *findTexture(struct Minimap *restrict pMinimap, size_t chunk)
+{
+    struct ChunkTexture *pOldest = &pMinimap->textures[0];
+
+    for (int i = 0; i < CHUNK_TEXTURES; ++i)
+    {
+        struct ChunkTexture *pTexture = &pMinimap->textures[i];
+
+        if (pTexture->chunk == chunk)
+            return pTexture;
+
+        if (pTexture->lastUse < pOldest->lastUse)
+            pOldest = pTexture;
+    }
+
+    return pOldest;
+}
+
+
+/* Explored cells get a floor, then the grid lines go over them, and the
+ * grid points left empty where open floor meets get filled in last.
+ */
+static bool drawChunk(
+    struct Minimap *restrict pMinimap,
+    SDL_Texture *restrict pTexture,
+    const struct Maze *restrict pMaze,
+    int xChunk,
+    int yChunk
+) {
+    struct Chunk *pChunk =
+        &pMinimap->chunks[(size_t)yChunk * pMinimap->chunksPerRow + xChunk];
+
+    const int xFirst = xChunk * MINIMAP_CHUNK_CELLS;
+    const int yFirst = yChunk * MINIMAP_CHUNK_CELLS;
+    uint32_t *pixels = pMinimap->pixels;
+
+    memset(pixels, 0, (size_t)CHUNK_PIXELS * CHUNK_PIXELS * sizeof(uint32_t));
+
+    for (int row = 0; row < MINIMAP_CHUNK_CELLS; ++row)
+    {
+        for (int column = 0; column < MINIMAP_CHUNK_CELLS; ++column)
+        {
+            if (isExplored(pMinimap, xFirst + column, yFirst + row))
+            {
+                fillPixels(
+                    pixels,
+                    column * CELL_PIXELS + 1,
+                    row * CELL_PIXELS + 1,
+                    CELL_PIXELS - 1,
+                    CELL_PIXELS - 1,
+                    FLOOR_COLOR
+                );
+            }
+        }
+    }
+
+    drawGridLines(pMinimap, pMaze, xFirst, yFirst);
+
+    for (int row = 0; row <= MINIMAP_CHUNK_CELLS; ++row)
+    {
+        for (int column = 0; column <= MINIMAP_CHUNK_CELLS; ++column)
+        {
+            int x = xFirst + column;
+            int y = yFirst + row;
+            uint32_t *pPoint =
+                &pixels[(row * CHUNK_PIXELS + column) * CELL_PIXELS];
+
+            if (*pPoint == 0
+                && ( isExplored(pMinimap, x, y)
+                     || isExplored(pMinimap, x - 1, y)
+                     || isExplored(pMinimap, x, y - 1)
+                     || isExplored(pMinimap, x - 1, y - 1) ))
+            {
+                *pPoint = FLOOR_COLOR;
+            }
+        }
+    }
+
+    int pitch = CHUNK_PIXELS * (int)sizeof(uint32_t);
+
+    if (!SDL_UpdateTexture(pTexture, NULL, pixels, pitch))
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to update the minimap: %s.",
+            SDL_GetError()
+        );
+        return false;
+    }
+
+    pChunk->isDirty = false;
+    return true;
+}
+
+
+/* A grid line shows once a cell on either side of it is explored: as a
+ * wall, grid points at both ends included, or else as an opening in the
+ * floor between the points. Lines past the maze's outer walls don't
+ * exist, which leaves the rest of the last chunks empty.
+ */
+static void drawGridLines(
+    const struct Minimap *restrict pMinimap,
+    const struct Maze *restrict pMaze,
+    int xFirst,
+    int yFirst
+) {
+    uint32_t *pixels = pMinimap->pixels;
+
+    for (int row = 0; row <= MINIMAP_CHUNK_CELLS; ++row)
+    {
+        for (int column = 0; column <= MINIMAP_CHUNK_CELLS; ++column)
+        {
+            int x = xFirst + column;
+            int y = yFirst + row;
+            int xPixel = column * CELL_PIXELS;
+            int yPixel = row * CELL_PIXELS;
+
+            // Along the west side of cell (x, y)
+            bool isWestSeen = row < MINIMAP_CHUNK_CELLS && y < pMaze->height
+                && x <= pMaze->width
+                && ( isExplored(pMinimap, x, y) || isExplored(pMinimap, x - 1, y) );
+
+            if (isWestSeen && maze_hasWestWall(pMaze, x, y))
+                fillPixels(pixels, xPixel, yPixel, 1, CELL_PIXELS + 1, WALL_COLOR);
+            else if (isWestSeen)
+                fillPixels(pixels, xPixel, yPixel + 1, 1, CELL_PIXELS - 1, FLOOR_COLOR);
+
+            // Along the north side of cell (x, y)
+            bool isNorthSeen = column < MINIMAP_CHUNK_CELLS && x < pMaze->width
+                && y <= pMaze->height
+                && ( isExplored(pMinimap, x, y) || isExplored(pMinimap, x, y - 1) );
+
+            if (isNorthSeen && maze_hasNorthWall(pMaze, x, y))
+                fillPixels(pixels, xPixel, yPixel, CELL_PIXELS + 1, 1, WALL_COLOR);
+            else if (isNorthSeen)
+                fillPixels(pixels, xPixel + 1, yPixel, CELL_PIXELS - 1, 1, FLOOR_COLOR);
+        }
+    }
+}
+
+
+/* The buffer is one chunk's worth of pixels, row by row.
+ */
+static void fillPixels(
+    uint32_t *restrict pixels,
+    int x,
+    int y,
+    int width,
+    int height,
+    uint32_t color
+) {
+    assert(x + width <= CHUNK_PIXELS && y + height <= CHUNK_PIXELS);
+
+    for (int row = y; row < y + height; ++row)
+    {
+        for (int column = x; column < x + width; ++column)
+            pixels[row * CHUNK_PIXELS + column] = color;
+    }
+}
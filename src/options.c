@@ -0,0 +1,406 @@
+/**
+ * @file  options.c
+ * @brief Implementation of the options module.
+ *
+ * Defines the interface for the options module and provides internal
+ * helper functions to recognize each command-line argument and read the
+ * value that follows it, if it takes one.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdlib.h>    // for strtol and strtoull
+#include <ctype.h>     // for checking digits
+#include <errno.h>     // for detecting overflow
+#include <string.h>    // for strcmp, strchr, and memcpy
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for logging
+#include "options.h"   // the header implemented here
+#include "maze.h"      // for the maze size limits
+#include "workers.h"   // for the maximum thread count
+
+
+// === Static function prototypes === //
+
+// Converts a kernel name into a kernel, or returns false if there's none
+static bool parseKernel(const char *name, enum RaycastKernel *pKernel);
+
+// Converts a whole string into an int within bounds, or returns false
+static bool parseInt(const char *text, int min, int max, int *pValue);
+
+// Converts "<w>" or "<w>x<h>" into a size within bounds, or returns false
+static bool parseSize(
+    const char *text,
+    int min,
+    int max,
+    int *restrict pWidth,
+    int *restrict pHeight
+);
+
+// Converts a whole string into an unsigned 64-bit int, or returns false
+static bool parseSeed(const char *text, uint64_t *pSeed);
+
+// Finds the option a file path argument sets, or returns NULL if none
+static const char **getPathOption(
+    struct GameOptions *restrict pOptions,
+    const char *arg
+);
+
+
+// === Interface function definitions === //
+
+/* Sets the defaults first and then walks the arguments once, skipping
+ * argv[0] (the program name). Arguments that take a value consume the
+ * next argument too.
+ */
+void options_parse(int argc, char **argv, struct GameOptions *restrict pOptions)
+{
+    assert(pOptions != NULL);
+
+    *pOptions = (struct GameOptions) {
+        .isWindowed    = false,
+        .isVsyncOff    = false,
+        .isDynResOff   = false,
+        .isSkipOff     = false,
+        .isCheckOff    = false,
+        .isEndless     = false,
+        .isIndexed     = false,
+        .isInterlaced  = false,
+        .raycastKernel = RAYCAST_AUTO,
+        .threadCount   = 0,
+        .mazeWidth     = DEFAULT_MAZE_SIZE,
+        .mazeHeight    = DEFAULT_MAZE_SIZE,
+        .hasSeed       = false,
+        .seed          = 0,
+        .loadPath      = NULL,
+        .savePath      = NULL,
+        .width         = DEFAULT_WINDOW_WIDTH,
+        .height        = DEFAULT_WINDOW_HEIGHT,
+        .benchFrames   = 0,
+        .fpsCap        = 0,
+        .tracePath     = NULL,
+        .traceFrames   = DEFAULT_TRACE_FRAMES,
+        .recordPath    = NULL,
+        .replayPath    = NULL,
+        .capturePath   = NULL
+    };
+
+    if (!argv)
+        return;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        const char **pPath;
+
+        if (strcmp(arg, "-windowed") == 0)
+        {
+            pOptions->isWindowed = true;
+        }
+        else if (strcmp(arg, "-novsync") == 0)
+        {
+            pOptions->isVsyncOff = true;
+        }
+        else if (strcmp(arg, "-nodynres") == 0)
+        {
+            pOptions->isDynResOff = true;
+        }
+        else if (strcmp(arg, "-noskip") == 0)
+        {
+            pOptions->isSkipOff = true;
+        }
+        else if (strcmp(arg, "-nocheck") == 0)
+        {
+            pOptions->isCheckOff = true;
+        }
+        else if (strcmp(arg, "-endless") == 0)
+        {
+            pOptions->isEndless = true;
+        }
+        else if (strcmp(arg, "-indexed") == 0)
+        {
+            pOptions->isIndexed = true;
+        }
+        else if (strcmp(arg, "-interlaced") == 0)
+        {
+            pOptions->isInterlaced = true;
+        }
+        else if (strcmp(arg, "-simd") == 0)
+        {
+            if (value && parseKernel(value, &pOptions->raycastKernel))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -simd; expected auto, scalar, sse2, avx2, or fixed."
+                );
+            }
+        }
+        else if (strcmp(arg, "-threads") == 0)
+        {
+            if (value && parseInt(value, 1, MAX_WORKER_THREADS, &pOptions->threadCount))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -threads; expected a count from 1 to %d.",
+                    MAX_WORKER_THREADS
+                );
+            }
+        }
+        else if (strcmp(arg, "-size") == 0)
+        {
+            if (value && parseSize(
+                    value,
+                    MAZE_MIN_SIZE,
+                    MAZE_MAX_SIZE,
+                    &pOptions->mazeWidth,
+                    &pOptions->mazeHeight
+                ))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -size; expected <w> or <w>x<h>, each from %d to %d.",
+                    MAZE_MIN_SIZE,
+                    MAZE_MAX_SIZE
+                );
+            }
+        }
+        else if (strcmp(arg, "-resolution") == 0)
+        {
+            if (value && parseSize(
+                    value,
+                    1,
+                    MAX_RESOLUTION,
+                    &pOptions->width,
+                    &pOptions->height
+                ))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -resolution; expected <w>x<h>, each from 1 to %d.",
+                    MAX_RESOLUTION
+                );
+            }
+        }
+        else if (strcmp(arg, "-bench") == 0)
+        {
+            if (value && parseInt(value, 1, MAX_BENCH_FRAMES, &pOptions->benchFrames))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -bench; expected a frame count from 1 to %d.",
+                    MAX_BENCH_FRAMES
+                );
+            }
+        }
+        else if (strcmp(arg, "-fps") == 0)
+        {
+            if (value && parseInt(value, 1, MAX_FPS_CAP, &pOptions->fpsCap))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -fps; expected a frame rate from 1 to %d.",
+                    MAX_FPS_CAP
+                );
+            }
+        }
+        else if (strcmp(arg, "-seed") == 0)
+        {
+            if (value && parseSeed(value, &pOptions->seed))
+            {
+                pOptions->hasSeed = true;
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -seed; expected a whole number from 0 to 2^64 - 1."
+                );
+            }
+        }
+        else if (strcmp(arg, "-traceframes") == 0)
+        {
+            if (value && parseInt(value, 1, MAX_TRACE_FRAMES, &pOptions->traceFrames))
+            {
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring -traceframes; expected a frame count from 1 to %d.",
+                    MAX_TRACE_FRAMES
+                );
+            }
+        }
+        else if ((pPath = getPathOption(pOptions, arg)) != NULL)
+        {
+            if (value)
+            {
+                *pPath = value;
+                ++i;  // consumed the value
+            }
+            else
+            {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Ignoring %s; expected a file path.",
+                    arg
+                );
+            }
+        }
+        else
+        {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION,
+                "Ignoring unknown argument \"%s\".",
+                arg
+            );
+        }
+    }
+}
+
+
+// === Static function definitions === //
+
+/* Compares against the names the raycast module gives its kernels, so
+ * the two never get out of sync.
+ */
+static bool parseKernel(const char *name, enum RaycastKernel *pKernel)
+{
+    for (int kernel = 0; kernel < NUM_RAYCAST_KERNELS; ++kernel)
+    {
+        if (strcmp(name, raycast_getKernelName(kernel)) == 0)
+        {
+            *pKernel = kernel;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/* Rejects empty strings, trailing junk, and anything out of bounds.
+ */
+static bool parseInt(const char *text, int min, int max, int *pValue)
+{
+    char *pEnd;
+    long value = strtol(text, &pEnd, 10);
+
+    if (pEnd == text || *pEnd != '\0' || value < min || value > max)
+        return false;
+
+    *pValue = (int)value;
+    return true;
+}
+
+
+/* A lone number gives a square. Leaves the size alone unless both sides
+ * parse.
+ */
+static bool parseSize(
+    const char *text,
+    int min,
+    int max,
+    int *restrict pWidth,
+    int *restrict pHeight
+) {
+    char widthText[16];
+    const char *pSeparator = strchr(text, 'x');
+    size_t widthLength = pSeparator ? (size_t)(pSeparator - text) : strlen(text);
+
+    if (widthLength >= sizeof(widthText))
+        return false;
+
+    memcpy(widthText, text, widthLength);
+    widthText[widthLength] = '\0';
+
+    int width, height;
+    if (!parseInt(widthText, min, max, &width))
+        return false;
+
+    if (!pSeparator)
+        height = width;
+    else if (!parseInt(pSeparator + 1, min, max, &height))
+        return false;
+
+    *pWidth = width;
+    *pHeight = height;
+    return true;
+}
+
+
+/* Takes decimal or, with a 0x prefix, hexadecimal, so a leading zero
+ * doesn't make it octal the way base 0 would. The digits have to start
+ * right away, since strtoull would skip leading whitespace and quietly
+ * wrap negative numbers around.
+ */
+static bool parseSeed(const char *text, uint64_t *pSeed)
+{
+    bool isHex = text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+    const char *digits = isHex ? text + 2 : text;
+
+    if (isHex ? !isxdigit((unsigned char)digits[0]) : !isdigit((unsigned char)digits[0]))
+        return false;
+
+    char *pEnd;
+    errno = 0;
+    unsigned long long value = strtoull(digits, &pEnd, isHex ? 16 : 10);
+
+    if (*pEnd != '\0' || errno == ERANGE)
+        return false;
+
+    *pSeed = (uint64_t)value;
+    return true;
+}
+
+
+/* Every file path argument takes its value as is; the modules that open
+ * the files report any problems with them.
+ */
+static const char **getPathOption(
+    struct GameOptions *restrict pOptions,
+    const char *arg
+) {
+    if (strcmp(arg, "-load") == 0)
+        return &pOptions->loadPath;
+    if (strcmp(arg, "-save") == 0)
+        return &pOptions->savePath;
+    if (strcmp(arg, "-trace") == 0)
+        return &pOptions->tracePath;
+    if (strcmp(arg, "-record") == 0)
+        return &pOptions->recordPath;
+    if (strcmp(arg, "-replay") == 0)
+        return &pOptions->replayPath;
+    if (strcmp(arg, "-capture") == 0)
+        return &pOptions->capturePath;
+
+    return NULL;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file  palette.c
+ * @brief Implementation of the palette module.
+ *
+ * Defines the interface for the palette module and provides internal
+ * helper functions to split the colors of the textures into boxes by
+ * median cut, one box per palette color, and to measure how far apart
+ * two colors look.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>    // for console I/O
+#include <stdlib.h>   // for qsort and the C standard library
+#include <assert.h>   // for debugging assertions
+#include "palette.h"  // the header implemented here
+
+#define SAMPLE_LEVELS   8   // brightnesses each texel is sampled at
+#define MAX_CHANNEL     3   // red, green, and blue
+
+// Signature shared by all the kernels
+typedef void (*ExpandRowFunction)(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+);
+
+// A run of the sampled colors that becomes one palette color
+struct ColorBox
+{
+    int first;    // index of its first color
+    int count;    // number of colors in it
+    int channel;  // channel its colors spread out the most along
+    int range;    // how far they spread along it; 0 if it can't be cut
+};
+
+// The kernel in use; scalar until told otherwise
+static ExpandRowFunction _expandRow = palette_expandRowScalar;
+
+
+// === Static function prototypes === //
+
+// Gets one channel of a color: 0 for red, 1 for green, and 2 for blue
+static inline int getChannel(uint32_t color, int channel);
+
+// Measures which channel a box's colors spread out the most along, and how far
+static void measureBox(const uint32_t *restrict colors, struct ColorBox *restrict pBox);
+
+// Averages the colors in a box into one opaque color
+static uint32_t averageBox(const uint32_t *restrict colors, const struct ColorBox *pBox);
+
+// Orders colors by red, green, or blue, for qsort
+static int compareRed(const void *pLeft, const void *pRight);
+static int compareGreen(const void *pLeft, const void *pRight);
+static int compareBlue(const void *pLeft, const void *pRight);
+
+// Measures how different two colors look, weighting green the most
+static inline int getDistance(uint32_t left, uint32_t right);
+
+
+// === Interface function definitions === //
+
+/* Just the palette itself; the colors are sampled into the heap.
+ */
+size_t palette_getArenaSize(void)
+{
+    return sizeof(struct Palette) + ARENA_ALIGNMENT;
+}
+
+
+/* Splits the sampled colors by median cut: the box whose colors spread
+ * out the farthest along any one channel is sorted along it and cut in
+ * half, until there's a box for every color but the clear one. Shading
+ * each color to each light level then takes a search of the palette.
+ */
+struct Palette *palette_create(
+    const struct Texture *const *textures,
+    int textureCount,
+    struct Arena *restrict pArena
+) {
+    struct Palette *pPalette = arena_alloc(pArena, sizeof(*pPalette));
+    size_t sampleCapacity =
+        (size_t)textureCount * TEXTURE_SIZE * TEXTURE_SIZE * SAMPLE_LEVELS;
+    uint32_t *samples = malloc(sampleCapacity * sizeof(*samples));
+
+    if (!pPalette || !samples)
+    {
+        perror("Error: Unable to allocate a palette");
+        freeMemory((void **)&samples);
+        return NULL;
+    }
+
+    // Sample every opaque texel at evenly spaced brightnesses
+    int sampleCount = 0;
+
+    for (int i = 0; i < textureCount; ++i)
+    {
+        const uint32_t *texels = textures[i]->levels[0];
+        int texelCount = textures[i]->size * textures[i]->size;
+
+        for (int j = 0; j < texelCount; ++j)
+        {
+            if (texels[j] < 0x80000000u)
+                continue;  // clear
+
+            for (int level = 1; level <= SAMPLE_LEVELS; ++level)
+            {
+                uint32_t shade = (uint32_t)(level * 256 / SAMPLE_LEVELS);
+                samples[sampleCount++] = texture_shadeColor(texels[j], shade);
+            }
+        }
+    }
+
+    static int (*const compares[MAX_CHANNEL])(const void *, const void *) = {
+        compareRed, compareGreen, compareBlue
+    };
+    struct ColorBox boxes[PALETTE_SIZE - 1] = { { .first = 0, .count = sampleCount } };
+    int boxCount = sampleCount > 0 ? 1 : 0;
+
+    if (boxCount > 0)
+        measureBox(samples, &boxes[0]);
+
+    while (boxCount < PALETTE_SIZE - 1)
+    {
+        int widest = -1;
+        int widestRange = 0;
+
+        for (int i = 0; i < boxCount; ++i)
+        {
+            if (boxes[i].range > widestRange)
+            {
+                widest = i;
+                widestRange = boxes[i].range;
+            }
+        }
+
+        if (widest < 0)
+            break;  // every box is a single color
+
+        struct ColorBox *pBox = &boxes[widest];
+        qsort(
+            samples + pBox->first,
+            (size_t)pBox->count,
+            sizeof(*samples),
+            compares[pBox->channel]
+        );
+
+        int half = pBox->count / 2;
+        boxes[boxCount] = (struct ColorBox) {
+            .first = pBox->first + half,
+            .count = pBox->count - half
+        };
+        pBox->count = half;
+        measureBox(samples, pBox);
+        measureBox(samples, &boxes[boxCount++]);
+    }
+
+    pPalette->colors[PALETTE_CLEAR] = 0;
+
+    for (int i = 1; i < PALETTE_SIZE; ++i)
+    {
+        pPalette->colors[i] = i <= boxCount
+            ? averageBox(samples, &boxes[i - 1])
+            : 0xFF000000u;  // black, for textures with fewer colors
+    }
+
+    freeMemory((void **)&samples);
+
+    for (int level = 0; level < PALETTE_LIGHT_LEVELS; ++level)
+    {
+        uint32_t shade = (uint32_t)((level + 1) * 256 / PALETTE_LIGHT_LEVELS);
+        pPalette->shades[level][PALETTE_CLEAR] = PALETTE_CLEAR;
+
+        for (int i = 1; i < PALETTE_SIZE; ++i)
+        {
+            uint32_t shaded = texture_shadeColor(pPalette->colors[i], shade);
+            pPalette->shades[level][i] = palette_findNearest(pPalette, shaded);
+        }
+    }
+
+    return pPalette;
+}
+
+
+/* A plain search through every color but the clear one; it only runs
+ * while building palettes and indexed textures.
+ */
+uint8_t palette_findNearest(const struct Palette *restrict pPalette, uint32_t color)
+{
+    int nearest = 1;
+    int nearestDistance = getDistance(color, pPalette->colors[1]);
+
+    for (int i = 2; i < PALETTE_SIZE && nearestDistance > 0; ++i)
+    {
+        int distance = getDistance(color, pPalette->colors[i]);
+
+        if (distance < nearestDistance)
+        {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+
+    return (uint8_t)nearest;
+}
+
+
+/* Trusts the ray casting module to have checked the CPU already.
+ */
+void palette_selectKernel(enum RaycastKernel kernel)
+{
+    assert(kernel != RAYCAST_AUTO);
+
+    switch (kernel)
+    {
+#ifdef MAZECAST_X86_SIMD
+    case RAYCAST_AVX2:
+        _expandRow = palette_expandRowAVX2;
+        break;
+    case RAYCAST_SSE2:
+        _expandRow = palette_expandRowSSE2;
+        break;
+#endif
+    default:
+        _expandRow = palette_expandRowScalar;
+        break;
+    }
+}
+
+
+/* Forwards the row to whichever kernel was last selected.
+ */
+void palette_expandRow(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+) {
+    assert(count >= 0);
+    _expandRow(indices, pixels, count, colors);
+}
+
+
+/* Four at a time, so the compiler can keep a few lookups in flight.
+ */
+void palette_expandRowScalar(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+) {
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        pixels[i]     = colors[indices[i]];
+        pixels[i + 1] = colors[indices[i + 1]];
+        pixels[i + 2] = colors[indices[i + 2]];
+        pixels[i + 3] = colors[indices[i + 3]];
+    }
+
+    for (; i < count; ++i)
+        pixels[i] = colors[indices[i]];
+}
+
+
+// === Static function definitions === //
+
+/* Channels are counted from the most significant color byte down.
+ */
+static inline int getChannel(uint32_t color, int channel)
+{
+    return (int)(color >> (16 - 8 * channel) & 0xFFu);
+}
+
+
+/* Ranges of 0 mean the box is a single color and can't be cut.
+ */
+static void measureBox(const uint32_t *restrict colors, struct ColorBox *restrict pBox)
+{
+    int lows[MAX_CHANNEL] = { 255, 255, 255 };
+    int highs[MAX_CHANNEL] = { 0, 0, 0 };
+
+    for (int i = pBox->first; i < pBox->first + pBox->count; ++i)
+    {
+        for (int channel = 0; channel < MAX_CHANNEL; ++channel)
+        {
+            int value = getChannel(colors[i], channel);
+            lows[channel] = value < lows[channel] ? value : lows[channel];
+            highs[channel] = value > highs[channel] ? value : highs[channel];
+        }
+    }
+
+    int widest = 0;
+
+    for (int channel = 1; channel < MAX_CHANNEL; ++channel)
+    {
+        if (highs[channel] - lows[channel] > highs[widest] - lows[widest])
+            widest = channel;
+    }
+
+    pBox->channel = widest;
+    pBox->range = pBox->count > 1 ? highs[widest] - lows[widest] : 0;
+}
+
+
+/* Rounds each channel's mean to the nearest whole value.
+ */
+static uint32_t averageBox(const uint32_t *restrict colors, const struct ColorBox *pBox)
+{
+    uint64_t sums[MAX_CHANNEL] = { 0 };
+
+    for (int i = pBox->first; i < pBox->first + pBox->count; ++i)
+    {
+        for (int channel = 0; channel < MAX_CHANNEL; ++channel)
+            sums[channel] += (uint64_t)getChannel(colors[i], channel);
+    }
+
+    uint32_t color = 0xFF000000u;
+
+    for (int channel = 0; channel < MAX_CHANNEL; ++channel)
+    {
+        uint32_t mean = (uint32_t)((sums[channel] + pBox->count / 2) / pBox->count);
+        color |= mean << (16 - 8 * channel);
+    }
+
+    return color;
+}
+
+
+/* Each comparison orders by one channel only.
+ */
+static int compareRed(const void *pLeft, const void *pRight)
+{
+    return getChannel(*(const uint32_t *)pLeft, 0)
+           - getChannel(*(const uint32_t *)pRight, 0);
+}
+
+
+static int compareGreen(const void *pLeft, const void *pRight)
+{
+    return getChannel(*(const uint32_t *)pLeft, 1)
+           - getChannel(*(const uint32_t *)pRight, 1);
+}
+
+
+static int compareBlue(const void *pLeft, const void *pRight)
+{
+    return getChannel(*(const uint32_t *)pLeft, 2)
+           - getChannel(*(const uint32_t *)pRight, 2);
+}
+
+
+/* Squared differences, weighted 2:4:3 for red, green, and blue, which is
+ * about how much each one stands out to the eye.
+ */
+static inline int getDistance(uint32_t left, uint32_t right)
+{
+    static const int weights[MAX_CHANNEL] = { 2, 4, 3 };
+    int distance = 0;
+
+    for (int channel = 0; channel < MAX_CHANNEL; ++channel)
+    {
+        int difference = getChannel(left, channel) - getChannel(right, channel);
+        distance += weights[channel] * difference * difference;
+    }
+
+    return distance;
+}
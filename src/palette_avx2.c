@@ -0,0 +1,43 @@
+/**
+ * @file  palette_avx2.c
+ * @brief AVX2 expansion kernel for the palette module.
+ *
+ * Expands eight indices at a time, reading their colors with a single
+ * gather.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <immintrin.h>  // for AVX2 intrinsics
+#include "palette.h"    // the header implemented here
+
+#define LANES  8  // indices expanded per iteration
+
+
+// === Interface function definitions === //
+
+/* Widens eight indices straight from memory to eight 32-bit lanes, which
+ * are then the gather's offsets into the colors. Whatever's left over
+ * goes to the scalar kernel.
+ */
+void palette_expandRowAVX2(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+) {
+    const int *table = (const int *)colors;
+    int i = 0;
+
+    for (; i + LANES <= count; i += LANES)
+    {
+        __m128i packed = _mm_loadl_epi64((const __m128i *)(indices + i));
+        __m256i offsets = _mm256_cvtepu8_epi32(packed);
+        __m256i expanded = _mm256_i32gather_epi32(table, offsets, 4);
+
+        _mm256_storeu_si256((__m256i *)(pixels + i), expanded);
+    }
+
+    palette_expandRowScalar(indices + i, pixels + i, count - i, colors);
+}
@@ -0,0 +1,43 @@
+/**
+ * @file  palette_sse2.c
+ * @brief SSE2 expansion kernel for the palette module.
+ *
+ * Expands four indices at a time. SSE2 has no gather, so the colors are
+ * still read one at a time, but they go out four to a store.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <emmintrin.h>  // for SSE2 intrinsics
+#include "palette.h"    // the header implemented here
+
+#define LANES  4  // indices expanded per iteration
+
+
+// === Interface function definitions === //
+
+/* Whatever's left over after the last whole vector goes to the scalar
+ * kernel.
+ */
+void palette_expandRowSSE2(
+    const uint8_t *restrict indices,
+    uint32_t *restrict pixels,
+    int count,
+    const uint32_t *restrict colors
+) {
+    int i = 0;
+
+    for (; i + LANES <= count; i += LANES)
+    {
+        __m128i expanded = _mm_setr_epi32(
+            (int)colors[indices[i]],
+            (int)colors[indices[i + 1]],
+            (int)colors[indices[i + 2]],
+            (int)colors[indices[i + 3]]
+        );
+        _mm_storeu_si128((__m128i *)(pixels + i), expanded);
+    }
+
+    palette_expandRowScalar(indices + i, pixels + i, count - i, colors);
+}
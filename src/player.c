@@ -3,8 +3,8 @@
  * @brief Implementation of the player module.
  *
  * Defines the interface for the player module and provides internal
- * helper functions and data structures to initialize, update, and
- * delete the player state.
+ * helper functions and data structures to initialize and update the
+ * player state.
  *
  * @author Joseph Borjon
  * @date   2024-12-31
@@ -12,8 +12,15 @@
 
 #include <stdio.h>   // for console I/O
 #include <stdlib.h>  // for the C standard library
+#include <math.h>    // for sqrt, sin, cos, floor, and ceil
 #include "player.h"  // the header implemented here
-#include "utils.h"   // for freeing pointers
+#include "utils.h"   // for arenas
+
+#define WALK_SPEED     3.0   // cells per second at full input
+#define TURN_SPEED     2.5   // radians per second at full input
+#define PLAYER_RADIUS  0.3   // cells; leaves room to turn in a corridor
+#define MAX_SLIDES     4     // contacts handled per move, enough for a corner
+#define CONTACT_SKIN   1e-9  // cells kept between the player and a wall it hits
 
 struct Player
 {
@@ -23,22 +30,79 @@ struct Player
     double yDir;    // player's facing direction in y
     double xVel;    // how much to move in x
     double yVel;    // how much to move in y
-    double radius;  // half width and height in game units
+    double radius;  // radius of the circle it collides as, in cells
+};
+
+// Where a moving circle first touches a wall
+struct Contact
+{
+    double time;     // fraction of the move made before touching, from 0 to 1
+    double xNormal;  // x-component of the unit normal out of the wall
+    double yNormal;  // y-component of the unit normal out of the wall
 };
 
 
+// === Static function prototypes === //
+
+// Moves the player's circle as far as the walls allow, sliding along them
+static void moveAndSlide(
+    struct Player *restrict pPlayer,
+    const struct Maze *restrict pMaze,
+    double xMove,
+    double yMove
+);
+
+// Finds the first wall a circle touches along a move, checking only the
+// walls within reach of it; returns false if it touches none
+static bool findFirstContact(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    double xMove,
+    double yMove,
+    double radius,
+    struct Contact *restrict pContact
+);
+
+// Checks a move against the face of one wall, seen along its normal axis u
+static void sweepAgainstFace(
+    double uPos,
+    double vPos,
+    double uMove,
+    double vMove,
+    double radius,
+    double uWall,
+    double vWall,
+    bool isVertical,
+    struct Contact *restrict pContact
+);
+
+// Checks a move against the round end of a wall at a grid corner
+static void sweepAgainstPost(
+    double xPos,
+    double yPos,
+    double xMove,
+    double yMove,
+    double radius,
+    double xPost,
+    double yPost,
+    struct Contact *restrict pContact
+);
+
+
 // === Interface function definitions === //
 
 /* Allocates and initializes the data structure and additional data
  * required for a player.
  */
 struct Player *player_init(
+    struct Arena *restrict pArena,
     double startingXPos,
     double startingYPos,
     double startingXDir,
     double startingYDir
 ) {
-    struct Player *pPlayer = malloc(sizeof(*pPlayer));
+    struct Player *pPlayer = arena_alloc(pArena, sizeof(*pPlayer));
 
     if (!pPlayer)
     {
@@ -52,24 +116,308 @@ struct Player *player_init(
     pPlayer->yDir   = startingYDir;
     pPlayer->xVel   = 0.0;
     pPlayer->yVel   = 0.0;
-    pPlayer->radius = 0.4;
+    pPlayer->radius = PLAYER_RADIUS;
 
     return pPlayer;
 }
 
 
-/* Updates the player state based on game actions, a.k.a. events.
+/* Cell (0, 0) is a corner, so at least one of the passages east or
+ * south must be open; faces the east one if it is.
  */
-void player_update(struct Player *restrict pPlayer)
-{
-    // TODO: Update player state here
+struct Player *player_initAtStart(
+    struct Arena *restrict pArena,
+    const struct Maze *restrict pMaze
+) {
+    if (!maze_hasWestWall(pMaze, 1, 0))
+        return player_init(pArena, 0.5, 0.5, 1.0, 0.0);
+    else
+        return player_init(pArena, 0.5, 0.5, 0.0, 1.0);
 }
 
 
-/* Deallocates every bit of memory allocated for the player and
- * nullifies all pointers to that memory.
+/* Turns first, then walks along the new heading, sliding along any
+ * walls in the way. Walking never changes the facing direction, and
+ * the same input from the same state always ends up in the same place.
  */
-void player_destroy(struct Player *restrict *ppPlayer)
+void player_update(
+    struct Player *restrict pPlayer,
+    const struct PlayerInput *restrict pInput,
+    const struct Maze *restrict pMaze,
+    double seconds
+) {
+    // Rotate the facing direction, renormalizing to stop any drift
+    double angle = pInput->turn * TURN_SPEED * seconds + pInput->look;
+    double cosAngle = cos(angle);
+    double sinAngle = sin(angle);
+    double xDir = pPlayer->xDir * cosAngle - pPlayer->yDir * sinAngle;
+    double yDir = pPlayer->xDir * sinAngle + pPlayer->yDir * cosAngle;
+    double length = sqrt(xDir * xDir + yDir * yDir);
+    pPlayer->xDir = xDir / length;
+    pPlayer->yDir = yDir / length;
+
+    // Walk forward along the facing direction and sideways across it
+    pPlayer->xVel = (pInput->forward * pPlayer->xDir - pInput->strafe * pPlayer->yDir)
+                    * WALK_SPEED;
+    pPlayer->yVel = (pInput->forward * pPlayer->yDir + pInput->strafe * pPlayer->xDir)
+                    * WALK_SPEED;
+
+    // Split long moves so that each part only reaches a few cells
+    double xMove = pPlayer->xVel * seconds;
+    double yMove = pPlayer->yVel * seconds;
+    double distance = sqrt(xMove * xMove + yMove * yMove);
+    int parts = (int)ceil(distance / pPlayer->radius);
+
+    for (int i = 0; i < parts; ++i)
+        moveAndSlide(pPlayer, pMaze, xMove / parts, yMove / parts);
+}
+
+
+/* Whole cells keep the player's spot within their cell exactly as it
+ * was, so nothing about the next step changes.
+ */
+void player_shift(struct Player *restrict pPlayer, int xShift, int yShift)
 {
-    freeMemory((void **)ppPlayer);
+    pPlayer->xPos += xShift;
+    pPlayer->yPos += yShift;
+}
+
+
+/* Exposes only the fields needed to look at the world from the
+ * player's point of view.
+ */
+void player_getPose(
+    const struct Player *restrict pPlayer,
+    struct PlayerPose *restrict pPose
+) {
+    pPose->xPos = pPlayer->xPos;
+    pPose->yPos = pPlayer->yPos;
+    pPose->xDir = pPlayer->xDir;
+    pPose->yDir = pPlayer->yDir;
+}
+
+
+/* Blends positions linearly and directions linearly too, then brings
+ * the direction back to unit length; over a single step the angle
+ * between the two is tiny, so that's as good as rotating.
+ */
+void player_interpolatePoses(
+    const struct PlayerPose *pFrom,
+    const struct PlayerPose *pTo,
+    double alpha,
+    struct PlayerPose *pPose
+) {
+    double xDir = pFrom->xDir + (pTo->xDir - pFrom->xDir) * alpha;
+    double yDir = pFrom->yDir + (pTo->yDir - pFrom->yDir) * alpha;
+    double length = sqrt(xDir * xDir + yDir * yDir);
+
+    pPose->xPos = pFrom->xPos + (pTo->xPos - pFrom->xPos) * alpha;
+    pPose->yPos = pFrom->yPos + (pTo->yPos - pFrom->yPos) * alpha;
+    pPose->xDir = xDir / length;
+    pPose->yDir = yDir / length;
+}
+
+
+// === Static function definitions === //
+
+/* Each contact stops the move where the circle touches, a hair short
+ * of the wall, and keeps only the part of what's left of it that runs
+ * along the wall. A corner takes two contacts; the second slide runs
+ * into the first wall again and stops there.
+ */
+static void moveAndSlide(
+    struct Player *restrict pPlayer,
+    const struct Maze *restrict pMaze,
+    double xMove,
+    double yMove
+) {
+    double xPos = pPlayer->xPos;
+    double yPos = pPlayer->yPos;
+
+    const double radius = pPlayer->radius;
+
+    for (int slide = 0; slide < MAX_SLIDES; ++slide)
+    {
+        struct Contact contact;
+
+        if (xMove == 0.0 && yMove == 0.0)
+            break;
+
+        if (!findFirstContact(pMaze, xPos, yPos, xMove, yMove, radius, &contact))
+        {
+            xPos += xMove;
+            yPos += yMove;
+            break;
+        }
+
+        xPos += xMove * contact.time + contact.xNormal * CONTACT_SKIN;
+        yPos += yMove * contact.time + contact.yNormal * CONTACT_SKIN;
+
+        // Drop the rest of the move's component into the wall
+        double remaining = 1.0 - contact.time;
+        xMove *= remaining;
+        yMove *= remaining;
+        double intoWall = xMove * contact.xNormal + yMove * contact.yNormal;
+        xMove -= intoWall * contact.xNormal;
+        yMove -= intoWall * contact.yNormal;
+    }
+
+    pPlayer->xPos = xPos;
+    pPlayer->yPos = yPos;
+}
+
+
+/* A wall is a unit segment along a grid line, so the circle touches it
+ * either on one of its faces or on one of its ends. Only grid lines the
+ * circle can reach during the move are checked: with moves kept shorter
+ * than the radius, that's at most three lines each way, at any maze
+ * size. The outer walls are always there, so the range never has to go
+ * past them.
+ */
+static bool findFirstContact(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    double xMove,
+    double yMove,
+    double radius,
+    struct Contact *restrict pContact
+) {
+    double xMin = fmin(xPos, xPos + xMove) - radius;
+    double xMax = fmax(xPos, xPos + xMove) + radius;
+    double yMin = fmin(yPos, yPos + yMove) - radius;
+    double yMax = fmax(yPos, yPos + yMove) + radius;
+
+    int xFirstLine = (int)fmax(ceil(xMin), 0.0);
+    int xLastLine  = (int)fmin(floor(xMax), pMaze->width);
+    int yFirstLine = (int)fmax(ceil(yMin), 0.0);
+    int yLastLine  = (int)fmin(floor(yMax), pMaze->height);
+    int xFirstCell = (int)fmax(floor(xMin), 0.0);
+    int xLastCell  = (int)fmin(floor(xMax), pMaze->width - 1);
+    int yFirstCell = (int)fmax(floor(yMin), 0.0);
+    int yLastCell  = (int)fmin(floor(yMax), pMaze->height - 1);
+
+    pContact->time = INFINITY;
+
+    // Walls along vertical grid lines, between cells side by side
+    for (int x = xFirstLine; x <= xLastLine; ++x)
+    {
+        for (int y = yFirstCell; y <= yLastCell; ++y)
+        {
+            if (!maze_hasWestWall(pMaze, x, y))
+                continue;
+
+            sweepAgainstFace(xPos, yPos, xMove, yMove, radius, x, y, true, pContact);
+            sweepAgainstPost(xPos, yPos, xMove, yMove, radius, x, y, pContact);
+            sweepAgainstPost(xPos, yPos, xMove, yMove, radius, x, y + 1, pContact);
+        }
+    }
+
+    // Walls along horizontal grid lines, between cells one above the other
+    for (int y = yFirstLine; y <= yLastLine; ++y)
+    {
+        for (int x = xFirstCell; x <= xLastCell; ++x)
+        {
+            if (!maze_hasNorthWall(pMaze, x, y))
+                continue;
+
+            sweepAgainstFace(yPos, xPos, yMove, xMove, radius, y, x, false, pContact);
+            sweepAgainstPost(xPos, yPos, xMove, yMove, radius, x, y, pContact);
+            sweepAgainstPost(xPos, yPos, xMove, yMove, radius, x + 1, y, pContact);
+        }
+    }
+
+    return pContact->time <= 1.0;
+}
+
+
+/* Works in the wall's own axes: u across it and v along it. The circle
+ * touches the face once its center comes within a radius of the line,
+ * so it's really a ray against the line pushed out by the radius. A
+ * circle that already overlaps the wall, and keeps going into it, is
+ * stopped right away.
+ */
+static void sweepAgainstFace(
+    double uPos,
+    double vPos,
+    double uMove,
+    double vMove,
+    double radius,
+    double uWall,
+    double vWall,
+    bool isVertical,
+    struct Contact *restrict pContact
+) {
+    double side = uPos < uWall ? -1.0 : 1.0;  // which side the circle is on
+
+    if (uMove * side >= 0.0)
+        return;  // moving along it or away from it
+
+    double time = (uWall + side * radius - uPos) / uMove;
+
+    if (time < 0.0)
+        time = 0.0;
+
+    if (time >= pContact->time || time > 1.0)
+        return;
+
+    double vHit = vPos + vMove * time;
+
+    if (vHit < vWall || vHit > vWall + 1.0)
+        return;  // past one end, where the post takes over
+
+    pContact->time = time;
+    pContact->xNormal = isVertical ? side : 0.0;
+    pContact->yNormal = isVertical ? 0.0 : side;
+}
+
+
+/* Solves for when the circle's center comes within a radius of the
+ * post, which is a ray against a circle. The normal points from the
+ * post to the center at that moment.
+ */
+static void sweepAgainstPost(
+    double xPos,
+    double yPos,
+    double xMove,
+    double yMove,
+    double radius,
+    double xPost,
+    double yPost,
+    struct Contact *restrict pContact
+) {
+    double xOffset = xPos - xPost;
+    double yOffset = yPos - yPost;
+    double a = xMove * xMove + yMove * yMove;
+    double b = xOffset * xMove + yOffset * yMove;
+    double c = xOffset * xOffset + yOffset * yOffset - radius * radius;
+
+    if (b >= 0.0)
+        return;  // moving away from it
+
+    double time = 0.0;
+
+    if (c > 0.0)
+    {
+        double discriminant = b * b - a * c;
+
+        if (discriminant < 0.0)
+            return;  // passes it by
+
+        time = (-b - sqrt(discriminant)) / a;
+    }
+
+    if (time >= pContact->time || time > 1.0)
+        return;
+
+    double xNormal = xOffset + xMove * time;
+    double yNormal = yOffset + yMove * time;
+    double length = sqrt(xNormal * xNormal + yNormal * yNormal);
+
+    if (length == 0.0)
+        return;  // standing right on it; the faces will stop it
+
+    pContact->time = time;
+    pContact->xNormal = xNormal / length;
+    pContact->yNormal = yNormal / length;
 }
@@ -0,0 +1,358 @@
+/**
+ * @file  profiler.c
+ * @brief Implementation of the profiler module.
+ *
+ * Defines the interface for the profiler module. Every thread records
+ * timestamped events into a ring buffer of its own, publishing each one
+ * with an atomic store, and the main thread reads the rings between
+ * frames, when no other thread is writing. Old events are overwritten
+ * as the rings wrap around.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#ifdef MAZECAST_PROFILE
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <stdint.h>    // for fixed-width integer types
+#include <string.h>    // for memset
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for timing and atomics
+#include "defines.h"   // for the cache line size
+#include "profiler.h"  // the header implemented here
+#include "utils.h"     // for freeing pointers
+#include "workers.h"   // for the maximum thread count
+
+#define RING_SIZE      (1 << 15)  // events per thread; must be a power of 2
+#define MAX_FRAMES     1024       // frame start times kept; a power of 2 too
+#define SMOOTHING      0.05       // weight of the newest frame in the averages
+
+// One zone boundary on one thread
+struct ProfileEvent
+{
+    Uint64   time;     // performance counter value
+    uint32_t zone;     // enum ProfileZone
+    uint32_t isBegin;  // 1 at the beginning of the zone, 0 at the end
+};
+
+// The events of one thread, oldest overwritten first
+struct EventRing
+{
+    struct ProfileEvent *events;      // RING_SIZE events
+    SDL_AtomicU32        count;       // events ever written, wrapping around
+    Uint32               readCount;   // events already added to the averages
+    Uint64               beginTimes[NUM_PROFILE_ZONES];  // 0 unless open
+};
+
+// Cache lines a ring takes, rounded up
+#define RING_LINES \
+    ( (sizeof(struct EventRing) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE )
+
+// A ring padded out to whole cache lines, so that the threads writing
+// rings next to each other never write to the same line
+union PaddedRing
+{
+    struct EventRing ring;
+    uint8_t          lines[RING_LINES][CACHE_LINE_SIZE];
+};
+
+// Everything the profiler records
+struct Profiler
+{
+    union PaddedRing *rings;                          // one per thread
+    int               threadCount;                    // number of rings
+    Uint64            frameStarts[MAX_FRAMES];        // start of each frame
+    int               frameCount;                     // frames started so far
+    double            zoneMs[NUM_PROFILE_ZONES];      // smoothed averages
+};
+
+// The profiler itself; empty until initialized
+static struct Profiler _profiler = { 0 };
+
+// Zone names, indexed by zone
+static const char *const _zoneNames[NUM_PROFILE_ZONES] = {
+    [ZONE_INPUT]      = "input",
+    [ZONE_ACTIONS]    = "actions",
+    [ZONE_SIMULATION] = "simulation",
+    [ZONE_RENDER]     = "render",
+    [ZONE_RAYCAST]    = "raycast",
+    [ZONE_SPRITES]    = "sprites",
+    [ZONE_UPLOAD]     = "upload",
+    [ZONE_PRESENT]    = "present",
+    [ZONE_CAPTURE]    = "capture",
+    [ZONE_WAIT]       = "wait"
+};
+
+
+// === Static function prototypes === //
+
+// Writes one event of a ring as a trace event object
+static void writeTraceEvent(
+    FILE *restrict pFile,
+    const struct ProfileEvent *restrict pEvent,
+    int thread,
+    Uint64 baseTime,
+    double usPerTick
+);
+
+
+// === Interface function definitions === //
+
+/* Allocates every ring up front, so that recording never allocates, and
+ * aligns them to cache lines, so that no two threads share one.
+ */
+bool profiler_init(int threadCount)
+{
+    assert(threadCount >= 1 && threadCount <= MAX_WORKER_THREADS);
+
+    size_t ringsSize = (size_t)threadCount * sizeof(*_profiler.rings);
+
+    _profiler = (struct Profiler) { 0 };
+    _profiler.rings = SDL_aligned_alloc(CACHE_LINE_SIZE, ringsSize);
+
+    if (!_profiler.rings)
+    {
+        perror("Error: Unable to allocate the profiler");
+        return false;
+    }
+
+    memset(_profiler.rings, 0, ringsSize);
+
+    for (int i = 0; i < threadCount; ++i)
+    {
+        struct EventRing *pRing = &_profiler.rings[i].ring;
+        pRing->events = malloc(RING_SIZE * sizeof(struct ProfileEvent));
+
+        if (!pRing->events)
+        {
+            perror("Error: Unable to allocate the profiler");
+            _profiler.threadCount = i;
+            profiler_destroy();
+            return false;
+        }
+    }
+
+    _profiler.threadCount = threadCount;
+    _profiler.frameStarts[0] = SDL_GetPerformanceCounter();
+    return true;
+}
+
+
+/* Fills in the event before publishing the new count with release
+ * semantics, so a reader that sees the count also sees the event.
+ */
+void profiler_record(enum ProfileZone zone, int thread, bool isBegin)
+{
+    if (thread >= _profiler.threadCount)
+        return;  // not initialized, or not a thread it knows
+
+    struct EventRing *pRing = &_profiler.rings[thread].ring;
+    Uint32 count = SDL_GetAtomicU32(&pRing->count);
+
+    pRing->events[count & (RING_SIZE - 1)] = (struct ProfileEvent) {
+        .time    = SDL_GetPerformanceCounter(),
+        .zone    = zone,
+        .isBegin = isBegin
+    };
+    SDL_SetAtomicU32(&pRing->count, count + 1);
+}
+
+
+/* Pairs up the new events of each thread by zone. Zones end on the
+ * thread that began them, so each ring can be matched on its own. The
+ * counts are unsigned so that they can wrap around safely.
+ */
+void profiler_endFrame(void)
+{
+    if (!_profiler.rings)
+        return;
+
+    const double msPerTick = 1000.0 / SDL_GetPerformanceFrequency();
+    double frameMs[NUM_PROFILE_ZONES] = { 0 };
+
+    for (int thread = 0; thread < _profiler.threadCount; ++thread)
+    {
+        struct EventRing *pRing = &_profiler.rings[thread].ring;
+        Uint32 count = SDL_GetAtomicU32(&pRing->count);
+        Uint32 first = pRing->readCount;
+
+        if (count - first > RING_SIZE)
+            first = count - RING_SIZE;  // the oldest ones were overwritten
+
+        for (Uint32 i = first; i != count; ++i)
+        {
+            const struct ProfileEvent *pEvent = &pRing->events[i & (RING_SIZE - 1)];
+            Uint64 *pBeginTime = &pRing->beginTimes[pEvent->zone];
+
+            if (pEvent->isBegin)
+            {
+                *pBeginTime = pEvent->time;
+            }
+            else if (*pBeginTime != 0)  // skip ends whose begins were lost
+            {
+                frameMs[pEvent->zone] += (pEvent->time - *pBeginTime) * msPerTick;
+                *pBeginTime = 0;
+            }
+        }
+
+        pRing->readCount = count;
+    }
+
+    for (int zone = 0; zone < NUM_PROFILE_ZONES; ++zone)
+        _profiler.zoneMs[zone] += (frameMs[zone] - _profiler.zoneMs[zone]) * SMOOTHING;
+
+    ++_profiler.frameCount;
+    _profiler.frameStarts[_profiler.frameCount & (MAX_FRAMES - 1)] =
+        SDL_GetPerformanceCounter();
+}
+
+
+/* The averages are updated once per frame, so this is just a lookup.
+ */
+double profiler_getZoneMs(enum ProfileZone zone)
+{
+    assert(zone >= 0 && zone < NUM_PROFILE_ZONES);
+    return _profiler.zoneMs[zone];
+}
+
+
+/* Falls back to "unknown" for anything out of range.
+ */
+const char *profiler_getZoneName(enum ProfileZone zone)
+{
+    if (zone < 0 || zone >= NUM_PROFILE_ZONES)
+        return "unknown";
+
+    return _zoneNames[zone];
+}
+
+
+/* Writes duration events ("B" and "E") in microseconds since the start
+ * of the first frame saved, plus an instant event at the start of every
+ * frame. Events older than that are skipped, as are ends whose begins
+ * were already overwritten, which the viewer would reject.
+ */
+bool profiler_writeTrace(const char *path, int frameCount)
+{
+    if (!_profiler.rings)
+        return false;
+
+    if (frameCount > _profiler.frameCount)
+        frameCount = _profiler.frameCount;
+    if (frameCount > MAX_FRAMES - 1)
+        frameCount = MAX_FRAMES - 1;
+
+    FILE *pFile = fopen(path, "w");
+
+    if (!pFile)
+    {
+        fprintf(stderr, "Error: Unable to create %s: ", path);
+        perror(NULL);
+        return false;
+    }
+
+    int firstFrame = _profiler.frameCount - frameCount;
+    Uint64 baseTime = _profiler.frameStarts[firstFrame & (MAX_FRAMES - 1)];
+    double usPerTick = 1e6 / SDL_GetPerformanceFrequency();
+    bool isFirst = true;
+
+    fputs("{\"traceEvents\":[\n", pFile);
+
+    for (int frame = firstFrame; frame < _profiler.frameCount; ++frame)
+    {
+        Uint64 start = _profiler.frameStarts[frame & (MAX_FRAMES - 1)];
+        fprintf(
+            pFile,
+            "%s{\"name\":\"frame %d\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,"
+            "\"pid\":1,\"tid\":0}",
+            isFirst ? "" : ",\n",
+            frame,
+            (start - baseTime) * usPerTick
+        );
+        isFirst = false;
+    }
+
+    for (int thread = 0; thread < _profiler.threadCount; ++thread)
+    {
+        struct EventRing *pRing = &_profiler.rings[thread].ring;
+        Uint32 count = SDL_GetAtomicU32(&pRing->count);
+        Uint32 first = count - SDL_min(count, (Uint32)RING_SIZE);
+        bool isOpen[NUM_PROFILE_ZONES] = { false };
+
+        fprintf(
+            pFile,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s %d\"}}",
+            isFirst ? "" : ",\n",
+            thread,
+            thread == 0 ? "main" : "worker",
+            thread
+        );
+        isFirst = false;
+
+        for (Uint32 i = first; i != count; ++i)
+        {
+            const struct ProfileEvent *pEvent = &pRing->events[i & (RING_SIZE - 1)];
+
+            if (pEvent->time < baseTime || (!pEvent->isBegin && !isOpen[pEvent->zone]))
+                continue;
+
+            isOpen[pEvent->zone] = pEvent->isBegin;
+            writeTraceEvent(pFile, pEvent, thread, baseTime, usPerTick);
+        }
+    }
+
+    fputs("\n]}\n", pFile);
+
+    if (fclose(pFile) != 0)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", path);
+        perror(NULL);
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Frees whatever rings were allocated and resets the profiler, which
+ * turns recording back off.
+ */
+void profiler_destroy(void)
+{
+    if (_profiler.rings)
+    {
+        for (int i = 0; i < _profiler.threadCount; ++i)
+            freeMemory((void **)&_profiler.rings[i].ring.events);
+
+        SDL_aligned_free(_profiler.rings);
+    }
+
+    _profiler = (struct Profiler) { 0 };
+}
+
+
+// === Static function definitions === //
+
+/* One line per event keeps big traces readable in a text editor too.
+ */
+static void writeTraceEvent(
+    FILE *restrict pFile,
+    const struct ProfileEvent *restrict pEvent,
+    int thread,
+    Uint64 baseTime,
+    double usPerTick
+) {
+    fprintf(
+        pFile,
+        ",\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+        _zoneNames[pEvent->zone],
+        pEvent->isBegin ? "B" : "E",
+        (pEvent->time - baseTime) * usPerTick,
+        thread
+    );
+}
+
+#endif  // MAZECAST_PROFILE
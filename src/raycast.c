@@ -0,0 +1,290 @@
+/**
+ * @file  raycast.c
+ * @brief Implementation of the raycast module.
+ *
+ * Defines the interface for the raycast module: run-time kernel
+ * selection based on the CPU's instruction sets, and the scalar kernel
+ * every other kernel must agree with. The SIMD kernels live in their
+ * own files so that each can be compiled for its own instruction set.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <math.h>      // for fabs, floor, ceil, and INFINITY
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for CPU feature detection and logging
+#include "raycast.h"   // the header implemented here
+
+// Signature shared by all the kernels
+typedef void (*CastRaysFunction)(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+);
+
+// The kernel in use; scalar until told otherwise
+static CastRaysFunction _castRays = raycast_castRaysScalar;
+
+// Kernel names as accepted on the command line, indexed by kernel
+static const char *const _kernelNames[NUM_RAYCAST_KERNELS] = {
+    [RAYCAST_AUTO]   = "auto",
+    [RAYCAST_SCALAR] = "scalar",
+    [RAYCAST_SSE2]   = "sse2",
+    [RAYCAST_AVX2]   = "avx2",
+    [RAYCAST_FIXED]  = "fixed"
+};
+
+
+// === Static function prototypes === //
+
+// Determines whether both the build and the CPU can run the kernel
+static bool isKernelSupported(enum RaycastKernel kernel);
+
+
+// === Interface function definitions === //
+
+/* Tries the requested kernel first. Otherwise, tries the kernels from
+ * the widest instruction set down to the scalar one, which always works.
+ * The fixed-point kernel is for measuring, so it's never picked unasked.
+ */
+enum RaycastKernel raycast_selectKernel(enum RaycastKernel requested)
+{
+    enum RaycastKernel kernel = requested;
+
+    if (kernel != RAYCAST_AUTO && !isKernelSupported(kernel))
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "The %s ray casting kernel isn't supported here; picking another.",
+            _kernelNames[kernel]
+        );
+        kernel = RAYCAST_AUTO;
+    }
+
+    if (kernel == RAYCAST_AUTO)
+    {
+        if (isKernelSupported(RAYCAST_AVX2))
+            kernel = RAYCAST_AVX2;
+        else if (isKernelSupported(RAYCAST_SSE2))
+            kernel = RAYCAST_SSE2;
+        else
+            kernel = RAYCAST_SCALAR;
+    }
+
+    switch (kernel)
+    {
+#ifdef MAZECAST_X86_SIMD
+    case RAYCAST_AVX2:
+        _castRays = raycast_castRaysAVX2;
+        break;
+    case RAYCAST_SSE2:
+        _castRays = raycast_castRaysSSE2;
+        break;
+#endif
+    case RAYCAST_FIXED:
+        raycast_initFixedTables();
+        _castRays = raycast_castRaysFixed;
+        break;
+    default:
+        _castRays = raycast_castRaysScalar;
+        break;
+    }
+
+    return kernel;
+}
+
+
+/* Falls back to "unknown" for anything out of range.
+ */
+const char *raycast_getKernelName(enum RaycastKernel kernel)
+{
+    if (kernel < 0 || kernel >= NUM_RAYCAST_KERNELS)
+        return "unknown";
+
+    return _kernelNames[kernel];
+}
+
+
+/* Only the fixed-point kernel walks every cell regardless.
+ */
+bool raycast_usesDistances(enum RaycastKernel kernel)
+{
+    assert(kernel != RAYCAST_AUTO);
+    return kernel != RAYCAST_FIXED;
+}
+
+
+/* Forwards the batch to whichever kernel was last selected.
+ */
+void raycast_castRays(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+) {
+    assert(pRays->count >= 0 && pRays->count <= RAY_BATCH_SIZE);
+    _castRays(pMaze, xPos, yPos, pRays);
+}
+
+
+/* Steps from one cell boundary to the next, always taking whichever of
+ * the next x or y boundary is closer along the ray, so each wall the ray
+ * passes is checked exactly once. The distance is measured to the camera
+ * plane rather than the eye to avoid fisheye distortion.
+ *
+ * Where the maze has a distance field, a ray in the middle of an open
+ * square jumps straight to the last cell it would reach inside it. It
+ * takes every step in one axis up to the square's edge, and as many in
+ * the other as come first along the ray, ties going to y like below.
+ */
+void raycast_castRaysScalar(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+) {
+    const int xStart = (int)xPos;
+    const int yStart = (int)yPos;
+
+    for (int i = 0; i < pRays->count; ++i)
+    {
+        double xRayDir = pRays->xRayDirs[i];
+        double yRayDir = pRays->yRayDirs[i];
+        int xMap = xStart;
+        int yMap = yStart;
+
+        // Ray length between consecutive x or y boundaries
+        double xDeltaDist = xRayDir == 0.0 ? INFINITY : fabs(1.0 / xRayDir);
+        double yDeltaDist = yRayDir == 0.0 ? INFINITY : fabs(1.0 / yRayDir);
+
+        // Ray length from the start to the first x or y boundary. Moving
+        // forward crosses the line past the cell, backward the one at it.
+        int xStep, yStep, xLineOffset, yLineOffset;
+        double xSideDist, ySideDist;
+
+        if (xRayDir < 0.0)
+        {
+            xStep = -1;
+            xLineOffset = 0;
+            xSideDist = (xPos - xMap) * xDeltaDist;
+        }
+        else
+        {
+            xStep = 1;
+            xLineOffset = 1;
+            xSideDist = (xMap + 1.0 - xPos) * xDeltaDist;
+        }
+
+        if (yRayDir < 0.0)
+        {
+            yStep = -1;
+            yLineOffset = 0;
+            ySideDist = (yPos - yMap) * yDeltaDist;
+        }
+        else
+        {
+            yStep = 1;
+            yLineOffset = 1;
+            ySideDist = (yMap + 1.0 - yPos) * yDeltaDist;
+        }
+
+        // Walk until crossing a wall; the outer walls guarantee one
+        double distance;
+        bool isYSide;
+        for (;;)
+        {
+            assert(xMap >= 0 && xMap < pMaze->width);
+            assert(yMap >= 0 && yMap < pMaze->height);
+
+            int radius = pMaze->distances
+                ? pMaze->distances[maze_getDistanceIndex(pMaze->tilesPerRow, xMap, yMap)]
+                : 0;
+
+            if (radius > 0)
+            {
+                double xExit = xSideDist + radius * xDeltaDist;
+                double yExit = ySideDist + radius * yDeltaDist;
+                int xCount = radius;
+                int yCount = radius;
+
+                if (xExit < yExit)
+                {
+                    double before = floor((xExit - ySideDist) / yDeltaDist) + 1.0;
+                    yCount = ySideDist <= xExit ? (int)SDL_min(before, radius) : 0;
+                }
+                else
+                {
+                    double before = ceil((yExit - xSideDist) / xDeltaDist);
+                    xCount = xSideDist < yExit ? (int)SDL_min(before, radius) : 0;
+                }
+
+                // Infinite steps never get taken, and 0 times one isn't 0
+                if (xCount > 0)
+                {
+                    xSideDist += xCount * xDeltaDist;
+                    xMap += xCount * xStep;
+                }
+
+                if (yCount > 0)
+                {
+                    ySideDist += yCount * yDeltaDist;
+                    yMap += yCount * yStep;
+                }
+            }
+
+            if (xSideDist < ySideDist)
+            {
+                if (maze_hasWestWall(pMaze, xMap + xLineOffset, yMap))
+                {
+                    distance = xSideDist;
+                    isYSide = false;
+                    break;
+                }
+
+                xSideDist += xDeltaDist;
+                xMap += xStep;
+            }
+            else
+            {
+                if (maze_hasNorthWall(pMaze, xMap, yMap + yLineOffset))
+                {
+                    distance = ySideDist;
+                    isYSide = true;
+                    break;
+                }
+
+                ySideDist += yDeltaDist;
+                yMap += yStep;
+            }
+        }
+
+        pRays->distances[i] = (float)distance;
+        pRays->isYSides[i]  = isYSide;
+    }
+}
+
+
+// === Static function definitions === //
+
+/* SIMD kernels are only compiled into x86 builds, and only run on CPUs
+ * that report the matching instruction set.
+ */
+static bool isKernelSupported(enum RaycastKernel kernel)
+{
+    switch (kernel)
+    {
+    case RAYCAST_SCALAR:
+    case RAYCAST_FIXED:
+        return true;
+#ifdef MAZECAST_X86_SIMD
+    case RAYCAST_SSE2:
+        return SDL_HasSSE2();
+    case RAYCAST_AVX2:
+        return SDL_HasAVX2();
+#endif
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file  raycast_avx2.c
+ * @brief AVX2 ray casting kernel for the raycast module.
+ *
+ * Traces eight rays at a time in single precision. Every lane takes one
+ * DDA step per iteration, and lanes that hit a wall are masked off until
+ * all eight are done. The walls the lanes cross are fetched with a
+ * single gather per iteration, and so are the lanes' distances to the
+ * nearest wall where the maze has a distance field.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <immintrin.h>  // for AVX2 intrinsics
+#include "raycast.h"    // the header implemented here
+
+#define LANES  8  // rays traced per iteration
+
+
+// === Static function prototypes === //
+
+// Moves each lane with a radius to the last cell it reaches inside the
+// open square of that radius around its cell
+static inline void skipOpenSquares(
+    __m256i radiusInt,
+    __m256 xDeltaDist,
+    __m256 yDeltaDist,
+    __m256i xStep,
+    __m256i yStep,
+    __m256i *restrict pXMap,
+    __m256i *restrict pYMap,
+    __m256 *restrict pXSideDist,
+    __m256 *restrict pYSideDist
+);
+
+
+// === Interface function definitions === //
+
+/* Mirrors raycast_castRaysScalar lane for lane. Masks stand in for the
+ * branches: a lane steps in x where its x-boundary is closer and in y
+ * everywhere else.
+ *
+ * Lanes keep stepping after they hit, so that the next step never has
+ * to wait on this step's gather; that lets the CPU overlap the gathers
+ * of consecutive steps instead of stalling on each one in turn.
+ *
+ * The gather reads the wall planes as 32-bit halves of their 64-bit
+ * tiles, low half first (x86 is little-endian), and both planes are
+ * reached from the west plane's base since the north one follows it.
+ * Distances are read as the low byte of a 32-bit word at each cell's
+ * byte, which the field's spare cache line keeps in bounds; the largest
+ * field still fits byte offsets in 31 bits.
+ */
+void raycast_castRaysAVX2(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+) {
+    const int xStart = (int)xPos;
+    const int yStart = (int)yPos;
+    const __m256 xFrac    = _mm256_set1_ps((float)(xPos - xStart));
+    const __m256 yFrac    = _mm256_set1_ps((float)(yPos - yStart));
+    const __m256 one      = _mm256_set1_ps(1.0f);
+    const __m256 zero     = _mm256_setzero_ps();
+    const __m256 absMask  = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256i oneInt  = _mm256_set1_epi32(1);
+    const __m256i zeroInt = _mm256_setzero_si256();
+    const __m256i xMax    = _mm256_set1_epi32(pMaze->width - 1);
+    const __m256i yMax    = _mm256_set1_epi32(pMaze->height - 1);
+    const __m256i tilesPerRow = _mm256_set1_epi32(pMaze->tilesPerRow);
+    const __m256i northPlane  = _mm256_set1_epi32((int)(2 * pMaze->planeWords));
+    const __m256i rowInTile   = _mm256_set1_epi32(4);  // picks a tile half
+    const __m256i rowInHalf   = _mm256_set1_epi32(3);
+    const __m256i columnInTile = _mm256_set1_epi32(7);
+    const __m256i byteMask     = _mm256_set1_epi32(0xFF);
+    const int *pWords = (const int *)pMaze->westWalls;
+    const int *pDistances = (const int *)pMaze->distances;
+
+    for (int i = 0; i < pRays->count; i += LANES)
+    {
+        __m256 xRayDir = _mm256_loadu_ps(pRays->xRayDirs + i);
+        __m256 yRayDir = _mm256_loadu_ps(pRays->yRayDirs + i);
+
+        // Ray length between boundaries; 1 / 0 is infinity, as it should be
+        __m256 xDeltaDist = _mm256_and_ps(_mm256_div_ps(one, xRayDir), absMask);
+        __m256 yDeltaDist = _mm256_and_ps(_mm256_div_ps(one, yRayDir), absMask);
+
+        // Step -1 where the ray points backward, 1 elsewhere. Moving
+        // forward crosses the line past the cell, backward the one at it.
+        __m256i isXNeg = _mm256_castps_si256(_mm256_cmp_ps(xRayDir, zero, _CMP_LT_OQ));
+        __m256i isYNeg = _mm256_castps_si256(_mm256_cmp_ps(yRayDir, zero, _CMP_LT_OQ));
+        __m256i xStep = _mm256_or_si256(isXNeg, oneInt);
+        __m256i yStep = _mm256_or_si256(isYNeg, oneInt);
+        __m256i xLineOffset = _mm256_andnot_si256(isXNeg, oneInt);
+        __m256i yLineOffset = _mm256_andnot_si256(isYNeg, oneInt);
+
+        // Ray length to the first boundary in each direction
+        __m256 xToEdge = _mm256_blendv_ps(
+            _mm256_sub_ps(one, xFrac),
+            xFrac,
+            _mm256_castsi256_ps(isXNeg)
+        );
+        __m256 yToEdge = _mm256_blendv_ps(
+            _mm256_sub_ps(one, yFrac),
+            yFrac,
+            _mm256_castsi256_ps(isYNeg)
+        );
+        __m256 xSideDist = _mm256_mul_ps(xToEdge, xDeltaDist);
+        __m256 ySideDist = _mm256_mul_ps(yToEdge, yDeltaDist);
+
+        __m256i xMap = _mm256_set1_epi32(xStart);
+        __m256i yMap = _mm256_set1_epi32(yStart);
+        __m256i isActive = _mm256_cmpeq_epi32(xMap, xMap);  // all lanes on
+        __m256 distance = zero;
+        __m256 isYSide = zero;
+
+        for (;;)
+        {
+            // Cross open space in one go where there's a field to say so
+            if (pDistances)
+            {
+                __m256i cellTile = _mm256_add_epi32(
+                    _mm256_mullo_epi32(_mm256_srli_epi32(yMap, 3), tilesPerRow),
+                    _mm256_srli_epi32(xMap, 3)
+                );
+                __m256i cell = _mm256_or_si256(
+                    _mm256_slli_epi32(cellTile, 6),
+                    _mm256_or_si256(
+                        _mm256_slli_epi32(_mm256_and_si256(yMap, columnInTile), 3),
+                        _mm256_and_si256(xMap, columnInTile)
+                    )
+                );
+                __m256i radius = _mm256_and_si256(
+                    _mm256_i32gather_epi32(pDistances, cell, 1),
+                    _mm256_and_si256(byteMask, isActive)
+                );
+
+                if (!_mm256_testz_si256(radius, radius))
+                {
+                    skipOpenSquares(
+                        radius,
+                        xDeltaDist,
+                        yDeltaDist,
+                        xStep,
+                        yStep,
+                        &xMap,
+                        &yMap,
+                        &xSideDist,
+                        &ySideDist
+                    );
+                }
+            }
+
+            // The wall each lane is about to cross
+            __m256 isXStep = _mm256_cmp_ps(xSideDist, ySideDist, _CMP_LT_OQ);
+            __m256i isXStepInt = _mm256_castps_si256(isXStep);
+            __m256 stepDist = _mm256_blendv_ps(ySideDist, xSideDist, isXStep);
+            __m256i xLine = _mm256_add_epi32(
+                xMap,
+                _mm256_and_si256(isXStepInt, xLineOffset)
+            );
+            __m256i yLine = _mm256_add_epi32(
+                yMap,
+                _mm256_andnot_si256(isXStepInt, yLineOffset)
+            );
+
+            // Find the wall's tile half and bit, then gather
+            __m256i tile = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_srli_epi32(yLine, 3), tilesPerRow),
+                _mm256_srli_epi32(xLine, 3)
+            );
+            __m256i wordIndex = _mm256_add_epi32(
+                _mm256_or_si256(
+                    _mm256_slli_epi32(tile, 1),
+                    _mm256_srli_epi32(_mm256_and_si256(yLine, rowInTile), 2)
+                ),
+                _mm256_andnot_si256(isXStepInt, northPlane)
+            );
+            __m256i bit = _mm256_or_si256(
+                _mm256_slli_epi32(_mm256_and_si256(yLine, rowInHalf), 3),
+                _mm256_and_si256(xLine, columnInTile)
+            );
+            __m256i words = _mm256_i32gather_epi32(pWords, wordIndex, 4);
+            __m256i isWall = _mm256_and_si256(_mm256_srlv_epi32(words, bit), oneInt);
+            __m256i isHitInt = _mm256_andnot_si256(
+                _mm256_cmpeq_epi32(isWall, zeroInt),
+                isActive
+            );
+
+            // Record the first hit of each lane
+            __m256 isHit = _mm256_castsi256_ps(isHitInt);
+            distance = _mm256_blendv_ps(distance, stepDist, isHit);
+            isYSide = _mm256_blendv_ps(isYSide, _mm256_andnot_ps(isXStep, isHit), isHit);
+
+            isActive = _mm256_andnot_si256(isHitInt, isActive);
+            if (_mm256_testz_si256(isActive, isActive))
+                break;
+
+            // Step every lane; finished lanes carry on but are ignored
+            xMap = _mm256_add_epi32(xMap, _mm256_and_si256(isXStepInt, xStep));
+            yMap = _mm256_add_epi32(yMap, _mm256_andnot_si256(isXStepInt, yStep));
+            xSideDist = _mm256_add_ps(xSideDist, _mm256_and_ps(isXStep, xDeltaDist));
+            ySideDist = _mm256_add_ps(ySideDist, _mm256_andnot_ps(isXStep, yDeltaDist));
+
+            // Finished lanes may walk through the outer walls; keep them in
+            xMap = _mm256_min_epi32(_mm256_max_epi32(xMap, zeroInt), xMax);
+            yMap = _mm256_min_epi32(_mm256_max_epi32(yMap, zeroInt), yMax);
+        }
+
+        _mm256_storeu_ps(pRays->distances + i, distance);
+        int ySideBits = _mm256_movemask_ps(isYSide);
+        for (int lane = 0; lane < LANES; ++lane)
+            pRays->isYSides[i + lane] = (ySideBits >> lane) & 1;
+    }
+}
+
+
+// === Static function definitions === //
+
+/* Mirrors the skip in raycast_castRaysScalar lane for lane. Lanes with
+ * no radius, or that can't step in an axis at all, are blended back to
+ * what they were, since infinity times 0 makes a NaN of them.
+ */
+static inline void skipOpenSquares(
+    __m256i radiusInt,
+    __m256 xDeltaDist,
+    __m256 yDeltaDist,
+    __m256i xStep,
+    __m256i yStep,
+    __m256i *restrict pXMap,
+    __m256i *restrict pYMap,
+    __m256 *restrict pXSideDist,
+    __m256 *restrict pYSideDist
+) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    __m256 radius = _mm256_cvtepi32_ps(radiusInt);
+    __m256 xSideDist = *pXSideDist;
+    __m256 ySideDist = *pYSideDist;
+
+    __m256 xExit = _mm256_add_ps(xSideDist, _mm256_mul_ps(radius, xDeltaDist));
+    __m256 yExit = _mm256_add_ps(ySideDist, _mm256_mul_ps(radius, yDeltaDist));
+    __m256 isXExit = _mm256_cmp_ps(xExit, yExit, _CMP_LT_OQ);
+
+    // Steps in the other axis that come before the exit, ties going to y
+    __m256 yBefore = _mm256_min_ps(
+        _mm256_add_ps(
+            _mm256_floor_ps(_mm256_div_ps(_mm256_sub_ps(xExit, ySideDist), yDeltaDist)),
+            one
+        ),
+        radius
+    );
+    yBefore = _mm256_and_ps(yBefore, _mm256_cmp_ps(ySideDist, xExit, _CMP_LE_OQ));
+    __m256 xBefore = _mm256_min_ps(
+        _mm256_ceil_ps(_mm256_div_ps(_mm256_sub_ps(yExit, xSideDist), xDeltaDist)),
+        radius
+    );
+    xBefore = _mm256_and_ps(xBefore, _mm256_cmp_ps(xSideDist, yExit, _CMP_LT_OQ));
+
+    __m256 hasRadius = _mm256_cmp_ps(radius, zero, _CMP_GT_OQ);
+    __m256 xCount = _mm256_and_ps(_mm256_blendv_ps(xBefore, radius, isXExit), hasRadius);
+    __m256 yCount = _mm256_and_ps(_mm256_blendv_ps(radius, yBefore, isXExit), hasRadius);
+
+    *pXSideDist = _mm256_blendv_ps(
+        xSideDist,
+        _mm256_add_ps(xSideDist, _mm256_mul_ps(xCount, xDeltaDist)),
+        _mm256_cmp_ps(xCount, zero, _CMP_GT_OQ)
+    );
+    *pYSideDist = _mm256_blendv_ps(
+        ySideDist,
+        _mm256_add_ps(ySideDist, _mm256_mul_ps(yCount, yDeltaDist)),
+        _mm256_cmp_ps(yCount, zero, _CMP_GT_OQ)
+    );
+    *pXMap = _mm256_add_epi32(
+        *pXMap,
+        _mm256_mullo_epi32(_mm256_cvttps_epi32(xCount), xStep)
+    );
+    *pYMap = _mm256_add_epi32(
+        *pYMap,
+        _mm256_mullo_epi32(_mm256_cvttps_epi32(yCount), yStep)
+    );
+}
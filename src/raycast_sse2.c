@@ -0,0 +1,328 @@
+/**
+ * @file  raycast_sse2.c
+ * @brief SSE2 ray casting kernel for the raycast module.
+ *
+ * Traces four rays at a time in single precision. Every lane takes one
+ * DDA step per iteration, and lanes that hit a wall are masked off until
+ * all four are done. SSE2 has no gather, so the walls are read one lane
+ * at a time, and so are the lanes' distances to the nearest wall where
+ * the maze has a distance field.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <emmintrin.h>  // for SSE2 intrinsics
+#include "raycast.h"    // the header implemented here
+
+#define LANES  4  // rays traced per iteration
+
+
+// === Static function prototypes === //
+
+// Returns -1 (all bits set) if there's a wall or it's off the maze, else 0
+static inline int32_t isWallAt(
+    const struct Maze *restrict pMaze,
+    bool isVertical,
+    int x,
+    int y
+);
+
+// Returns the radius of the open square around a cell, or 0 if it's off
+// the maze
+static inline int32_t getRadiusAt(const struct Maze *restrict pMaze, int x, int y);
+
+// Moves each lane with a radius to the last cell it reaches inside the
+// open square of that radius around its cell
+static inline void skipOpenSquares(
+    __m128i radiusInt,
+    __m128 xDeltaDist,
+    __m128 yDeltaDist,
+    __m128i isXNeg,
+    __m128i isYNeg,
+    __m128i *restrict pXMap,
+    __m128i *restrict pYMap,
+    __m128 *restrict pXSideDist,
+    __m128 *restrict pYSideDist
+);
+
+// Rounds each lane down to a whole number, for lanes within int range
+static inline __m128 floorLanes(__m128 values);
+
+// Rounds each lane up to a whole number, for lanes within int range
+static inline __m128 ceilLanes(__m128 values);
+
+
+// === Interface function definitions === //
+
+/* Mirrors raycast_castRaysScalar lane for lane. Masks stand in for the
+ * branches: a lane steps in x where its x-boundary is closer and in y
+ * everywhere else.
+ *
+ * Lanes keep stepping after they hit, so that the next step never has
+ * to wait on this step's lookups; that lets the CPU overlap the lookups
+ * of consecutive steps instead of stalling on each one in turn.
+ */
+void raycast_castRaysSSE2(
+    const struct Maze *restrict pMaze,
+    double xPos,
+    double yPos,
+    struct RayBatch *restrict pRays
+) {
+    const int xStart = (int)xPos;
+    const int yStart = (int)yPos;
+    const __m128 xFrac   = _mm_set1_ps((float)(xPos - xStart));
+    const __m128 yFrac   = _mm_set1_ps((float)(yPos - yStart));
+    const __m128 one     = _mm_set1_ps(1.0f);
+    const __m128 zero    = _mm_setzero_ps();
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128i oneInt = _mm_set1_epi32(1);
+
+    for (int i = 0; i < pRays->count; i += LANES)
+    {
+        __m128 xRayDir = _mm_loadu_ps(pRays->xRayDirs + i);
+        __m128 yRayDir = _mm_loadu_ps(pRays->yRayDirs + i);
+
+        // Ray length between boundaries; 1 / 0 is infinity, as it should be
+        __m128 xDeltaDist = _mm_and_ps(_mm_div_ps(one, xRayDir), absMask);
+        __m128 yDeltaDist = _mm_and_ps(_mm_div_ps(one, yRayDir), absMask);
+
+        // Step -1 where the ray points backward, 1 elsewhere. Moving
+        // forward crosses the line past the cell, backward the one at it.
+        __m128 isXNeg = _mm_cmplt_ps(xRayDir, zero);
+        __m128 isYNeg = _mm_cmplt_ps(yRayDir, zero);
+        __m128i xStep = _mm_or_si128(_mm_castps_si128(isXNeg), oneInt);
+        __m128i yStep = _mm_or_si128(_mm_castps_si128(isYNeg), oneInt);
+        __m128i xLineOffset = _mm_andnot_si128(_mm_castps_si128(isXNeg), oneInt);
+        __m128i yLineOffset = _mm_andnot_si128(_mm_castps_si128(isYNeg), oneInt);
+
+        // Ray length to the first boundary in each direction
+        __m128 xToEdge = _mm_or_ps(
+            _mm_and_ps(isXNeg, xFrac),
+            _mm_andnot_ps(isXNeg, _mm_sub_ps(one, xFrac))
+        );
+        __m128 yToEdge = _mm_or_ps(
+            _mm_and_ps(isYNeg, yFrac),
+            _mm_andnot_ps(isYNeg, _mm_sub_ps(one, yFrac))
+        );
+        __m128 xSideDist = _mm_mul_ps(xToEdge, xDeltaDist);
+        __m128 ySideDist = _mm_mul_ps(yToEdge, yDeltaDist);
+
+        __m128i xMap = _mm_set1_epi32(xStart);
+        __m128i yMap = _mm_set1_epi32(yStart);
+        __m128i isActive = _mm_cmpeq_epi32(xMap, xMap);  // all lanes on
+        __m128 distance = zero;
+        __m128 isYSide = zero;
+
+        for (;;)
+        {
+            // Cross open space in one go where there's a field to say so
+            if (pMaze->distances)
+            {
+                int32_t xCells[LANES], yCells[LANES];
+                _mm_storeu_si128((__m128i *)xCells, xMap);
+                _mm_storeu_si128((__m128i *)yCells, yMap);
+                __m128i radius = _mm_and_si128(
+                    _mm_setr_epi32(
+                        getRadiusAt(pMaze, xCells[0], yCells[0]),
+                        getRadiusAt(pMaze, xCells[1], yCells[1]),
+                        getRadiusAt(pMaze, xCells[2], yCells[2]),
+                        getRadiusAt(pMaze, xCells[3], yCells[3])
+                    ),
+                    isActive
+                );
+
+                __m128i hasNoRadius = _mm_cmpeq_epi32(radius, _mm_setzero_si128());
+                if (_mm_movemask_epi8(hasNoRadius) != 0xFFFF)
+                {
+                    skipOpenSquares(
+                        radius,
+                        xDeltaDist,
+                        yDeltaDist,
+                        _mm_castps_si128(isXNeg),
+                        _mm_castps_si128(isYNeg),
+                        &xMap,
+                        &yMap,
+                        &xSideDist,
+                        &ySideDist
+                    );
+                }
+            }
+
+            // The wall each lane is about to cross
+            __m128 isXStep = _mm_cmplt_ps(xSideDist, ySideDist);
+            __m128i isXStepInt = _mm_castps_si128(isXStep);
+            __m128 stepDist = _mm_or_ps(
+                _mm_and_ps(isXStep, xSideDist),
+                _mm_andnot_ps(isXStep, ySideDist)
+            );
+            __m128i xLine = _mm_add_epi32(xMap, _mm_and_si128(isXStepInt, xLineOffset));
+            __m128i yLine = _mm_add_epi32(yMap, _mm_andnot_si128(isXStepInt, yLineOffset));
+
+            // Look the walls up one lane at a time
+            int32_t xLines[LANES], yLines[LANES];
+            _mm_storeu_si128((__m128i *)xLines, xLine);
+            _mm_storeu_si128((__m128i *)yLines, yLine);
+            int xStepBits = _mm_movemask_ps(isXStep);
+            __m128i isWall = _mm_setr_epi32(
+                isWallAt(pMaze, xStepBits & 1, xLines[0], yLines[0]),
+                isWallAt(pMaze, xStepBits & 2, xLines[1], yLines[1]),
+                isWallAt(pMaze, xStepBits & 4, xLines[2], yLines[2]),
+                isWallAt(pMaze, xStepBits & 8, xLines[3], yLines[3])
+            );
+
+            // Record the first hit of each lane
+            __m128i isHitInt = _mm_and_si128(isWall, isActive);
+            __m128 isHit = _mm_castsi128_ps(isHitInt);
+            distance = _mm_or_ps(
+                _mm_and_ps(isHit, stepDist),
+                _mm_andnot_ps(isHit, distance)
+            );
+            isYSide = _mm_or_ps(
+                _mm_andnot_ps(isXStep, isHit),
+                _mm_andnot_ps(isHit, isYSide)
+            );
+
+            isActive = _mm_andnot_si128(isHitInt, isActive);
+            if (_mm_movemask_epi8(isActive) == 0)
+                break;
+
+            // Step every lane; finished lanes carry on but are ignored
+            xMap = _mm_add_epi32(xMap, _mm_and_si128(isXStepInt, xStep));
+            yMap = _mm_add_epi32(yMap, _mm_andnot_si128(isXStepInt, yStep));
+            xSideDist = _mm_add_ps(xSideDist, _mm_and_ps(isXStep, xDeltaDist));
+            ySideDist = _mm_add_ps(ySideDist, _mm_andnot_ps(isXStep, yDeltaDist));
+        }
+
+        _mm_storeu_ps(pRays->distances + i, distance);
+        int ySideBits = _mm_movemask_ps(isYSide);
+        for (int lane = 0; lane < LANES; ++lane)
+            pRays->isYSides[i + lane] = (ySideBits >> lane) & 1;
+    }
+}
+
+
+// === Static function definitions === //
+
+/* Lanes that already hit can walk through the outer walls, so anything
+ * outside of them counts as a wall rather than being read.
+ */
+static inline int32_t isWallAt(
+    const struct Maze *restrict pMaze,
+    bool isVertical,
+    int x,
+    int y
+) {
+    if ((unsigned)x > (unsigned)pMaze->width || (unsigned)y > (unsigned)pMaze->height)
+        return -1;
+
+    const uint64_t *plane = isVertical ? pMaze->westWalls : pMaze->northWalls;
+    return -(int32_t)maze_testWall(plane, pMaze->tilesPerRow, x, y);
+}
+
+
+/* Finished lanes may have walked off the maze, but they're masked off
+ * before the radius is used.
+ */
+static inline int32_t getRadiusAt(const struct Maze *restrict pMaze, int x, int y)
+{
+    if ((unsigned)x >= (unsigned)pMaze->width || (unsigned)y >= (unsigned)pMaze->height)
+        return 0;
+
+    return pMaze->distances[maze_getDistanceIndex(pMaze->tilesPerRow, x, y)];
+}
+
+
+/* Mirrors the skip in raycast_castRaysScalar lane for lane. Clamping to
+ * the radius comes before rounding rather than after, which gives the
+ * same counts for a whole-number radius and keeps the rounding within
+ * int range; a NaN from infinity minus infinity clamps to the radius
+ * too, as `_mm_min_ps` returns its second operand then. Lanes with no
+ * radius, or that can't step in an axis at all, are left as they were,
+ * since infinity times 0 makes a NaN of them.
+ */
+static inline void skipOpenSquares(
+    __m128i radiusInt,
+    __m128 xDeltaDist,
+    __m128 yDeltaDist,
+    __m128i isXNeg,
+    __m128i isYNeg,
+    __m128i *restrict pXMap,
+    __m128i *restrict pYMap,
+    __m128 *restrict pXSideDist,
+    __m128 *restrict pYSideDist
+) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.0f);
+    __m128 radius = _mm_cvtepi32_ps(radiusInt);
+    __m128 xSideDist = *pXSideDist;
+    __m128 ySideDist = *pYSideDist;
+
+    __m128 xExit = _mm_add_ps(xSideDist, _mm_mul_ps(radius, xDeltaDist));
+    __m128 yExit = _mm_add_ps(ySideDist, _mm_mul_ps(radius, yDeltaDist));
+    __m128 isXExit = _mm_cmplt_ps(xExit, yExit);
+
+    // Steps in the other axis that come before the exit, ties going to y
+    __m128 yBefore = _mm_add_ps(
+        floorLanes(_mm_min_ps(
+            _mm_div_ps(_mm_sub_ps(xExit, ySideDist), yDeltaDist),
+            _mm_sub_ps(radius, one)
+        )),
+        one
+    );
+    yBefore = _mm_and_ps(yBefore, _mm_cmple_ps(ySideDist, xExit));
+    __m128 xBefore = ceilLanes(_mm_min_ps(
+        _mm_div_ps(_mm_sub_ps(yExit, xSideDist), xDeltaDist),
+        radius
+    ));
+    xBefore = _mm_and_ps(xBefore, _mm_cmplt_ps(xSideDist, yExit));
+
+    __m128 hasRadius = _mm_cmpgt_ps(radius, zero);
+    __m128 xCount = _mm_and_ps(
+        _mm_or_ps(_mm_and_ps(isXExit, radius), _mm_andnot_ps(isXExit, xBefore)),
+        hasRadius
+    );
+    __m128 yCount = _mm_and_ps(
+        _mm_or_ps(_mm_and_ps(isXExit, yBefore), _mm_andnot_ps(isXExit, radius)),
+        hasRadius
+    );
+    __m128 isXCount = _mm_cmpgt_ps(xCount, zero);
+    __m128 isYCount = _mm_cmpgt_ps(yCount, zero);
+
+    *pXSideDist = _mm_add_ps(
+        xSideDist,
+        _mm_and_ps(isXCount, _mm_mul_ps(xCount, xDeltaDist))
+    );
+    *pYSideDist = _mm_add_ps(
+        ySideDist,
+        _mm_and_ps(isYCount, _mm_mul_ps(yCount, yDeltaDist))
+    );
+
+    // Negating where the step is -1 multiplies by the step
+    __m128i xMove = _mm_cvttps_epi32(xCount);
+    __m128i yMove = _mm_cvttps_epi32(yCount);
+    *pXMap = _mm_add_epi32(*pXMap, _mm_sub_epi32(_mm_xor_si128(xMove, isXNeg), isXNeg));
+    *pYMap = _mm_add_epi32(*pYMap, _mm_sub_epi32(_mm_xor_si128(yMove, isYNeg), isYNeg));
+}
+
+
+/* Truncating rounds negative numbers up, so those lanes get one taken
+ * back off.
+ */
+static inline __m128 floorLanes(__m128 values)
+{
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(values));
+    __m128 isRoundedUp = _mm_cmpgt_ps(truncated, values);
+    return _mm_sub_ps(truncated, _mm_and_ps(isRoundedUp, _mm_set1_ps(1.0f)));
+}
+
+
+/* Truncating rounds positive numbers down, so those lanes get one added
+ * back on.
+ */
+static inline __m128 ceilLanes(__m128 values)
+{
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(values));
+    __m128 isRoundedDown = _mm_cmplt_ps(truncated, values);
+    return _mm_add_ps(truncated, _mm_and_ps(isRoundedDown, _mm_set1_ps(1.0f)));
+}
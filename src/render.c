@@ -0,0 +1,1035 @@
+/**
+ * @file  render.c
+ * @brief Implementation of the render module.
+ *
+ * Defines the interface for the render module and provides internal
+ * helper functions to fill the floor and ceiling row by row, with spans
+ * handed to the flats module, and then cast one ray per screen column,
+ * in batches handed to the raycast module, and draw a textured wall
+ * slice down each column over them. The frame is split into vertical
+ * strips that can be drawn on separate threads.
+ *
+ * Sprites go on top once every strip's walls are in, since which ones
+ * might be seen depends on how far the farthest wall is. The ones in
+ * view are sorted back to front by a radix sort on their depth, then
+ * drawn strip by strip again, each strip clipping them to its columns.
+ *
+ * An interlaced view casts only the even or the odd columns of each
+ * strip, by turns, as a batch half as big. Its floor and ceiling rows
+ * are textured as spans over just those columns, from a copy of the
+ * column tables split by field, and then spread out over the row.
+ *
+ * Drawing in palette indices takes the same steps, each with a branch
+ * of its own that shades by table lookup, and expands the indices only
+ * when the region is copied out.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <math.h>      // for trigonometry, rounding, and fabs
+#include <string.h>    // for memset and memcpy
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for aligned allocation and pi
+#include "render.h"    // the header implemented here
+#include "flats.h"     // for texturing the floor and ceiling
+#include "palette.h"   // for drawing in 256 colors
+#include "profiler.h"  // for timing the strips
+#include "raycast.h"   // for tracing rays through the maze
+#include "sprites.h"   // for the items drawn over the walls
+#include "texture.h"   // for texturing the walls
+#include "workers.h"   // for drawing strips in parallel
+#include "defines.h"   // for the cache line size
+
+#define PIXELS_PER_LINE  ( CACHE_LINE_SIZE / (int)sizeof(uint32_t) )
+
+#define CEILING_COLOR  0xFF008080u  // teal, same as the old clear color
+#define FLOOR_COLOR    0xFF3A3A3Au  // dark gray
+#define CRUMB_COLOR    0xFFE8C040u  // gold
+#define EXIT_COLOR     0xFF40E060u  // green
+#define TEXTURE_COUNT  ( 3 + SPRITE_KIND_COUNT )  // the above, plus one per item
+
+// Columns per strip; a whole batch of rays and a whole number of cache
+// lines, so threads drawing neighboring strips never share a line
+#define STRIP_WIDTH  RAY_BATCH_SIZE
+
+#define MIN_WALL_DISTANCE  1e-4f  // keeps walls at the eye from dividing by 0
+
+#define MAX_INTERLACED_SHIFT  4.0  // pixels a view can slide sideways and still
+                                   // be interlaced
+
+#define MAX_VIEW_SPRITES   1024   // most sprites drawn in one view
+#define MIN_SPRITE_DEPTH   0.05   // nearer sprites would fill the view
+#define SPRITE_REACH       0.5    // cells a sprite can stick out of its own
+#define DEPTH_KEY_BITS     16     // bits of depth sorted on
+#define RADIX_BITS         8      // bits sorted on per pass
+
+// A sprite as it lands on the screen
+struct ScreenSprite
+{
+    const struct Texture *texture;  // what it looks like
+    float                 depth;    // distance along the view axis
+    int                   left;     // leftmost column, on screen or not
+    int                   top;      // top row, on screen or not
+    int                   size;     // pixels per side
+    uint32_t              shade;    // brightness out of 256
+    uint32_t              key;      // greater for nearer sprites
+};
+
+// Everything a thread needs to draw its share of the view
+struct ViewJob
+{
+    struct Framebuffer        *frame;        // where to draw
+    const struct PlayerPose   *pose;         // where to look from
+    const struct Maze         *maze;         // what to look at
+    const struct ViewTextures *textures;     // what everything looks like
+    uint64_t                  *texelBytes;   // wall texture bytes read, per thread
+    float                     *farDepths;    // farthest wall seen, per thread
+    const struct ScreenSprite *sprites;      // sprites in view, back to front
+    int                        spriteCount;  // number of sprites in view
+    int                        field;        // first column of each strip drawn
+    int                        columnStep;   // 1 to draw every column, 2 every other
+    float                      xDir;         // facing direction, x-component
+    float                      yDir;         // facing direction, y-component
+    float                      xPlane;       // unscaled camera plane, x-component
+    float                      yPlane;       // unscaled camera plane, y-component
+    int32_t                    viewAngle;    // facing direction, in fine angles
+};
+
+// Size and height off the floor of each kind of sprite, in cells
+static const double _spriteSizes[SPRITE_KIND_COUNT] = {
+    [SPRITE_CRUMB] = 0.2,
+    [SPRITE_EXIT]  = 0.5
+};
+static const double _spriteLifts[SPRITE_KIND_COUNT] = {
+    [SPRITE_CRUMB] = 0.0,
+    [SPRITE_EXIT]  = 0.25
+};
+
+
+// === Static function prototypes === //
+
+// Fills the column tables for a view of the given size, padding included
+static void buildColumnTables(
+    struct ColumnTables *restrict pColumns,
+    int width,
+    int height,
+    int pitch
+);
+
+// Measures how far a pose turned from the one the framebuffer was last
+// drawn from, in pixels the middle of the view slides sideways
+static double getTurnShift(
+    const struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose
+);
+
+// Checks whether two poses are the same, to the bit
+static bool isSamePose(
+    const struct PlayerPose *restrict pLeft,
+    const struct PlayerPose *restrict pRight
+);
+
+// Gets the generation of a set of items, or 0 for none
+static inline uint32_t getItemGeneration(const struct SpriteSet *pSprites);
+
+// Fills every row of floor and ceiling across the columns of one strip
+// of the view that are being drawn
+static void drawFlats(const struct ViewJob *restrict pJob, int xFirst, int count);
+
+// Casts and draws every column in one strip of the view
+static void drawStrip(void *pData, int stripIndex, int workerIndex);
+
+// Projects the sprites in cells the view could reach onto the screen,
+// keeping those in view, and returns how many it kept
+static int queueSprites(
+    const struct ViewJob *restrict pJob,
+    const struct SpriteSet *restrict pSprites,
+    float farDepth
+);
+
+// Sorts the sprites in view from back to front, using the spare room
+// after them in the framebuffer
+static void sortSprites(struct ScreenSprite *restrict sprites, int count);
+
+// Draws the sprites in view over one strip of the view
+static void drawSpriteStrip(void *pData, int stripIndex, int workerIndex);
+
+// Draws the wall slice in one column based on where its ray hit, in
+// pixels or indices, and returns how many bytes of texture it read
+static size_t drawColumn(
+    struct Framebuffer *restrict pFrame,
+    const struct Texture *restrict pTexture,
+    int x,
+    float distance,
+    bool isYSide,
+    double wallX
+);
+
+
+// === Interface function definitions === //
+
+/* Pads each row to a whole number of cache lines and aligns the pixel
+ * block to a cache line, so no two rows ever share a line; index rows
+ * get the same treatment. The column tables share a second block, one
+ * array after another, along with the depths and twice the room for the
+ * most sprites in view, for sorting.
+ */
+bool render_initFramebuffer(
+    struct Framebuffer *pFrame,
+    int width,
+    int height,
+    bool isIndexed
+) {
+    assert(pFrame != NULL);
+    assert(width > 0 && height > 0);
+
+    int pitch = (width + PIXELS_PER_LINE - 1) / PIXELS_PER_LINE * PIXELS_PER_LINE;
+    int indexPitch = (width + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    size_t size = (size_t)pitch * (size_t)height * sizeof(uint32_t);
+    size_t indexSize = (size_t)indexPitch * (size_t)height;
+
+    pFrame->pixels = isIndexed ? NULL : SDL_aligned_alloc(CACHE_LINE_SIZE, size);
+    pFrame->indices = isIndexed ? SDL_aligned_alloc(CACHE_LINE_SIZE, indexSize) : NULL;
+
+    struct ColumnTables *pColumns = &pFrame->columns;
+    size_t tableSize = (size_t)pitch * ( sizeof(*pColumns->cameraXs)
+                                         + sizeof(*pColumns->angleOffsets)
+                                         + sizeof(*pColumns->fisheyes)
+                                         + sizeof(*pColumns->fieldCameraXs)
+                                         + sizeof(*pFrame->depths)
+                                         + sizeof(*pFrame->fieldRow) );
+    tableSize += 2 * MAX_VIEW_SPRITES * sizeof(*pFrame->sprites);
+    pColumns->cameraXs = SDL_aligned_alloc(CACHE_LINE_SIZE, tableSize);
+
+    if ((!pFrame->pixels && !pFrame->indices) || !pColumns->cameraXs)
+    {
+        perror("Error: Unable to allocate a framebuffer");
+        render_destroyFramebuffer(pFrame);
+        return false;
+    }
+
+    pColumns->angleOffsets  = (int32_t *)(pColumns->cameraXs + pitch);
+    pColumns->fisheyes      = pColumns->angleOffsets + pitch;
+    pColumns->fieldCameraXs = (float *)(pColumns->fisheyes + pitch);
+    pFrame->depths          = pColumns->fieldCameraXs + pitch;
+    pFrame->fieldRow        = (uint32_t *)(pFrame->depths + pitch);
+    pFrame->sprites         = (struct ScreenSprite *)(pFrame->fieldRow + pitch);
+    buildColumnTables(pColumns, width, height, pitch);
+
+    pFrame->width       = width;
+    pFrame->height      = height;
+    pFrame->maxWidth    = width;
+    pFrame->maxHeight   = height;
+    pFrame->pitch       = pitch;
+    pFrame->indexPitch  = indexPitch;
+    pFrame->palette     = NULL;
+    pFrame->rayCount    = 0;
+    pFrame->field       = 0;
+    pFrame->dirty       = (struct FrameRegion) {0};
+    pFrame->viewItems   = 0;
+    pFrame->hasView     = false;
+    pFrame->isViewMixed = false;
+    return true;
+}
+
+
+/* Keeps the pitch, so the rows stay where they are and only the tables
+ * that depend on the view's shape change. Whatever was drawn before is
+ * the wrong size now, so nothing of it is kept.
+ */
+void render_setViewSize(struct Framebuffer *restrict pFrame, int width, int height)
+{
+    assert(width > 0 && width <= pFrame->maxWidth);
+    assert(height > 0 && height <= pFrame->maxHeight);
+
+    if (width == pFrame->width && height == pFrame->height)
+        return;
+
+    buildColumnTables(&pFrame->columns, width, height, pFrame->pitch);
+    pFrame->width       = width;
+    pFrame->height      = height;
+    pFrame->rayCount    = 0;
+    pFrame->field       = 0;
+    pFrame->dirty       = (struct FrameRegion) {0};
+    pFrame->hasView     = false;
+    pFrame->isViewMixed = false;
+}
+
+
+/* Room for every texture and a palette, so callers can size their level
+ * arenas.
+ */
+size_t render_getTexturesArenaSize(void)
+{
+    return TEXTURE_COUNT * texture_getArenaSize() + palette_getArenaSize();
+}
+
+
+/* Brick walls over a plain tiled floor and ceiling, in the colors the
+ * untextured renderer used to draw them, and a ball for every item. One
+ * palette covers all of them, so an indexed view needs no conversions.
+ */
+bool render_createTextures(
+    struct ViewTextures *restrict pTextures,
+    struct Arena *restrict pArena,
+    bool isIndexed
+) {
+    struct Texture *textures[TEXTURE_COUNT];
+    textures[0] = texture_createBricks(pArena);
+    textures[1] = texture_createTiles(pArena, FLOOR_COLOR);
+    textures[2] = texture_createTiles(pArena, CEILING_COLOR);
+    textures[3 + SPRITE_CRUMB] = texture_createOrb(pArena, CRUMB_COLOR);
+    textures[3 + SPRITE_EXIT]  = texture_createOrb(pArena, EXIT_COLOR);
+
+    for (int i = 0; i < TEXTURE_COUNT; ++i)
+    {
+        if (!textures[i])
+            return false;
+    }
+
+    pTextures->wall    = textures[0];
+    pTextures->floor   = textures[1];
+    pTextures->ceiling = textures[2];
+    pTextures->sprites[SPRITE_CRUMB] = textures[3 + SPRITE_CRUMB];
+    pTextures->sprites[SPRITE_EXIT]  = textures[3 + SPRITE_EXIT];
+    pTextures->palette = NULL;
+
+    if (!isIndexed)
+        return true;
+
+    pTextures->palette = palette_create(
+        (const struct Texture *const *)textures,
+        TEXTURE_COUNT,
+        pArena
+    );
+
+    for (int i = 0; pTextures->palette && i < TEXTURE_COUNT; ++i)
+    {
+        if (!texture_buildIndices(textures[i], pTextures->palette, pArena))
+            return false;
+    }
+
+    return pTextures->palette != NULL;
+}
+
+
+/* Places the camera plane perpendicular to the facing direction; the
+ * column tables already scale it to the view. Then hands the strips to
+ * the pool, or draws them in order without one, and does the same again
+ * for any sprites in view.
+ *
+ * Interlacing needs a view already in the framebuffer to fill in the
+ * other field, and one close enough that the seams between old and new
+ * columns stay a pixel or so wide.
+ */
+void render_drawView(
+    struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose,
+    const struct Maze *restrict pMaze,
+    const struct ViewTextures *restrict pTextures,
+    const struct SpriteSet *pSprites,
+    struct WorkerPool *pPool,
+    bool isInterlaced
+) {
+    assert(pFrame->indices ? pTextures->palette != NULL : pFrame->pixels != NULL);
+
+    uint64_t texelBytes[MAX_WORKER_THREADS] = { 0 };
+    float farDepths[MAX_WORKER_THREADS] = { 0 };
+    struct ViewJob job = {
+        .frame      = pFrame,
+        .pose       = pPose,
+        .maze       = pMaze,
+        .textures   = pTextures,
+        .texelBytes = texelBytes,
+        .farDepths  = farDepths,
+        .xDir       = (float)pPose->xDir,
+        .yDir       = (float)pPose->yDir,
+        .xPlane     = (float)-pPose->yDir,
+        .yPlane     = (float)pPose->xDir,
+        .viewAngle  = raycast_toFineAngle(atan2(pPose->yDir, pPose->xDir)),
+        .columnStep = 1
+    };
+    int stripCount = (pFrame->width + STRIP_WIDTH - 1) / STRIP_WIDTH;
+    pFrame->palette = pTextures->palette;
+
+    bool isField = isInterlaced && pFrame->hasView
+                   && getTurnShift(pFrame, pPose) <= MAX_INTERLACED_SHIFT;
+
+    if (isField)
+    {
+        job.field = pFrame->field;
+        job.columnStep = 2;
+    }
+
+    if (pPool)
+    {
+        workers_run(pPool, drawStrip, &job, stripCount);
+    }
+    else
+    {
+        for (int strip = 0; strip < stripCount; ++strip)
+            drawStrip(&job, strip, 0);
+    }
+
+    if (pSprites && sprites_getCount(pSprites) > 0)
+    {
+        float farDepth = 0.0f;
+        for (int i = 0; i < MAX_WORKER_THREADS; ++i)
+            farDepth = SDL_max(farDepth, farDepths[i]);
+
+        job.spriteCount = queueSprites(&job, pSprites, farDepth);
+        sortSprites(pFrame->sprites, job.spriteCount);
+        job.sprites = pFrame->sprites;
+    }
+
+    if (job.spriteCount > 0 && pPool)
+    {
+        workers_run(pPool, drawSpriteStrip, &job, stripCount);
+    }
+    else if (job.spriteCount > 0)
+    {
+        for (int strip = 0; strip < stripCount; ++strip)
+            drawSpriteStrip(&job, strip, 0);
+    }
+
+    pFrame->texelBytes = 0;
+    for (int i = 0; i < MAX_WORKER_THREADS; ++i)
+        pFrame->texelBytes += texelBytes[i];
+
+    // The other field was drawn from the last pose, whether interlaced or not
+    pFrame->rayCount = (pFrame->width - job.field + job.columnStep - 1) / job.columnStep;
+    uint32_t items = getItemGeneration(pSprites);
+    pFrame->isViewMixed = isField
+        && (!isSamePose(&pFrame->viewPose, pPose) || pFrame->viewItems != items);
+    pFrame->field ^= isField;
+
+    pFrame->dirty = (struct FrameRegion) {
+        .x = 0, .y = 0, .width = pFrame->width, .height = pFrame->height
+    };
+    pFrame->viewPose = *pPose;
+    pFrame->viewItems = items;
+    pFrame->hasView = true;
+}
+
+
+/* An interlaced view of a pose that's only half drawn from it gets its
+ * other half drawn next, however long the pose stays put.
+ */
+bool render_isViewCurrent(
+    const struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose,
+    const struct SpriteSet *pSprites
+) {
+    return pFrame->hasView
+        && !pFrame->isViewMixed
+        && isSamePose(&pFrame->viewPose, pPose)
+        && pFrame->viewItems == getItemGeneration(pSprites);
+}
+
+
+/* Every view covers the whole frame for now, so the region is either
+ * all of it or nothing; callers shouldn't count on that.
+ */
+bool render_takeDirtyRegion(
+    struct Framebuffer *restrict pFrame,
+    struct FrameRegion *restrict pRegion
+) {
+    *pRegion = pFrame->dirty;
+    pFrame->dirty = (struct FrameRegion) {0};
+    return pRegion->width > 0 && pRegion->height > 0;
+}
+
+
+/* Copies pixels a row at a time, or as a single block when the region
+ * spans whole rows and the row pitches happen to match. Indices can only
+ * go a row at a time, since each row expands to four times its size.
+ */
+void render_copyRegion(
+    const struct Framebuffer *restrict pFrame,
+    const struct FrameRegion *restrict pRegion,
+    void *restrict pDst,
+    int dstPitch
+) {
+    assert(pRegion->x >= 0 && pRegion->x + pRegion->width <= pFrame->width);
+    assert(pRegion->y >= 0 && pRegion->y + pRegion->height <= pFrame->height);
+
+    uint8_t *pRow = pDst;
+
+    if (pFrame->indices)
+    {
+        const uint8_t *pSrc =
+            pFrame->indices + (size_t)pRegion->y * pFrame->indexPitch + pRegion->x;
+
+        for (int y = 0; y < pRegion->height; ++y)
+        {
+            palette_expandRow(
+                pSrc,
+                (uint32_t *)pRow,
+                pRegion->width,
+                pFrame->palette->colors
+            );
+            pRow += dstPitch;
+            pSrc += pFrame->indexPitch;
+        }
+
+        return;
+    }
+
+    size_t srcPitch = (size_t)pFrame->pitch * sizeof(uint32_t);
+    size_t rowSize = (size_t)pRegion->width * sizeof(uint32_t);
+    const uint8_t *pSrc = (const uint8_t *)(
+        pFrame->pixels + (size_t)pRegion->y * pFrame->pitch + pRegion->x
+    );
+
+    if ((size_t)dstPitch == srcPitch && pRegion->width == pFrame->width)
+    {
+        memcpy(pRow, pSrc, srcPitch * pRegion->height);
+        return;
+    }
+
+    for (int y = 0; y < pRegion->height; ++y)
+    {
+        memcpy(pRow, pSrc, rowSize);
+        pRow += dstPitch;
+        pSrc += srcPitch;
+    }
+}
+
+
+/* Uses the aligned deallocator to match the aligned allocations.
+ */
+void render_destroyFramebuffer(struct Framebuffer *pFrame)
+{
+    assert(pFrame != NULL);
+
+    SDL_aligned_free(pFrame->pixels);
+    SDL_aligned_free(pFrame->indices);
+    SDL_aligned_free(pFrame->columns.cameraXs);
+    pFrame->pixels      = NULL;
+    pFrame->indices     = NULL;
+    pFrame->columns     = (struct ColumnTables) {0};
+    pFrame->depths      = NULL;
+    pFrame->sprites     = NULL;
+    pFrame->fieldRow    = NULL;
+    pFrame->palette     = NULL;
+    pFrame->width       = 0;
+    pFrame->height      = 0;
+    pFrame->maxWidth    = 0;
+    pFrame->maxHeight   = 0;
+    pFrame->pitch       = 0;
+    pFrame->indexPitch  = 0;
+    pFrame->texelBytes  = 0;
+    pFrame->rayCount    = 0;
+    pFrame->field       = 0;
+    pFrame->dirty       = (struct FrameRegion) {0};
+    pFrame->viewItems   = 0;
+    pFrame->hasView     = false;
+    pFrame->isViewMixed = false;
+}
+
+
+// === Static function definitions === //
+
+/* Scales the camera plane so that pixels come out square at any aspect
+ * ratio. The fixed-point kernel wants each ray as an angle from the
+ * view axis instead, plus its cosine to undo the fisheye effect. The
+ * field offsets are the same offsets, the even columns packed into the
+ * first half of the table and the odd ones into the second.
+ */
+static void buildColumnTables(
+    struct ColumnTables *restrict pColumns,
+    int width,
+    int height,
+    int pitch
+) {
+    double planeScale = 0.5 * width / height;
+
+    for (int x = 0; x < pitch; ++x)
+    {
+        double cameraX = (2.0 * x / width - 1.0) * planeScale;  // - left, + right
+        int32_t angleOffset = raycast_toFineAngle(atan(cameraX));
+        double fisheye = cos(angleOffset * (2.0 * SDL_PI_D / RAYCAST_FINE_ANGLES));
+
+        pColumns->cameraXs[x]     = (float)cameraX;
+        pColumns->angleOffsets[x] = angleOffset;
+        pColumns->fisheyes[x]     = (int32_t)lround(fisheye * RAYCAST_FIXED_ONE);
+    }
+
+    for (int i = 0; i < pitch / 2; ++i)
+    {
+        pColumns->fieldCameraXs[i]             = pColumns->cameraXs[2 * i];
+        pColumns->fieldCameraXs[pitch / 2 + i] = pColumns->cameraXs[2 * i + 1];
+    }
+}
+
+
+/* Near the middle of the view, turning by an angle slides the picture
+ * sideways by the angle times the view's height in pixels, since the
+ * camera plane is scaled to keep pixels square.
+ */
+static double getTurnShift(
+    const struct Framebuffer *restrict pFrame,
+    const struct PlayerPose *restrict pPose
+) {
+    const struct PlayerPose *pDrawn = &pFrame->viewPose;
+    double cross = pDrawn->xDir * pPose->yDir - pDrawn->yDir * pPose->xDir;
+    double dot = pDrawn->xDir * pPose->xDir + pDrawn->yDir * pPose->yDir;
+
+    return fabs(atan2(cross, dot)) * pFrame->height;
+}
+
+
+/* Compares the poses field by field rather than byte by byte, so that
+ * a direction of -0.0 still matches one of 0.0.
+ */
+static bool isSamePose(
+    const struct PlayerPose *restrict pLeft,
+    const struct PlayerPose *restrict pRight
+) {
+    return pLeft->xPos == pRight->xPos
+        && pLeft->yPos == pRight->yPos
+        && pLeft->xDir == pRight->xDir
+        && pLeft->yDir == pRight->yDir;
+}
+
+
+/* A view without items can't go stale over them.
+ */
+static inline uint32_t getItemGeneration(const struct SpriteSet *pSprites)
+{
+    return pSprites ? sprites_getGeneration(pSprites) : 0;
+}
+
+
+/* Every pixel of a row sees the floor (or the ceiling) the same distance
+ * away, in a straight line across the view. So each row takes one span,
+ * stepping its texture coordinates along the camera plane, and a mip
+ * level picked like a wall's at that distance. Rows above the horizon
+ * see the ceiling, mirroring the floor rows below it.
+ *
+ * Coordinates start from the corner of the cell the viewer is in, which
+ * keeps them small enough for floats anywhere in a big maze. Indexed
+ * rows are shaded through the palette's row for the same brightness.
+ *
+ * Interlaced spans cover only the columns being drawn, packed together
+ * in the strip's own stretch of the field row, and are then spread out
+ * to every other pixel of the row.
+ */
+static void drawFlats(const struct ViewJob *restrict pJob, int xFirst, int count)
+{
+    const struct Framebuffer *pFrame = pJob->frame;
+    const struct PlayerPose *pPose = pJob->pose;
+    const double halfHeight = 0.5 * pFrame->height;
+    const double xCell = pPose->xPos - floor(pPose->xPos);
+    const double yCell = pPose->yPos - floor(pPose->yPos);
+    const bool isField = pJob->columnStep > 1;
+    const int xField = xFirst + pJob->field;
+    const int fieldFirst = pJob->field * (pFrame->pitch / 2) + xFirst / 2;
+
+    struct FlatSpan span = {
+        .cameraXs = isField
+            ? pFrame->columns.fieldCameraXs + fieldFirst
+            : pFrame->columns.cameraXs + xFirst,
+        .count    = count
+    };
+
+    for (int y = 0; y < pFrame->height; ++y)
+    {
+        double rowCenter = y + 0.5 - halfHeight;  // below the horizon if positive
+        double rowDistance = halfHeight / SDL_max(fabs(rowCenter), 0.5);
+        const struct Texture *pTexture = rowCenter < 0.0
+            ? pJob->textures->ceiling
+            : pJob->textures->floor;
+
+        int mip = texture_pickLevel(pTexture, (int)(pFrame->height / rowDistance));
+        double side = pTexture->size >> mip;
+        span.texels    = pTexture->levels[mip];
+        span.sizeShift = pTexture->sizeShift - mip;
+        span.uStart    = (float)((xCell + rowDistance * pJob->xDir) * side);
+        span.vStart    = (float)((yCell + rowDistance * pJob->yDir) * side);
+        span.uStep     = (float)(rowDistance * pJob->xPlane * side);
+        span.vStep     = (float)(rowDistance * pJob->yPlane * side);
+        span.shade     = (uint32_t)(256.0 / (1.0 + 0.15 * rowDistance));
+
+        if (pFrame->indices)
+        {
+            uint8_t *pRow = pFrame->indices + (size_t)y * pFrame->indexPitch;
+            span.indexTexels = pTexture->indexLevels[mip];
+            span.shades  = palette_getShades(pFrame->palette, span.shade);
+            span.indices = isField
+                ? (uint8_t *)pFrame->fieldRow + xFirst / 2
+                : pRow + xFirst;
+            flats_drawSpanIndexed(&span);
+
+            for (int i = 0; isField && i < count; ++i)
+                pRow[xField + 2 * i] = span.indices[i];
+        }
+        else
+        {
+            uint32_t *pRow = pFrame->pixels + (size_t)y * pFrame->pitch;
+            span.pixels = isField ? pFrame->fieldRow + xFirst / 2 : pRow + xFirst;
+            flats_drawSpan(&span);
+
+            for (int i = 0; isField && i < count; ++i)
+                pRow[xField + 2 * i] = span.pixels[i];
+        }
+    }
+}
+
+
+/* Casts one ray per column of the strip being drawn as a single batch,
+ * so the SIMD kernels always have full lanes, and then draws the columns.
+ * Where each ray hit along its wall is worked out in double precision,
+ * since a float can't place a texel far from the origin of a big maze.
+ */
+static void drawStrip(void *pData, int stripIndex, int workerIndex)
+{
+    const struct ViewJob *pJob = pData;
+    struct Framebuffer *pFrame = pJob->frame;
+    const struct PlayerPose *pPose = pJob->pose;
+    int xFirst = stripIndex * STRIP_WIDTH;
+    int xField = xFirst + pJob->field;
+    int step = pJob->columnStep;
+    struct RayBatch rays;
+
+    PROFILE_BEGIN(ZONE_RAYCAST, workerIndex);
+
+    int stripWidth = SDL_min(pFrame->width - xFirst, STRIP_WIDTH);
+    rays.count = (stripWidth - pJob->field + step - 1) / step;
+
+    drawFlats(pJob, xFirst, rays.count);
+
+    // Pad to whole SIMD groups by repeating the last column's ray
+    int paddedCount = (rays.count + 7) & ~7;
+
+    const struct ColumnTables *pColumns = &pFrame->columns;
+
+    for (int i = 0; i < paddedCount; ++i)
+    {
+        int x = xField + (i < rays.count ? i : rays.count - 1) * step;
+        float cameraX = pColumns->cameraXs[x];
+        rays.xRayDirs[i] = pJob->xDir + pJob->xPlane * cameraX;
+        rays.yRayDirs[i] = pJob->yDir + pJob->yPlane * cameraX;
+        rays.angles[i]   = pJob->viewAngle + pColumns->angleOffsets[x];
+        rays.fisheyes[i] = pColumns->fisheyes[x];
+    }
+
+    raycast_castRays(pJob->maze, pPose->xPos, pPose->yPos, &rays);
+
+    size_t texelBytes = 0;
+    float farDepth = pJob->farDepths[workerIndex];
+
+    for (int i = 0; i < rays.count; ++i)
+    {
+        int x = xField + i * step;
+        pFrame->depths[x] = rays.distances[i];
+        farDepth = SDL_max(farDepth, rays.distances[i]);
+
+        double distance = rays.distances[i];
+        double wallX = rays.isYSides[i]
+            ? pPose->xPos + distance * rays.xRayDirs[i]
+            : pPose->yPos + distance * rays.yRayDirs[i];
+        wallX -= floor(wallX);
+
+        // Keep the texture facing the same way on opposite walls
+        if (rays.isYSides[i] ? rays.yRayDirs[i] > 0.0f : rays.xRayDirs[i] < 0.0f)
+            wallX = 1.0 - wallX;
+
+        texelBytes += drawColumn(
+            pFrame,
+            pJob->textures->wall,
+            x,
+            rays.distances[i],
+            rays.isYSides[i],
+            wallX
+        );
+    }
+
+    pJob->texelBytes[workerIndex] += texelBytes;
+    pJob->farDepths[workerIndex] = farDepth;
+
+    PROFILE_END(ZONE_RAYCAST, workerIndex);
+}
+
+
+/* No sprite past the farthest wall can be seen, so only the cells within
+ * that distance of the viewer, across the whole field of view, are
+ * looked at, a row at a time. Each sprite found is projected the way the
+ * walls are, and kept if it's in front of the viewer, nearer than the
+ * farthest wall, and at least partly across the view's columns. Any past
+ * the most the framebuffer has room for are left out.
+ */
+static int queueSprites(
+    const struct ViewJob *restrict pJob,
+    const struct SpriteSet *restrict pSprites,
+    float farDepth
+) {
+    const struct Framebuffer *pFrame = pJob->frame;
+    const struct PlayerPose *pPose = pJob->pose;
+    const struct Maze *pMaze = pJob->maze;
+    const double planeScale = 0.5 * pFrame->width / pFrame->height;
+    const double halfWidth = 0.5 * pFrame->width;
+    const double halfHeight = 0.5 * pFrame->height;
+
+    // Bound the triangle the view covers, out to the farthest wall
+    double xLeft = pPose->xPos + farDepth * (pJob->xDir - pJob->xPlane * planeScale);
+    double yLeft = pPose->yPos + farDepth * (pJob->yDir - pJob->yPlane * planeScale);
+    double xRight = pPose->xPos + farDepth * (pJob->xDir + pJob->xPlane * planeScale);
+    double yRight = pPose->yPos + farDepth * (pJob->yDir + pJob->yPlane * planeScale);
+    double xMin = SDL_min(pPose->xPos, SDL_min(xLeft, xRight)) - SPRITE_REACH;
+    double xMax = SDL_max(pPose->xPos, SDL_max(xLeft, xRight)) + SPRITE_REACH;
+    double yMin = SDL_min(pPose->yPos, SDL_min(yLeft, yRight)) - SPRITE_REACH;
+    double yMax = SDL_max(pPose->yPos, SDL_max(yLeft, yRight)) + SPRITE_REACH;
+
+    int xFirst = (int)SDL_max(xMin, 0.0);
+    int xLast = (int)SDL_min(xMax, pMaze->width - 1.0);
+    int yFirst = (int)SDL_max(yMin, 0.0);
+    int yLast = (int)SDL_min(yMax, pMaze->height - 1.0);
+    int count = 0;
+
+    for (int y = yFirst; y <= yLast && count < MAX_VIEW_SPRITES; ++y)
+    {
+        const struct Sprite *pFirst;
+        int rowCount = sprites_findInRow(pSprites, y, xFirst, xLast, &pFirst);
+
+        for (int i = 0; i < rowCount && count < MAX_VIEW_SPRITES; ++i)
+        {
+            const struct Sprite *pSprite = &pFirst[i];
+            double xOffset = pSprite->xPos - pPose->xPos;
+            double yOffset = pSprite->yPos - pPose->yPos;
+            double depth = xOffset * pJob->xDir + yOffset * pJob->yDir;
+
+            if (depth < MIN_SPRITE_DEPTH || depth >= farDepth)
+                continue;  // behind the viewer, or behind every wall
+
+            double across = xOffset * pJob->xPlane + yOffset * pJob->yPlane;
+            double xCenter = halfWidth * (1.0 + across / (depth * planeScale));
+            double pixelsPerCell = pFrame->height / depth;
+            int size = (int)(_spriteSizes[pSprite->kind] * pixelsPerCell);
+            int left = (int)floor(xCenter - 0.5 * size);
+
+            if (size <= 0 || left >= pFrame->width || left + size <= 0)
+                continue;  // too small, or off to one side
+
+            // The floor is half a cell below the eye
+            double bottom = halfHeight
+                            + (0.5 - _spriteLifts[pSprite->kind]) * pixelsPerCell;
+
+            pFrame->sprites[count++] = (struct ScreenSprite) {
+                .texture = pJob->textures->sprites[pSprite->kind],
+                .depth   = (float)depth,
+                .left    = left,
+                .top     = (int)floor(bottom) - size,
+                .size    = size,
+                .shade   = (uint32_t)(256.0 / (1.0 + 0.15 * depth)),
+                .key     = (uint32_t)(depth / farDepth * ((1u << DEPTH_KEY_BITS) - 1))
+                           ^ ((1u << DEPTH_KEY_BITS) - 1)
+            };
+        }
+    }
+
+    return count;
+}
+
+
+/* A least significant digit first radix sort, one byte of the key per
+ * pass, moving the sprites to the spare room and back. Each pass keeps
+ * the order of sprites with the same digit, so after the last one
+ * they're in order of their keys, farthest first.
+ */
+static void sortSprites(struct ScreenSprite *restrict sprites, int count)
+{
+    struct ScreenSprite *from = sprites;
+    struct ScreenSprite *to = sprites + MAX_VIEW_SPRITES;
+
+    for (int shift = 0; shift < DEPTH_KEY_BITS; shift += RADIX_BITS)
+    {
+        int starts[1 << RADIX_BITS];
+        memset(starts, 0, sizeof(starts));
+
+        for (int i = 0; i < count; ++i)
+            ++starts[(from[i].key >> shift) & ((1u << RADIX_BITS) - 1)];
+
+        int total = 0;
+        for (int digit = 0; digit < (1 << RADIX_BITS); ++digit)
+        {
+            int digitCount = starts[digit];
+            starts[digit] = total;
+            total += digitCount;
+        }
+
+        for (int i = 0; i < count; ++i)
+            to[starts[(from[i].key >> shift) & ((1u << RADIX_BITS) - 1)]++] = from[i];
+
+        struct ScreenSprite *swap = from;
+        from = to;
+        to = swap;
+    }
+}
+
+
+/* Draws each sprite's columns within the strip that are nearer than the
+ * wall in them, a texture column at a time like a wall slice, skipping
+ * the clear texels. Nearer sprites come later and cover farther ones.
+ * In indices, the clear texels are the ones indexed `PALETTE_CLEAR`.
+ * Interlaced views leave the columns they didn't cast alone.
+ */
+static void drawSpriteStrip(void *pData, int stripIndex, int workerIndex)
+{
+    const struct ViewJob *pJob = pData;
+    struct Framebuffer *pFrame = pJob->frame;
+    int xFirst = stripIndex * STRIP_WIDTH;
+    int xEnd = SDL_min(xFirst + STRIP_WIDTH, pFrame->width);
+    int pitch = pFrame->pitch;
+    int indexPitch = pFrame->indexPitch;
+    (void)workerIndex;  // only the profiler needs it
+
+    PROFILE_BEGIN(ZONE_SPRITES, workerIndex);
+
+    for (int i = 0; i < pJob->spriteCount; ++i)
+    {
+        const struct ScreenSprite *pSprite = &pJob->sprites[i];
+        int xStart = SDL_max(pSprite->left, xFirst);
+        int xStop = SDL_min(pSprite->left + pSprite->size, xEnd);
+        int yStart = SDL_max(pSprite->top, 0);
+        int yStop = SDL_min(pSprite->top + pSprite->size, pFrame->height);
+
+        const struct Texture *pTexture = pSprite->texture;
+        int mip = texture_pickLevel(pTexture, pSprite->size);
+        int side = pTexture->size >> mip;
+        uint32_t step = ((uint32_t)side << 16) / (uint32_t)pSprite->size;
+        uint32_t vFirst = (uint32_t)(yStart - pSprite->top) * step;
+
+        // Start on the first column of the field being drawn
+        int xDrawn = xStart + ((xStart - pJob->field) & (pJob->columnStep - 1));
+
+        for (int x = xDrawn; x < xStop; x += pJob->columnStep)
+        {
+            if (pSprite->depth >= pFrame->depths[x])
+                continue;  // behind the wall in this column
+
+            uint32_t u = (uint32_t)(x - pSprite->left) * step >> 16;
+            size_t columnStart = (size_t)u << (pTexture->sizeShift - mip);
+            uint32_t v = vFirst;
+
+            if (pFrame->indices)
+            {
+                const uint8_t *restrict texels = pTexture->indexLevels[mip] + columnStart;
+                const uint8_t *restrict shades =
+                    palette_getShades(pFrame->palette, pSprite->shade);
+                uint8_t *restrict pIndex =
+                    pFrame->indices + (size_t)yStart * indexPitch + x;
+
+                for (int y = yStart; y < yStop; ++y, pIndex += indexPitch, v += step)
+                {
+                    uint8_t texel = texels[v >> 16];
+
+                    if (texel != PALETTE_CLEAR)
+                        *pIndex = shades[texel];
+                }
+
+                continue;
+            }
+
+            const uint32_t *restrict texels = pTexture->levels[mip] + columnStart;
+            uint32_t *restrict pPixel = pFrame->pixels + (size_t)yStart * pitch + x;
+
+            for (int y = yStart; y < yStop; ++y, pPixel += pitch, v += step)
+            {
+                uint32_t texel = texels[v >> 16];
+
+                if (texel >= 0x80000000u)  // at least half opaque
+                    *pPixel = texture_shadeColor(texel, pSprite->shade);
+            }
+        }
+    }
+
+    PROFILE_END(ZONE_SPRITES, workerIndex);
+}
+
+
+/* Projects the wall slice onto the column, centered on the horizon, and
+ * darkens it with distance, leaving the floor and ceiling around it.
+ * North- and south-facing walls are drawn a bit darker than east- and
+ * west-facing ones so corners stand out.
+ *
+ * The texels of a texture column sit next to each other in memory, and
+ * the mip level is picked to have about as many texels as the slice has
+ * pixels, so a slice reads only the few cache lines it needs. Indexed
+ * texels take a quarter of the room, and so a quarter of the lines.
+ */
+static size_t drawColumn(
+    struct Framebuffer *restrict pFrame,
+    const struct Texture *restrict pTexture,
+    int x,
+    float distance,
+    bool isYSide,
+    double wallX
+) {
+    if (distance < MIN_WALL_DISTANCE)
+        distance = MIN_WALL_DISTANCE;
+
+    int height = pFrame->height;
+    int lineHeight = (int)(height / distance);
+    int lineTop = (height - lineHeight) / 2;
+    int wallTop = lineTop;
+    int wallBottom = lineTop + lineHeight;
+
+    if (wallTop < 0)
+        wallTop = 0;
+    if (wallBottom > height)
+        wallBottom = height;
+
+    uint32_t level = (uint32_t)(256.0f / (1.0f + 0.15f * distance));
+    if (isYSide)
+        level = level * 3 / 4;
+
+    // Step down the texture column in Q16.16 texels per pixel
+    int mip = texture_pickLevel(pTexture, lineHeight);
+    int side = pTexture->size >> mip;
+    int u = (int)(wallX * side);
+    if (u >= side)
+        u = side - 1;
+
+    size_t columnStart = (size_t)u << (pTexture->sizeShift - mip);
+    uint32_t vStep = lineHeight > 0
+        ? ((uint32_t)side << 16) / (uint32_t)lineHeight
+        : 0;
+    uint32_t vFirst = (uint32_t)(wallTop - lineTop) * vStep;
+    uint32_t v = vFirst;
+    size_t texelSize;
+
+    if (pFrame->indices)
+    {
+        const uint8_t *restrict texels = pTexture->indexLevels[mip] + columnStart;
+        const uint8_t *restrict shades = palette_getShades(pFrame->palette, level);
+        int pitch = pFrame->indexPitch;
+        uint8_t *restrict pIndex = pFrame->indices + (size_t)wallTop * pitch + x;
+
+        for (int y = wallTop; y < wallBottom; ++y, pIndex += pitch, v += vStep)
+            *pIndex = shades[texels[v >> 16]];
+
+        texelSize = sizeof(uint8_t);
+    }
+    else
+    {
+        const uint32_t *restrict texels = pTexture->levels[mip] + columnStart;
+        int pitch = pFrame->pitch;
+        uint32_t *restrict pPixel = pFrame->pixels + (size_t)wallTop * pitch + x;
+
+        for (int y = wallTop; y < wallBottom; ++y, pPixel += pitch, v += vStep)
+            *pPixel = texture_shadeColor(texels[v >> 16], level);
+
+        texelSize = sizeof(uint32_t);
+    }
+
+    if (wallBottom <= wallTop)
+        return 0;
+
+    // Count whole cache lines, from the first texel read to the last
+    size_t first = (columnStart + (vFirst >> 16)) * texelSize;
+    size_t last = (columnStart + ((v - vStep) >> 16)) * texelSize;
+    return (last / CACHE_LINE_SIZE - first / CACHE_LINE_SIZE + 1) * CACHE_LINE_SIZE;
+}
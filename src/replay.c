@@ -0,0 +1,409 @@
+/**
+ * @file  replay.c
+ * @brief Implementation of the replay module.
+ *
+ * Defines the interface for the replay module. A log file is a short
+ * header followed by one fixed-size record per action, in the order
+ * they happened, all in the recording machine's byte order. Recording
+ * appends through stdio's buffer, so writing a record rarely touches
+ * the disk; playback reads the whole log into memory up front.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <string.h>    // for memcmp and memcpy
+#include <math.h>      // for isfinite
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for logging
+#include "replay.h"    // the header implemented here
+#include "defines.h"   // for the simulation rate
+#include "utils.h"     // for freeing pointers
+
+#define REPLAY_FILE_VERSION  1           // bump on any change to the layout
+#define REPLAY_FILE_MAGIC    "MZREPLAY"  // first 8 bytes of every log file
+#define BYTE_ORDER_MARK      0x01020304u // reads back swapped on the wrong
+                                         // endianness
+
+// Start of a log file, 40 bytes with no padding
+struct ReplayFileHeader
+{
+    char     magic[8];        // REPLAY_FILE_MAGIC, without the terminator
+    uint32_t byteOrderMark;   // BYTE_ORDER_MARK in the writer's byte order
+    uint32_t version;         // REPLAY_FILE_VERSION
+    uint64_t mazeSeed;        // seed of the maze played
+    int32_t  mazeWidth;       // cells per row of the maze played
+    int32_t  mazeHeight;      // rows of the maze played
+    uint32_t stepsPerSecond;  // simulation rate while recording
+    uint32_t reserved;        // zero
+};
+
+// One action in a log file, 12 bytes with no padding
+struct ReplayRecord
+{
+    uint32_t step;       // simulation steps taken before the action
+    uint32_t command;    // enum UserCommand
+    float    magnitude;  // as in struct GameAction
+};
+
+// A log being recorded to a file or played back from memory
+struct Replay
+{
+    FILE                   *pFile;        // file being recorded; NULL if playing
+    const char             *path;         // path to the file, for errors
+    struct ReplayFileHeader header;       // header written or read
+    struct ReplayRecord    *records;      // every record, if playing
+    size_t                  recordCount;  // number of records, if playing
+    size_t                  nextRecord;   // index of the next one to play
+    uint32_t                lastStep;     // step of the last record
+};
+
+
+// === Static function prototypes === //
+
+// Checks the header of a log file, printing why it's invalid if it is
+static bool isValidHeader(
+    const struct ReplayFileHeader *restrict pHeader,
+    const char *restrict path
+);
+
+// Checks that every record is a real command and that steps never go down
+static bool areValidRecords(
+    const struct ReplayRecord *records,
+    size_t count,
+    const char *restrict path
+);
+
+
+// === Interface function definitions === //
+
+/* Writes the header right away, so that a crash mid-game still leaves a
+ * log that can be played up to its last buffered record.
+ */
+struct Replay *replay_startRecording(
+    const char *restrict path,
+    const struct Maze *restrict pMaze
+) {
+    struct Replay *pReplay = calloc(1, sizeof(*pReplay));
+
+    if (!pReplay)
+    {
+        perror("Error: Unable to allocate an input recording");
+        return NULL;
+    }
+
+    pReplay->path = path;
+    pReplay->header = (struct ReplayFileHeader) {
+        .byteOrderMark  = BYTE_ORDER_MARK,
+        .version        = REPLAY_FILE_VERSION,
+        .mazeSeed       = pMaze->seed,
+        .mazeWidth      = pMaze->width,
+        .mazeHeight     = pMaze->height,
+        .stepsPerSecond = STEPS_PER_SECOND
+    };
+    memcpy(pReplay->header.magic, REPLAY_FILE_MAGIC, sizeof(pReplay->header.magic));
+
+    pReplay->pFile = fopen(path, "wb");
+
+    if (!pReplay->pFile)
+    {
+        fprintf(stderr, "Error: Unable to create %s: ", path);
+        perror(NULL);
+        freeMemory((void **)&pReplay);
+        return NULL;
+    }
+
+    if (fwrite(&pReplay->header, sizeof(pReplay->header), 1, pReplay->pFile) != 1)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", path);
+        perror(NULL);
+        fclose(pReplay->pFile);
+        freeMemory((void **)&pReplay);
+        return NULL;
+    }
+
+    return pReplay;
+}
+
+
+/* Relies on stdio to batch the small writes.
+ */
+bool replay_record(
+    struct Replay *restrict pReplay,
+    uint32_t step,
+    const struct GameAction *restrict pAction
+) {
+    assert(pReplay->pFile != NULL && step >= pReplay->lastStep);
+
+    struct ReplayRecord record = {
+        .step      = step,
+        .command   = pAction->command,
+        .magnitude = pAction->magnitude
+    };
+
+    if (fwrite(&record, sizeof(record), 1, pReplay->pFile) != 1)
+    {
+        fprintf(stderr, "Error: Unable to write %s: ", pReplay->path);
+        perror(NULL);
+        return false;
+    }
+
+    pReplay->lastStep = step;
+    return true;
+}
+
+
+/* Reads everything up front, so that playback never waits on the disk,
+ * and validates everything before handing any of it out.
+ */
+struct Replay *replay_open(const char *restrict path)
+{
+    FILE *pFile = fopen(path, "rb");
+
+    if (!pFile)
+    {
+        fprintf(stderr, "Error: Unable to open %s: ", path);
+        perror(NULL);
+        return NULL;
+    }
+
+    struct Replay *pReplay = calloc(1, sizeof(*pReplay));
+
+    if (!pReplay)
+    {
+        perror("Error: Unable to allocate an input log");
+        fclose(pFile);
+        return NULL;
+    }
+
+    pReplay->path = path;
+
+    if (fread(&pReplay->header, sizeof(pReplay->header), 1, pFile) != 1)
+    {
+        fprintf(stderr, "Error: %s is too short to be an input log.\n", path);
+        fclose(pFile);
+        freeMemory((void **)&pReplay);
+        return NULL;
+    }
+
+    // Find out how many records follow the header
+    long fileSize = -1;
+    if (fseek(pFile, 0, SEEK_END) == 0)
+        fileSize = ftell(pFile);
+
+    size_t recordBytes = fileSize >= 0
+        ? (size_t)fileSize - sizeof(pReplay->header)
+        : 0;
+    pReplay->recordCount = recordBytes / sizeof(struct ReplayRecord);
+
+    bool isValid = isValidHeader(&pReplay->header, path);
+
+    if (isValid && (fileSize < 0 || recordBytes % sizeof(struct ReplayRecord) != 0))
+    {
+        fprintf(stderr, "Error: Unable to load %s: it's truncated.\n", path);
+        isValid = false;
+    }
+
+    if (isValid)
+    {
+        pReplay->records = malloc(recordBytes > 0 ? recordBytes : 1);
+
+        if (!pReplay->records)
+        {
+            perror("Error: Unable to allocate an input log");
+            isValid = false;
+        }
+    }
+
+    if (isValid)
+    {
+        fseek(pFile, (long)sizeof(pReplay->header), SEEK_SET);
+
+        if (fread(pReplay->records, 1, recordBytes, pFile) != recordBytes)
+        {
+            fprintf(stderr, "Error: Unable to read %s.\n", path);
+            isValid = false;
+        }
+    }
+
+    fclose(pFile);
+
+    if (!isValid || !areValidRecords(pReplay->records, pReplay->recordCount, path))
+    {
+        replay_destroy(&pReplay);
+        return NULL;
+    }
+
+    if (pReplay->recordCount > 0)
+        pReplay->lastStep = pReplay->records[pReplay->recordCount - 1].step;
+
+    return pReplay;
+}
+
+
+/* A loaded maze file wins over the log; it's only checked afterward.
+ */
+void replay_applyToOptions(
+    const struct Replay *restrict pReplay,
+    struct GameOptions *restrict pOptions
+) {
+    if (pOptions->loadPath)
+        return;
+
+    pOptions->mazeWidth  = pReplay->header.mazeWidth;
+    pOptions->mazeHeight = pReplay->header.mazeHeight;
+    pOptions->seed       = pReplay->header.mazeSeed;
+    pOptions->hasSeed    = true;
+}
+
+
+/* The seed and size pin down a generated maze; the seed is saved with
+ * maze files too, so this catches loading the wrong one.
+ */
+bool replay_isSameMaze(
+    const struct Replay *restrict pReplay,
+    const struct Maze *restrict pMaze
+) {
+    bool isSame = pMaze->width == pReplay->header.mazeWidth
+                  && pMaze->height == pReplay->header.mazeHeight
+                  && pMaze->seed == pReplay->header.mazeSeed;
+
+    if (!isSame)
+    {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "%s was recorded in a different maze; it won't play out the same.",
+            pReplay->path
+        );
+    }
+
+    return isSame;
+}
+
+
+/* Records are sorted by step, so the next one due is always at the front.
+ */
+bool replay_loadNextAction(
+    struct Replay *restrict pReplay,
+    uint32_t step,
+    struct GameAction *restrict pAction
+) {
+    if (pReplay->nextRecord >= pReplay->recordCount)
+        return false;
+
+    const struct ReplayRecord *pRecord = &pReplay->records[pReplay->nextRecord];
+
+    if (pRecord->step > step)
+        return false;
+
+    pAction->command   = (enum UserCommand)pRecord->command;
+    pAction->magnitude = pRecord->magnitude;
+    ++pReplay->nextRecord;
+
+    return true;
+}
+
+
+/* The recorder appends a final quit when it stops, so the last record
+ * marks the end of the session.
+ */
+uint32_t replay_getStepCount(const struct Replay *restrict pReplay)
+{
+    return pReplay->lastStep;
+}
+
+
+/* Buffered records only hit the disk on closing, which can fail too.
+ */
+void replay_destroy(struct Replay **ppReplay)
+{
+    assert(ppReplay != NULL);
+
+    if (*ppReplay)
+    {
+        if ((*ppReplay)->pFile && fclose((*ppReplay)->pFile) != 0)
+        {
+            fprintf(stderr, "Error: Unable to write %s: ", (*ppReplay)->path);
+            perror(NULL);
+        }
+
+        freeMemory((void **)&(*ppReplay)->records);
+        freeMemory((void **)ppReplay);
+    }
+}
+
+
+// === Static function definitions === //
+
+/* Checks everything playback relies on in the order a reader would
+ * want to hear about it.
+ */
+static bool isValidHeader(
+    const struct ReplayFileHeader *restrict pHeader,
+    const char *restrict path
+) {
+    if (memcmp(pHeader->magic, REPLAY_FILE_MAGIC, sizeof(pHeader->magic)) != 0)
+    {
+        fprintf(stderr, "Error: %s is not an input log.\n", path);
+        return false;
+    }
+
+    if (pHeader->byteOrderMark != BYTE_ORDER_MARK)
+    {
+        fprintf(stderr, "Error: %s was recorded with the other byte order.\n", path);
+        return false;
+    }
+
+    if (pHeader->version != REPLAY_FILE_VERSION)
+    {
+        fprintf(
+            stderr,
+            "Error: %s is version %u; only version %d is supported.\n",
+            path,
+            (unsigned)pHeader->version,
+            REPLAY_FILE_VERSION
+        );
+        return false;
+    }
+
+    if (pHeader->stepsPerSecond != STEPS_PER_SECOND)
+    {
+        fprintf(
+            stderr,
+            "Error: %s was recorded at %u steps per second, not %d.\n",
+            path,
+            (unsigned)pHeader->stepsPerSecond,
+            STEPS_PER_SECOND
+        );
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Out-of-range commands would index past the held-command table, and
+ * steps going down would stall playback forever.
+ */
+static bool areValidRecords(
+    const struct ReplayRecord *records,
+    size_t count,
+    const char *restrict path
+) {
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool isValid = records[i].command < NUM_COMMANDS
+                       && isfinite(records[i].magnitude)
+                       && (i == 0 || records[i].step >= records[i - 1].step);
+
+        if (!isValid)
+        {
+            fprintf(stderr, "Error: Action %zu in %s is corrupt.\n", i, path);
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file  resolution.c
+ * @brief Implementation of the resolution module.
+ *
+ * Defines the interface for the resolution module and provides an
+ * internal helper function to predict how a change of scale changes the
+ * time a view takes, which goes with the number of pixels drawn.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stddef.h>      // for NULL
+#include <assert.h>      // for debugging assertions
+#include "resolution.h"  // the header implemented here
+
+#define SAMPLE_WEIGHT  0.1   // share of each new sample in the moving average
+#define RAISE_MARGIN   0.8   // share of the budget a higher scale must fit in
+#define SETTLE_FRAMES  30    // samples between changes, for the average to catch up
+
+// Fractions of the window's width and height, one per step down
+static const double _scales[] = { 1.0, 0.9, 0.8, 0.7, 0.6, 0.5 };
+
+#define LEVEL_COUNT  ( (int)(sizeof(_scales) / sizeof(_scales[0])) )
+
+
+// === Static function prototypes === //
+
+// Returns how many times as many pixels one level draws as another
+static double getPixelRatio(int toLevel, int fromLevel);
+
+
+// === Interface function definitions === //
+
+/* Waits out the first few frames, which tend to be slow while caches
+ * and threads warm up, before letting the scale change.
+ */
+void resolution_init(struct ResolutionScaler *pScaler, double budget)
+{
+    assert(pScaler != NULL);
+    assert(budget >= 0.0);
+
+    *pScaler = (struct ResolutionScaler) {
+        .budget       = budget,
+        .average      = 0.0,
+        .level        = 0,
+        .settleFrames = SETTLE_FRAMES
+    };
+}
+
+
+/* Drops one step as soon as the average runs over the budget, but only
+ * raises one once the average, scaled up to the pixels of the step
+ * above, would still leave a margin. Between the two, it stays put.
+ * After a change, the average is scaled to the new pixel count rather
+ * than started over, and the next change waits for it to settle.
+ */
+bool resolution_addSample(struct ResolutionScaler *pScaler, double seconds)
+{
+    assert(pScaler != NULL);
+
+    if (pScaler->budget <= 0.0)
+        return false;
+
+    if (pScaler->average <= 0.0)
+        pScaler->average = seconds;
+    else
+        pScaler->average += SAMPLE_WEIGHT * (seconds - pScaler->average);
+
+    if (pScaler->settleFrames > 0)
+    {
+        --pScaler->settleFrames;
+        return false;
+    }
+
+    int level = pScaler->level;
+
+    if (pScaler->average > pScaler->budget && level < LEVEL_COUNT - 1)
+    {
+        ++level;
+    }
+    else if (level > 0
+             && pScaler->average * getPixelRatio(level - 1, level)
+                < pScaler->budget * RAISE_MARGIN)
+    {
+        --level;
+    }
+
+    if (level == pScaler->level)
+        return false;
+
+    pScaler->average *= getPixelRatio(level, pScaler->level);
+    pScaler->level = level;
+    pScaler->settleFrames = SETTLE_FRAMES;
+    return true;
+}
+
+
+/* Looks the scale up for the current level.
+ */
+double resolution_getScale(const struct ResolutionScaler *pScaler)
+{
+    assert(pScaler != NULL);
+    return _scales[pScaler->level];
+}
+
+
+// === Static function definitions === //
+
+/* Both sides scale, so the pixels go with the square of the scale.
+ */
+static double getPixelRatio(int toLevel, int fromLevel)
+{
+    double ratio = _scales[toLevel] / _scales[fromLevel];
+    return ratio * ratio;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file  rng.c
+ * @brief Implementation of the rng module.
+ *
+ * Defines the interface for the rng module. Drawing the next number is
+ * inlined from the header, since the maze generator calls it in its
+ * innermost loop; only the rarely called functions live here.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stddef.h>  // for NULL
+#include <assert.h>  // for debugging assertions
+#include "rng.h"     // the header implemented here
+
+
+// === Interface function definitions === //
+
+/* Expands the seed into the full state with splitmix64, as recommended
+ * by the xoshiro authors. It never repeats an output within four calls,
+ * so at most one word of the state is zero and every seed is valid.
+ */
+void rng_seed(struct Rng *pRng, uint64_t seed)
+{
+    assert(pRng != NULL);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        pRng->state[i] = z ^ (z >> 31);
+    }
+}
+
+
+/* Lemire's multiply-and-shift, with rejection of the few low products
+ * that would make some numbers come up more often than others.
+ */
+uint32_t rng_nextBelow(struct Rng *pRng, uint32_t bound)
+{
+    assert(bound > 0);
+
+    uint64_t product = (rng_next(pRng) >> 32) * bound;
+
+    if ((uint32_t)product < bound)
+    {
+        uint32_t threshold = -bound % bound;
+
+        while ((uint32_t)product < threshold)
+            product = (rng_next(pRng) >> 32) * bound;
+    }
+
+    return (uint32_t)(product >> 32);
+}
@@ -0,0 +1,627 @@
+/**
+ * @file  solver.c
+ * @brief Implementation of the solver module.
+ *
+ * Defines the interface for the solver module and provides internal
+ * helper functions to step between cells, keep bits per cell, grow one
+ * level of a breadth-first search, and keep the open set of A* as a
+ * binary heap.
+ *
+ * Cells are packed into 32 bits as their row above their column, which
+ * `MAZE_MAX_SIZE` leaves room for. Bits per cell are laid out in 8x8
+ * tiles, like the walls, so the bits of neighboring cells mostly share
+ * a word.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <string.h>    // for memset and memcpy
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for atomics
+#include "solver.h"    // the header implemented here
+#include "defines.h"   // for the cache line size
+
+#define CELL_BITS        15    // bits for the column of a packed cell
+#define CELL_MASK        ( (1u << CELL_BITS) - 1 )
+#define STEP_SHIFT       30    // bits under the step stored with an open cell
+#define FRONTIER_SPAN    16    // frontier cells allowed per cell along the sides
+#define OPEN_SPAN        64    // open cells allowed per cell along the sides
+#define TASK_CELLS       128   // frontier cells each worker task expands
+#define PARALLEL_CELLS   1024  // smallest frontier worth splitting across threads
+
+// Packs a cell's column and row into 32 bits
+#define PACK_CELL(x, y)  ( (uint32_t)(y) << CELL_BITS | (uint32_t)(x) )
+
+// One side of the two-way search
+struct Side
+{
+    SDL_AtomicU32 *visited;  // one bit per cell, set once the side reaches it
+    uint32_t      *cells;    // the frontier, as packed cells
+    size_t         count;    // cells in the frontier
+    int64_t        level;    // steps from the side's first cell to its frontier
+};
+
+// What the tasks growing one level of the search share
+struct LevelJob
+{
+    const struct Maze *maze;         // the maze being searched
+    struct Side       *side;         // the side being grown
+    const struct Side *other;        // the side it may meet
+    uint32_t          *nextCells;    // each thread's stretch of the next frontier
+    size_t             stretchSize;  // cells per thread's stretch
+    size_t             nextCounts[MAX_WORKER_THREADS];  // cells in each stretch
+    SDL_AtomicInt      isMet;        // did the side reach the other's cells?
+    SDL_AtomicInt      isFull;       // did a stretch run out of room?
+};
+
+// A cell waiting in the open set of A*
+struct OpenCell
+{
+    uint32_t cost;  // steps to it so far, plus the estimate left
+    uint32_t cell;  // packed cell, with its step back on top
+};
+
+// The open set of A*, and how to estimate costs for it
+struct OpenSet
+{
+    struct OpenCell *cells;     // binary heap, cheapest first
+    size_t           count;     // cells in the heap
+    size_t           capacity;  // most cells the heap can hold
+    int              xGoal;     // column the estimates are to
+    int              yGoal;     // row the estimates are to
+};
+
+// Steps to the next cell east, south, west, and north
+static const int _xSteps[4] = { 1, 0, -1,  0 };
+static const int _ySteps[4] = { 0, 1,  0, -1 };
+
+
+// === Static function prototypes === //
+
+// Gets the bytes of one bit per cell for a maze, in tiles like the walls
+static size_t getBitsSize(int width, int height);
+
+// Gets the most cells a frontier or open set may hold for a maze
+static size_t getCapacity(int width, int height, int span);
+
+// Gets the index of a cell's bit in a set of bits per cell
+static inline size_t getBitIndex(int tilesPerRow, int x, int y);
+
+// Checks whether there's no wall between a cell and the next one over
+static inline bool isOpen(
+    const struct Maze *restrict pMaze,
+    int x,
+    int y,
+    enum SolverStep step
+);
+
+// Sets a cell's bit unless another thread beat it to it; true if it did
+static inline bool claimBit(SDL_AtomicU32 *bits, size_t index);
+
+// Grows one task's share of the frontier by a step
+static void growCells(void *pData, int taskIndex, int workerIndex);
+
+// Gets the Manhattan distance from a packed cell to the goal
+static inline uint32_t estimateCost(const struct OpenSet *pSet, uint32_t cell);
+
+// Checks whether one open cell should come out of the heap before another
+static inline bool isCheaper(
+    const struct OpenSet *pSet,
+    struct OpenCell a,
+    struct OpenCell b
+);
+
+// Adds a cell to the open set; false if it's full
+static bool pushOpenCell(struct OpenSet *restrict pSet, struct OpenCell openCell);
+
+// Removes the cheapest cell from the open set, which must not be empty
+static struct OpenCell popOpenCell(struct OpenSet *restrict pSet);
+
+
+// === Interface function definitions === //
+
+/* Counts the worst-case padding before each block too.
+ */
+size_t solver_getMeasureScratchSize(int width, int height)
+{
+    size_t frontierSize = getCapacity(width, height, FRONTIER_SPAN) * sizeof(uint32_t);
+    return 2 * (getBitsSize(width, height) + CACHE_LINE_SIZE)
+           + 3 * (frontierSize + ARENA_ALIGNMENT);
+}
+
+
+/* The first cells of both sides claim their bits up front, so reaching
+ * either counts as meeting the other side. The first level at which the
+ * sides meet gives the shortest path; any cell one side reaches there is
+ * on the other side's frontier, or they'd have met a level sooner.
+ *
+ * Each thread writes the cells it reaches to its own stretch of a shared
+ * buffer, and the stretches are packed into the side's frontier after
+ * the level is done. A level too small for the pool runs on the calling
+ * thread, with the whole buffer as its stretch.
+ */
+bool solver_measurePath(
+    const struct Maze *restrict pMaze,
+    int xFrom,
+    int yFrom,
+    int xTo,
+    int yTo,
+    struct WorkerPool *pWorkers,
+    struct Arena *restrict pScratch,
+    int64_t *restrict pLength
+) {
+    assert(pMaze != NULL && pScratch != NULL && pLength != NULL);
+    assert(xFrom >= 0 && xFrom < pMaze->width && yFrom >= 0 && yFrom < pMaze->height);
+    assert(xTo >= 0 && xTo < pMaze->width && yTo >= 0 && yTo < pMaze->height);
+
+    size_t scratchMark = arena_getMark(pScratch);
+    size_t bitsSize = getBitsSize(pMaze->width, pMaze->height);
+    size_t capacity = getCapacity(pMaze->width, pMaze->height, FRONTIER_SPAN);
+    struct Side sides[2];
+    struct LevelJob job;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        sides[i].visited = arena_allocAligned(pScratch, bitsSize, CACHE_LINE_SIZE);
+        sides[i].cells   = arena_alloc(pScratch, capacity * sizeof(uint32_t));
+        sides[i].count   = 1;
+        sides[i].level   = 0;
+    }
+
+    job.nextCells = arena_alloc(pScratch, capacity * sizeof(uint32_t));
+
+    if (!sides[0].visited || !sides[0].cells || !sides[1].visited || !sides[1].cells
+        || !job.nextCells)
+    {
+        fprintf(stderr, "Error: Not enough scratch space to solve the maze.\n");
+        arena_rewind(pScratch, scratchMark);
+        return false;
+    }
+
+    *pLength = -1;
+
+    if (xFrom == xTo && yFrom == yTo)
+    {
+        *pLength = 0;
+        arena_rewind(pScratch, scratchMark);
+        return true;
+    }
+
+    memset(sides[0].visited, 0, bitsSize);
+    memset(sides[1].visited, 0, bitsSize);
+    sides[0].cells[0] = PACK_CELL(xFrom, yFrom);
+    sides[1].cells[0] = PACK_CELL(xTo, yTo);
+    claimBit(sides[0].visited, getBitIndex(pMaze->tilesPerRow, xFrom, yFrom));
+    claimBit(sides[1].visited, getBitIndex(pMaze->tilesPerRow, xTo, yTo));
+
+    int threadCount = pWorkers ? workers_getThreadCount(pWorkers) : 1;
+    bool isSolved = true;
+    job.maze = pMaze;
+
+    while (sides[0].count > 0 && sides[1].count > 0)
+    {
+        bool isFirstSmaller = sides[0].count <= sides[1].count;
+        struct Side *pSide = isFirstSmaller ? &sides[0] : &sides[1];
+        bool isParallel = pWorkers && threadCount > 1 && pSide->count >= PARALLEL_CELLS;
+        int taskCount = (int)((pSide->count + TASK_CELLS - 1) / TASK_CELLS);
+
+        job.side = pSide;
+        job.other = isFirstSmaller ? &sides[1] : &sides[0];
+        job.stretchSize = isParallel ? capacity / threadCount : capacity;
+        memset(job.nextCounts, 0, sizeof(job.nextCounts));
+        SDL_SetAtomicInt(&job.isMet, 0);
+        SDL_SetAtomicInt(&job.isFull, 0);
+
+        if (isParallel)
+        {
+            workers_run(pWorkers, growCells, &job, taskCount);
+        }
+        else
+        {
+            for (int i = 0; i < taskCount; ++i)
+                growCells(&job, i, 0);
+        }
+
+        if (SDL_GetAtomicInt(&job.isFull))
+        {
+            fprintf(stderr, "Error: The search outgrew its scratch space.\n");
+            isSolved = false;
+            break;
+        }
+
+        if (SDL_GetAtomicInt(&job.isMet))
+        {
+            *pLength = sides[0].level + sides[1].level + 1;
+            break;
+        }
+
+        // Pack the threads' stretches into the side's next frontier
+        pSide->count = 0;
+
+        for (int i = 0; i < threadCount; ++i)
+        {
+            memcpy(
+                pSide->cells + pSide->count,
+                job.nextCells + i * job.stretchSize,
+                job.nextCounts[i] * sizeof(uint32_t)
+            );
+            pSide->count += job.nextCounts[i];
+        }
+
+        ++pSide->level;
+    }
+
+    arena_rewind(pScratch, scratchMark);
+    return isSolved;
+}
+
+
+/* Counts the worst-case padding before each block too.
+ */
+size_t solver_getFindScratchSize(int width, int height)
+{
+    size_t openSize = getCapacity(width, height, OPEN_SPAN) * sizeof(struct OpenCell);
+    return 4 * (getBitsSize(width, height) + CACHE_LINE_SIZE)
+           + openSize + ARENA_ALIGNMENT;
+}
+
+
+/* Each cell takes the step back toward the cell it was reached from as
+ * it leaves the open set, which is when A* settles its shortest path,
+ * given an estimate that never drops by more than a step per step. The
+ * step is kept in two sets of bits, one per bit of the step. Until then,
+ * it rides along in the top bits of the packed cell.
+ *
+ * Ties go to the cell estimated closer to the goal, which follows one
+ * corridor to its end before trying the next one.
+ */
+bool solver_findPath(
+    const struct Maze *restrict pMaze,
+    int xFrom,
+    int yFrom,
+    int xTo,
+    int yTo,
+    struct Arena *restrict pScratch,
+    enum SolverStep *restrict steps,
+    int maxSteps,
+    int64_t *restrict pLength
+) {
+    assert(pMaze != NULL && pScratch != NULL && pLength != NULL);
+    assert(steps != NULL || maxSteps == 0);
+    assert(xFrom >= 0 && xFrom < pMaze->width && yFrom >= 0 && yFrom < pMaze->height);
+    assert(xTo >= 0 && xTo < pMaze->width && yTo >= 0 && yTo < pMaze->height);
+
+    size_t scratchMark = arena_getMark(pScratch);
+    size_t bitsSize = getBitsSize(pMaze->width, pMaze->height);
+    uint64_t *opened    = arena_allocAligned(pScratch, bitsSize, CACHE_LINE_SIZE);
+    uint64_t *closed    = arena_allocAligned(pScratch, bitsSize, CACHE_LINE_SIZE);
+    uint64_t *lowSteps  = arena_allocAligned(pScratch, bitsSize, CACHE_LINE_SIZE);
+    uint64_t *highSteps = arena_allocAligned(pScratch, bitsSize, CACHE_LINE_SIZE);
+    struct OpenSet set = {
+        .capacity = getCapacity(pMaze->width, pMaze->height, OPEN_SPAN),
+        .count    = 0,
+        .xGoal    = xFrom,
+        .yGoal    = yFrom
+    };
+    set.cells = arena_alloc(pScratch, set.capacity * sizeof(*set.cells));
+
+    if (!opened || !closed || !lowSteps || !highSteps || !set.cells)
+    {
+        fprintf(stderr, "Error: Not enough scratch space to solve the maze.\n");
+        arena_rewind(pScratch, scratchMark);
+        return false;
+    }
+
+    memset(opened, 0, bitsSize);
+    memset(closed, 0, bitsSize);
+    memset(lowSteps, 0, bitsSize);
+    memset(highSteps, 0, bitsSize);
+    *pLength = -1;
+
+    uint32_t start = PACK_CELL(xTo, yTo);
+    pushOpenCell(&set, (struct OpenCell) { estimateCost(&set, start), start });
+
+    bool isSolved = true;
+
+    while (set.count > 0)
+    {
+        struct OpenCell openCell = popOpenCell(&set);
+        uint32_t cell = openCell.cell & ( ((uint32_t)1 << STEP_SHIFT) - 1 );
+        uint32_t stepBack = openCell.cell >> STEP_SHIFT;
+        int x = (int)(cell & CELL_MASK);
+        int y = (int)(cell >> CELL_BITS);
+        size_t index = getBitIndex(pMaze->tilesPerRow, x, y);
+        uint64_t bit = (uint64_t)1 << (index & 63);
+
+        size_t word = index >> 6;
+
+        if (closed[word] & bit)
+            continue;  // already settled through a shorter path
+
+        closed[word]    |= bit;
+        lowSteps[word]  |= (stepBack & 1) ? bit : 0;
+        highSteps[word] |= (stepBack & 2) ? bit : 0;
+
+        uint32_t cost = openCell.cost - estimateCost(&set, cell);  // steps so far
+
+        if (x == xFrom && y == yFrom)
+        {
+            *pLength = cost;
+            break;
+        }
+
+        for (int step = SOLVER_EAST; step <= SOLVER_NORTH; ++step)
+        {
+            if (!isOpen(pMaze, x, y, (enum SolverStep)step))
+                continue;
+
+            int xNext = x + _xSteps[step];
+            int yNext = y + _ySteps[step];
+            size_t nextIndex = getBitIndex(pMaze->tilesPerRow, xNext, yNext);
+
+            uint64_t nextBit = (uint64_t)1 << (nextIndex & 63);
+            uint32_t next = PACK_CELL(xNext, yNext);
+
+            if (closed[nextIndex >> 6] & nextBit)
+                continue;
+
+            // Stepping away from the goal can't beat how it was opened before
+            bool isAway = estimateCost(&set, next) > estimateCost(&set, cell);
+
+            if ((opened[nextIndex >> 6] & nextBit) && isAway)
+                continue;
+
+            opened[nextIndex >> 6] |= nextBit;
+            uint32_t nextStepBack = (uint32_t)(step + 2) & 3;  // the opposite way
+            struct OpenCell nextOpenCell = {
+                .cost = cost + 1 + estimateCost(&set, next),
+                .cell = next | nextStepBack << STEP_SHIFT
+            };
+
+            if (!pushOpenCell(&set, nextOpenCell))
+            {
+                fprintf(stderr, "Error: The search outgrew its scratch space.\n");
+                isSolved = false;
+                break;
+            }
+        }
+
+        if (!isSolved)
+            break;
+    }
+
+    // Follow the steps back from the first cell, which lead to the last
+    int x = xFrom;
+    int y = yFrom;
+
+    for (int64_t i = 0; isSolved && i < SDL_min(*pLength, (int64_t)maxSteps); ++i)
+    {
+        size_t index = getBitIndex(pMaze->tilesPerRow, x, y);
+        int step = (int)( (lowSteps[index >> 6] >> (index & 63)) & 1 )
+                   | (int)( (highSteps[index >> 6] >> (index & 63)) & 1 ) << 1;
+
+        steps[i] = (enum SolverStep)step;
+        x += _xSteps[step];
+        y += _ySteps[step];
+    }
+
+    arena_rewind(pScratch, scratchMark);
+    return isSolved;
+}
+
+
+// === Static function definitions === //
+
+/* Tiles include the outer walls' lines, like the wall planes, which
+ * keeps the tile math the same as theirs.
+ */
+static size_t getBitsSize(int width, int height)
+{
+    size_t tileCount = (size_t)(width / MAZE_TILE_SIZE + 1)
+                       * (height / MAZE_TILE_SIZE + 1);
+    return tileCount * sizeof(uint64_t);
+}
+
+
+/* Frontiers grow with the length of the maze's sides, not its area: a
+ * perfect maze's stay well under a cell per cell along a side. A* keeps
+ * more around in open halls, where walls cast long shadows of cells it
+ * opens and never gets back to.
+ */
+static size_t getCapacity(int width, int height, int span)
+{
+    return (size_t)span * (width + height) + 4 * PARALLEL_CELLS;
+}
+
+
+/* Same layout as the wall planes: tile by tile, then row by row.
+ */
+static inline size_t getBitIndex(int tilesPerRow, int x, int y)
+{
+    size_t tile = (size_t)(y >> 3) * tilesPerRow + (x >> 3);
+    return tile << 6 | (size_t)((y & 7) << 3 | (x & 7));
+}
+
+
+/* East and south are the west and north walls of the next cell over.
+ */
+static inline bool isOpen(
+    const struct Maze *restrict pMaze,
+    int x,
+    int y,
+    enum SolverStep step
+) {
+    switch (step)
+    {
+    case SOLVER_EAST:
+        return !maze_hasWestWall(pMaze, x + 1, y);
+    case SOLVER_SOUTH:
+        return !maze_hasNorthWall(pMaze, x, y + 1);
+    case SOLVER_WEST:
+        return !maze_hasWestWall(pMaze, x, y);
+    default:
+        return !maze_hasNorthWall(pMaze, x, y);
+    }
+}
+
+
+/* SDL has no atomic OR, so this retries a compare-and-swap until either
+ * it lands or the bit turns out to be set already.
+ */
+static inline bool claimBit(SDL_AtomicU32 *bits, size_t index)
+{
+    SDL_AtomicU32 *pWord = &bits[index >> 5];
+    Uint32 bit = (Uint32)1 << (index & 31);
+
+    for (;;)
+    {
+        Uint32 word = SDL_GetAtomicU32(pWord);
+
+        if (word & bit)
+            return false;
+
+        if (SDL_CompareAndSwapAtomicU32(pWord, word, word | bit))
+            return true;
+    }
+}
+
+
+/* Only the side being grown changes during a level, so the other side's
+ * bits can be read without a race. Once a stretch is full, the rest of
+ * the task is skipped, since the search is abandoned anyway.
+ */
+static void growCells(void *pData, int taskIndex, int workerIndex)
+{
+    struct LevelJob *pJob = pData;
+    const struct Maze *pMaze = pJob->maze;
+    const struct Side *pSide = pJob->side;
+    SDL_AtomicU32 *otherVisited = pJob->other->visited;
+
+    size_t first = (size_t)taskIndex * TASK_CELLS;
+    size_t last = SDL_min(first + TASK_CELLS, pSide->count);
+    uint32_t *stretch = pJob->nextCells + (size_t)workerIndex * pJob->stretchSize;
+    size_t count = pJob->nextCounts[workerIndex];
+
+    for (size_t i = first; i < last; ++i)
+    {
+        int x = (int)(pSide->cells[i] & CELL_MASK);
+        int y = (int)(pSide->cells[i] >> CELL_BITS);
+
+        for (int step = SOLVER_EAST; step <= SOLVER_NORTH; ++step)
+        {
+            if (!isOpen(pMaze, x, y, (enum SolverStep)step))
+                continue;
+
+            int xNext = x + _xSteps[step];
+            int yNext = y + _ySteps[step];
+            size_t index = getBitIndex(pMaze->tilesPerRow, xNext, yNext);
+
+            if ((SDL_GetAtomicU32(&otherVisited[index >> 5]) >> (index & 31)) & 1)
+            {
+                SDL_SetAtomicInt(&pJob->isMet, 1);
+                continue;
+            }
+
+            if (!claimBit(pSide->visited, index))
+                continue;
+
+            if (count == pJob->stretchSize)
+            {
+                SDL_SetAtomicInt(&pJob->isFull, 1);
+                pJob->nextCounts[workerIndex] = count;
+                return;
+            }
+
+            stretch[count++] = PACK_CELL(xNext, yNext);
+        }
+    }
+
+    pJob->nextCounts[workerIndex] = count;
+}
+
+
+/* Never more than the steps left, so A* stays exact.
+ */
+static inline uint32_t estimateCost(const struct OpenSet *pSet, uint32_t cell)
+{
+    int x = (int)(cell & CELL_MASK);
+    int y = (int)(cell >> CELL_BITS);
+    return (uint32_t)(SDL_abs(x - pSet->xGoal) + SDL_abs(y - pSet->yGoal));
+}
+
+
+/* Strips the step off each packed cell before estimating.
+ */
+static inline bool isCheaper(
+    const struct OpenSet *pSet,
+    struct OpenCell a,
+    struct OpenCell b
+) {
+    if (a.cost != b.cost)
+        return a.cost < b.cost;
+
+    uint32_t cellMask = ((uint32_t)1 << STEP_SHIFT) - 1;
+    return estimateCost(pSet, a.cell & cellMask) < estimateCost(pSet, b.cell & cellMask);
+}
+
+
+/* Sifts the new cell up from the bottom of the heap.
+ */
+static bool pushOpenCell(struct OpenSet *restrict pSet, struct OpenCell openCell)
+{
+    if (pSet->count == pSet->capacity)
+        return false;
+
+    size_t i = pSet->count++;
+
+    while (i > 0)
+    {
+        size_t parent = (i - 1) / 2;
+
+        if (!isCheaper(pSet, openCell, pSet->cells[parent]))
+            break;
+
+        pSet->cells[i] = pSet->cells[parent];
+        i = parent;
+    }
+
+    pSet->cells[i] = openCell;
+    return true;
+}
+
+
+/* Sifts the last cell down from the top of the heap.
+ */
+static struct OpenCell popOpenCell(struct OpenSet *restrict pSet)
+{
+    assert(pSet->count > 0);
+
+    struct OpenCell cheapest = pSet->cells[0];
+    struct OpenCell last = pSet->cells[--pSet->count];
+    size_t i = 0;
+
+    for (;;)
+    {
+        size_t child = 2 * i + 1;
+
+        if (child >= pSet->count)
+            break;
+
+        if (child + 1 < pSet->count
+            && isCheaper(pSet, pSet->cells[child + 1], pSet->cells[child]))
+        {
+            ++child;
+        }
+
+        if (!isCheaper(pSet, pSet->cells[child], last))
+            break;
+
+        pSet->cells[i] = pSet->cells[child];
+        i = child;
+    }
+
+    pSet->cells[i] = last;
+    return cheapest;
+}
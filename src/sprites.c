@@ -0,0 +1,221 @@
+/**
+ * @file  sprites.c
+ * @brief Implementation of the sprites module.
+ *
+ * Defines the interface for the sprites module and provides internal
+ * helper functions to order cells and to search the sorted items for
+ * the first one at or after a cell.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>      // for console I/O
+#include <stdlib.h>     // for the C standard library
+#include <string.h>     // for memmove
+#include <math.h>       // for floor
+#include <assert.h>     // for debugging assertions
+#include "sprites.h"    // the header implemented here
+#include "utils.h"      // for arenas
+
+struct SpriteSet
+{
+    struct Sprite *sprites;     // sorted by row, then by column
+    int            count;       // items placed
+    int            capacity;    // most items it can hold
+    uint32_t       generation;  // bumped on every change to the items
+};
+
+
+// === Static function prototypes === //
+
+// Checks whether a cell comes before another, row by row
+static bool isBefore(int xCell, int yCell, int x, int y);
+
+// Finds the first item at or after a cell, or the count if there's none
+static int findFirst(const struct SpriteSet *restrict pSprites, int x, int y);
+
+
+// === Interface function definitions === //
+
+/* The set and its items, each with its padding.
+ */
+size_t sprites_getArenaSize(int capacity)
+{
+    return sizeof(struct SpriteSet) + ARENA_ALIGNMENT
+           + (size_t)capacity * sizeof(struct Sprite) + ARENA_ALIGNMENT;
+}
+
+
+/* Allocates the whole capacity up front, so placing items never has to.
+ */
+struct SpriteSet *sprites_create(int capacity, struct Arena *restrict pArena)
+{
+    assert(capacity > 0);
+
+    struct SpriteSet *pSprites = arena_alloc(pArena, sizeof(*pSprites));
+    struct Sprite *sprites = arena_alloc(pArena, (size_t)capacity * sizeof(*sprites));
+
+    if (!pSprites || !sprites)
+    {
+        perror("Error: Unable to allocate a sprite set");
+        return NULL;
+    }
+
+    pSprites->sprites = sprites;
+    pSprites->count = 0;
+    pSprites->capacity = capacity;
+    pSprites->generation = 0;
+    return pSprites;
+}
+
+
+/* Goes after any items already in the same cell, so that items in a
+ * cell stay in the order they were placed.
+ */
+bool sprites_add(
+    struct SpriteSet *restrict pSprites,
+    double xPos,
+    double yPos,
+    enum SpriteKind kind
+) {
+    if (pSprites->count == pSprites->capacity)
+        return false;
+
+    int x = (int)floor(xPos);
+    int y = (int)floor(yPos);
+    int index = findFirst(pSprites, x + 1, y);  // the cell right after
+
+    memmove(
+        &pSprites->sprites[index + 1],
+        &pSprites->sprites[index],
+        (size_t)(pSprites->count - index) * sizeof(*pSprites->sprites)
+    );
+    pSprites->sprites[index] = (struct Sprite) {
+        .xPos  = xPos,
+        .yPos  = yPos,
+        .xCell = x,
+        .yCell = y,
+        .kind  = kind
+    };
+    ++pSprites->count;
+    ++pSprites->generation;
+    return true;
+}
+
+
+/* Cells hold a few items at most, so they're checked one by one.
+ */
+bool sprites_isInCell(
+    const struct SpriteSet *restrict pSprites,
+    int x,
+    int y,
+    enum SpriteKind kind
+) {
+    const struct Sprite *pFirst;
+    int count = sprites_findInRow(pSprites, y, x, x, &pFirst);
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (pFirst[i].kind == kind)
+            return true;
+    }
+
+    return false;
+}
+
+
+/* The run is one stretch of the sorted items, found with two searches.
+ */
+int sprites_findInRow(
+    const struct SpriteSet *restrict pSprites,
+    int y,
+    int xFirst,
+    int xLast,
+    const struct Sprite **ppFirst
+) {
+    int first = findFirst(pSprites, xFirst, y);
+    int end = findFirst(pSprites, xLast + 1, y);
+
+    *ppFirst = pSprites->sprites + first;
+    return end - first;
+}
+
+
+/* Plain accessor.
+ */
+int sprites_getCount(const struct SpriteSet *restrict pSprites)
+{
+    return pSprites->count;
+}
+
+
+/* Plain accessor; it only has to differ from the last one seen, so
+ * wrapping around is fine.
+ */
+uint32_t sprites_getGeneration(const struct SpriteSet *restrict pSprites)
+{
+    return pSprites->generation;
+}
+
+
+/* Moving every item the same way keeps them in the same order, so the
+ * ones still on the maze are packed down in a single pass.
+ */
+void sprites_shift(
+    struct SpriteSet *restrict pSprites,
+    int xShift,
+    int yShift,
+    int width,
+    int height
+) {
+    int kept = 0;
+
+    for (int i = 0; i < pSprites->count; ++i)
+    {
+        struct Sprite sprite = pSprites->sprites[i];
+        sprite.xPos  += xShift;
+        sprite.yPos  += yShift;
+        sprite.xCell += xShift;
+        sprite.yCell += yShift;
+
+        if (sprite.xCell >= 0 && sprite.xCell < width
+            && sprite.yCell >= 0 && sprite.yCell < height)
+            pSprites->sprites[kept++] = sprite;
+    }
+
+    pSprites->count = kept;
+    ++pSprites->generation;
+}
+
+
+// === Static function definitions === //
+
+/* Rows first, then columns, the way the set is sorted.
+ */
+static bool isBefore(int xCell, int yCell, int x, int y)
+{
+    return yCell < y || (yCell == y && xCell < x);
+}
+
+
+/* A lower-bound binary search.
+ */
+static int findFirst(const struct SpriteSet *restrict pSprites, int x, int y)
+{
+    int low = 0;
+    int high = pSprites->count;
+
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        const struct Sprite *pSprite = &pSprites->sprites[middle];
+
+        if (isBefore(pSprite->xCell, pSprite->yCell, x, y))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
@@ -0,0 +1,574 @@
+/**
+ * @file  stream.c
+ * @brief Implementation of the stream module.
+ *
+ * Defines the interface for the stream module and provides internal
+ * helper functions to generate a chunk, keep it in the cache, lay it out
+ * in the window, and prefetch chunks on the background thread.
+ *
+ * A chunk keeps the wall tiles of its cells and of the lines along its
+ * west and north sides; the lines along its east and south sides are
+ * its neighbors' west and north lines. The cache is a plain array
+ * searched from end to end, since it's only searched when the window
+ * moves or the player turns, never per cell.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <string.h>    // for memcpy
+#include <math.h>      // for floor
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for threads, mutexes, and semaphores
+#include "stream.h"    // the header implemented here
+#include "rng.h"       // for seeding each chunk
+#include "utils.h"     // for arenas and freeing pointers
+
+#define CHUNK_TILES      ( STREAM_CHUNK_CELLS / MAZE_TILE_SIZE )  // tiles per side
+#define CHUNK_WORDS      ( CHUNK_TILES * CHUNK_TILES )  // tiles in each plane
+#define WINDOW_CELLS     ( STREAM_WINDOW_CHUNKS * STREAM_CHUNK_CELLS )
+#define MIDDLE_CHUNK     ( STREAM_WINDOW_CHUNKS / 2 )   // where the player stays
+#define MAX_AHEAD        ( 2 * STREAM_WINDOW_CHUNKS + 1 )  // chunks per request
+#define AHEAD_COSINE     0.38  // facing this far along an axis is heading along it
+#define WEST_LINE_BITS   0x0101010101010101u  // a tile's bits on its west line
+#define NORTH_LINE_BITS  0xFFu                // a tile's bits on its north line
+#define X_MIX            0x9E3779B97F4A7C15u  // spreads chunk columns over seeds
+#define Y_MIX            0xC2B2AE3D27D4EB4Fu  // spreads chunk rows over seeds
+
+// One chunk's walls, as kept in the cache
+struct Chunk
+{
+    int64_t  xChunk;                   // column of the chunk in the world
+    int64_t  yChunk;                   // row of the chunk in the world
+    uint64_t lastUse;                  // clock at its last use; 0 if empty
+    uint64_t westTiles[CHUNK_WORDS];   // west walls, tile rows one after another
+    uint64_t northTiles[CHUNK_WORDS];  // north walls, likewise
+};
+
+// What one thread needs to generate chunks on its own
+struct Generator
+{
+    struct Arena arena;                    // room for a chunk-sized maze
+    struct Arena scratch;                  // room to generate it in
+    uint64_t     westTiles[CHUNK_WORDS];   // the last chunk generated
+    uint64_t     northTiles[CHUNK_WORDS];
+};
+
+struct MazeStream
+{
+    struct Chunk     chunks[STREAM_CACHE_CHUNKS];  // the cache
+    struct Generator generators[2];  // the caller's, then the background thread's
+    struct Arena     windowArena;    // holds the window's maze
+    struct Maze     *window;         // the chunks around the player, laid out
+    SDL_Mutex       *lock;           // guards the cache, clock, and request
+    SDL_Semaphore   *wakeSignal;     // posted when there's a new request
+    SDL_Thread      *prefetcher;     // generates the requested chunks
+    uint64_t         seed;           // seed of the whole maze
+    uint64_t         clock;          // counts uses of chunks
+    int64_t          xOrigin;        // column of the window's first chunk
+    int64_t          yOrigin;        // row of the window's first chunk
+    int64_t          xAheads[MAX_AHEAD];  // columns of the chunks requested
+    int64_t          yAheads[MAX_AHEAD];  // rows of the chunks requested
+    int              aheadCount;     // chunks requested
+    int              xHeading;       // -1, 0, or 1: x-heading last requested for
+    int              yHeading;       // -1, 0, or 1: y-heading last requested for
+    bool             isQuitting;     // should the background thread exit?
+};
+
+
+// === Static function prototypes === //
+
+// Lays out every chunk of the window and closes its outer walls
+static void buildWindow(struct MazeStream *restrict pStream);
+
+// Lays out one chunk in the window, generating it first if it's not cached
+static void placeChunk(
+    struct MazeStream *restrict pStream,
+    int column,
+    int row
+);
+
+// Generates a chunk's walls into the generator's tiles
+static bool generateChunk(
+    struct Generator *restrict pGenerator,
+    uint64_t seed,
+    int64_t xChunk,
+    int64_t yChunk
+);
+
+// Finds a chunk in the cache, returning -1 if it's not there; needs the lock
+static int findChunk(
+    const struct MazeStream *restrict pStream,
+    int64_t xChunk,
+    int64_t yChunk
+);
+
+// Puts a generated chunk in the cache, in place of the least recently used
+// one, unless it got there first; needs the lock
+static int storeChunk(
+    struct MazeStream *restrict pStream,
+    const struct Generator *restrict pGenerator,
+    int64_t xChunk,
+    int64_t yChunk
+);
+
+// Asks the background thread for the chunks the player is heading for
+static void requestAhead(struct MazeStream *restrict pStream, int xHeading, int yHeading);
+
+// Runs on the background thread, generating requested chunks until told to quit
+static int SDLCALL runPrefetcher(void *pData);
+
+
+// === Interface function definitions === //
+
+/* Lays out the window before starting the background thread, so it has
+ * the cache to itself while it does.
+ */
+struct MazeStream *stream_create(uint64_t seed)
+{
+    struct MazeStream *pStream = calloc(1, sizeof(*pStream));
+
+    if (!pStream)
+    {
+        perror("Error: Unable to allocate a maze stream");
+        return NULL;
+    }
+
+    pStream->seed = seed;
+
+    bool isReady = arena_init(
+        &pStream->windowArena,
+        maze_getArenaSize(WINDOW_CELLS, WINDOW_CELLS)
+    );
+
+    for (int i = 0; i < 2 && isReady; ++i)
+    {
+        struct Generator *pGenerator = &pStream->generators[i];
+        isReady = arena_init(
+            &pGenerator->arena,
+            maze_getArenaSize(STREAM_CHUNK_CELLS, STREAM_CHUNK_CELLS)
+        ) && arena_init(&pGenerator->scratch, maze_getScratchSize(STREAM_CHUNK_CELLS));
+    }
+
+    if (isReady)
+    {
+        pStream->window = maze_createClosed(
+            WINDOW_CELLS,
+            WINDOW_CELLS,
+            &pStream->windowArena
+        );
+        isReady = pStream->window != NULL;
+    }
+
+    if (!isReady)
+    {
+        stream_destroy(&pStream);
+        return NULL;
+    }
+
+    pStream->window->seed = seed;
+    pStream->lock = SDL_CreateMutex();
+    pStream->wakeSignal = SDL_CreateSemaphore(0);
+
+    if (!pStream->lock || !pStream->wakeSignal)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create the maze stream's signals: %s.",
+            SDL_GetError()
+        );
+        stream_destroy(&pStream);
+        return NULL;
+    }
+
+    buildWindow(pStream);
+    pStream->prefetcher = SDL_CreateThread(runPrefetcher, "prefetcher", pStream);
+
+    if (!pStream->prefetcher)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to start the maze stream's thread: %s.",
+            SDL_GetError()
+        );
+        stream_destroy(&pStream);
+        return NULL;
+    }
+
+    return pStream;
+}
+
+
+/* Plain accessor.
+ */
+struct Maze *stream_getMaze(struct MazeStream *pStream)
+{
+    assert(pStream != NULL);
+    return pStream->window;
+}
+
+
+/* Moves the window as many chunks as it takes at once, which is one
+ * unless the player somehow skipped a whole chunk in a step. Requests
+ * only go out when the window moves or the heading changes, so a player
+ * walking the same way doesn't wake the background thread every step.
+ */
+bool stream_follow(
+    struct MazeStream *restrict pStream,
+    const struct PlayerPose *restrict pPose,
+    int *restrict pXShift,
+    int *restrict pYShift
+) {
+    int column = SDL_clamp(
+        (int)floor(pPose->xPos / STREAM_CHUNK_CELLS),
+        0,
+        STREAM_WINDOW_CHUNKS - 1
+    );
+    int row = SDL_clamp(
+        (int)floor(pPose->yPos / STREAM_CHUNK_CELLS),
+        0,
+        STREAM_WINDOW_CHUNKS - 1
+    );
+    int xChunks = column - MIDDLE_CHUNK;
+    int yChunks = row - MIDDLE_CHUNK;
+
+    *pXShift = -xChunks * STREAM_CHUNK_CELLS;
+    *pYShift = -yChunks * STREAM_CHUNK_CELLS;
+
+    if (xChunks != 0 || yChunks != 0)
+    {
+        pStream->xOrigin += xChunks;
+        pStream->yOrigin += yChunks;
+        buildWindow(pStream);
+    }
+
+    int xHeading = (pPose->xDir > AHEAD_COSINE) - (pPose->xDir < -AHEAD_COSINE);
+    int yHeading = (pPose->yDir > AHEAD_COSINE) - (pPose->yDir < -AHEAD_COSINE);
+
+    if (xChunks != 0 || yChunks != 0
+        || xHeading != pStream->xHeading || yHeading != pStream->yHeading)
+    {
+        requestAhead(pStream, xHeading, yHeading);
+    }
+
+    return xChunks != 0 || yChunks != 0;
+}
+
+
+/* Tells the background thread to quit before freeing anything it uses;
+ * also frees whatever a failed `stream_create` got as far as making.
+ */
+void stream_destroy(struct MazeStream **ppStream)
+{
+    assert(ppStream != NULL);
+
+    struct MazeStream *pStream = *ppStream;
+    if (!pStream)
+        return;
+
+    if (pStream->prefetcher)
+    {
+        SDL_LockMutex(pStream->lock);
+        pStream->isQuitting = true;
+        SDL_UnlockMutex(pStream->lock);
+
+        SDL_SignalSemaphore(pStream->wakeSignal);
+        SDL_WaitThread(pStream->prefetcher, NULL);
+    }
+
+    SDL_DestroySemaphore(pStream->wakeSignal);
+    SDL_DestroyMutex(pStream->lock);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        arena_destroy(&pStream->generators[i].arena);
+        arena_destroy(&pStream->generators[i].scratch);
+    }
+
+    arena_destroy(&pStream->windowArena);
+    freeMemory((void **)ppStream);
+}
+
+
+// === Static function definitions === //
+
+/* The chunks along the window's edges have doors out of it in their
+ * west and north lines, which have to be closed, since nothing stops a
+ * ray or the player at the edge but the walls. The lines along the east
+ * and south edges belong to no chunk and stay closed from the start.
+ */
+static void buildWindow(struct MazeStream *restrict pStream)
+{
+    struct Maze *pWindow = pStream->window;
+
+    for (int row = 0; row < STREAM_WINDOW_CHUNKS; ++row)
+    {
+        for (int column = 0; column < STREAM_WINDOW_CHUNKS; ++column)
+            placeChunk(pStream, column, row);
+    }
+
+    for (int i = 0; i < STREAM_WINDOW_CHUNKS * CHUNK_TILES; ++i)
+    {
+        pWindow->westWalls[(size_t)i * pWindow->tilesPerRow] |= WEST_LINE_BITS;
+        pWindow->northWalls[i] |= NORTH_LINE_BITS;
+    }
+}
+
+
+/* Holds the lock from finding the chunk to copying its tiles row by
+ * row, so the background thread can't reuse its slot in between. A chunk
+ * that isn't cached yet is generated without the lock, on this thread,
+ * and looked for again once the lock is back, in case the background
+ * thread cached it meanwhile.
+ */
+static void placeChunk(
+    struct MazeStream *restrict pStream,
+    int column,
+    int row
+) {
+    int64_t xChunk = pStream->xOrigin + column;
+    int64_t yChunk = pStream->yOrigin + row;
+    struct Generator *pGenerator = &pStream->generators[0];
+
+    SDL_LockMutex(pStream->lock);
+    int slot = findChunk(pStream, xChunk, yChunk);
+
+    if (slot < 0)
+    {
+        SDL_UnlockMutex(pStream->lock);
+
+        if (!generateChunk(pGenerator, pStream->seed, xChunk, yChunk))
+            return;  // leaves the chunk's walls as they were
+
+        SDL_LockMutex(pStream->lock);
+        slot = storeChunk(pStream, pGenerator, xChunk, yChunk);  // finds it first
+    }
+
+    struct Chunk *pChunk = &pStream->chunks[slot];
+    pChunk->lastUse = ++pStream->clock;
+    const uint64_t *westTiles = pChunk->westTiles;
+    const uint64_t *northTiles = pChunk->northTiles;
+
+    struct Maze *pWindow = pStream->window;
+    size_t firstTile = (size_t)row * CHUNK_TILES * pWindow->tilesPerRow
+                       + (size_t)column * CHUNK_TILES;
+
+    for (int i = 0; i < CHUNK_TILES; ++i)
+    {
+        size_t tile = firstTile + (size_t)i * pWindow->tilesPerRow;
+        memcpy(
+            &pWindow->westWalls[tile],
+            &westTiles[i * CHUNK_TILES],
+            CHUNK_TILES * sizeof(uint64_t)
+        );
+        memcpy(
+            &pWindow->northWalls[tile],
+            &northTiles[i * CHUNK_TILES],
+            CHUNK_TILES * sizeof(uint64_t)
+        );
+    }
+
+    SDL_UnlockMutex(pStream->lock);
+}
+
+
+/* Generates a chunk-sized maze with the regular generator and keeps all
+ * but its east and south outer walls, then opens a door in each of its
+ * west and north walls, wherever the chunk's own seed says. Only its
+ * east and south neighbors open doors into it, through their own west
+ * and north walls, so each seam gets exactly one door.
+ */
+static bool generateChunk(
+    struct Generator *restrict pGenerator,
+    uint64_t seed,
+    int64_t xChunk,
+    int64_t yChunk
+) {
+    struct Rng rng;
+    rng_seed(&rng, seed ^ (uint64_t)xChunk * X_MIX ^ (uint64_t)yChunk * Y_MIX);
+
+    arena_reset(&pGenerator->arena);
+    struct Maze *pMaze = maze_create(
+        STREAM_CHUNK_CELLS,
+        STREAM_CHUNK_CELLS,
+        rng_next(&rng),
+        &pGenerator->arena,
+        &pGenerator->scratch
+    );
+
+    if (!pMaze)
+        return false;
+
+    for (int i = 0; i < CHUNK_TILES; ++i)
+    {
+        size_t tile = (size_t)i * pMaze->tilesPerRow;
+        memcpy(
+            &pGenerator->westTiles[i * CHUNK_TILES],
+            &pMaze->westWalls[tile],
+            CHUNK_TILES * sizeof(uint64_t)
+        );
+        memcpy(
+            &pGenerator->northTiles[i * CHUNK_TILES],
+            &pMaze->northWalls[tile],
+            CHUNK_TILES * sizeof(uint64_t)
+        );
+    }
+
+    int yDoor = (int)rng_nextBelow(&rng, STREAM_CHUNK_CELLS);
+    int xDoor = (int)rng_nextBelow(&rng, STREAM_CHUNK_CELLS);
+    pGenerator->westTiles[(yDoor >> 3) * CHUNK_TILES] &=
+        ~( (uint64_t)1 << ((yDoor & 7) << 3) );
+    pGenerator->northTiles[xDoor >> 3] &= ~( (uint64_t)1 << (xDoor & 7) );
+
+    return true;
+}
+
+
+/* Empty slots never match, since they were never used.
+ */
+static int findChunk(
+    const struct MazeStream *restrict pStream,
+    int64_t xChunk,
+    int64_t yChunk
+) {
+    for (int i = 0; i < STREAM_CACHE_CHUNKS; ++i)
+    {
+        const struct Chunk *pChunk = &pStream->chunks[i];
+
+        if (pChunk->lastUse != 0 && pChunk->xChunk == xChunk && pChunk->yChunk == yChunk)
+            return i;
+    }
+
+    return -1;
+}
+
+
+/* Empty slots go first, having the oldest use of all. The window is a
+ * copy, so evicting a chunk that's in it is fine; it only gets
+ * generated again if the window comes back to it after it's gone.
+ */
+static int storeChunk(
+    struct MazeStream *restrict pStream,
+    const struct Generator *restrict pGenerator,
+    int64_t xChunk,
+    int64_t yChunk
+) {
+    int slot = findChunk(pStream, xChunk, yChunk);
+
+    if (slot >= 0)
+        return slot;
+
+    slot = 0;
+
+    for (int i = 1; i < STREAM_CACHE_CHUNKS; ++i)
+    {
+        if (pStream->chunks[i].lastUse < pStream->chunks[slot].lastUse)
+            slot = i;
+    }
+
+    struct Chunk *pChunk = &pStream->chunks[slot];
+    pChunk->xChunk = xChunk;
+    pChunk->yChunk = yChunk;
+    pChunk->lastUse = ++pStream->clock;
+    memcpy(pChunk->westTiles, pGenerator->westTiles, sizeof(pChunk->westTiles));
+    memcpy(pChunk->northTiles, pGenerator->northTiles, sizeof(pChunk->northTiles));
+    return slot;
+}
+
+
+/* Heading along an axis asks for the row or column of chunks the window
+ * would take in if it moved one chunk that way, and heading along both
+ * asks for the corner chunk between them too. A new request replaces
+ * any the background thread hasn't picked up yet.
+ */
+static void requestAhead(struct MazeStream *restrict pStream, int xHeading, int yHeading)
+{
+    pStream->xHeading = xHeading;
+    pStream->yHeading = yHeading;
+
+    int64_t xEdge = xHeading > 0 ? pStream->xOrigin + STREAM_WINDOW_CHUNKS
+                                 : pStream->xOrigin - 1;
+    int64_t yEdge = yHeading > 0 ? pStream->yOrigin + STREAM_WINDOW_CHUNKS
+                                 : pStream->yOrigin - 1;
+
+    SDL_LockMutex(pStream->lock);
+    int count = 0;
+
+    for (int i = 0; i < STREAM_WINDOW_CHUNKS; ++i)
+    {
+        if (xHeading != 0)
+        {
+            pStream->xAheads[count] = xEdge;
+            pStream->yAheads[count++] = pStream->yOrigin + i;
+        }
+
+        if (yHeading != 0)
+        {
+            pStream->xAheads[count] = pStream->xOrigin + i;
+            pStream->yAheads[count++] = yEdge;
+        }
+    }
+
+    if (xHeading != 0 && yHeading != 0)
+    {
+        pStream->xAheads[count] = xEdge;
+        pStream->yAheads[count++] = yEdge;
+    }
+
+    pStream->aheadCount = count;
+    SDL_UnlockMutex(pStream->lock);
+
+    if (count > 0)
+        SDL_SignalSemaphore(pStream->wakeSignal);
+}
+
+
+/* Takes the latest request as a whole, then generates its chunks one at
+ * a time without the lock, so that the window can move meanwhile.
+ * Chunks already cached only get their use renewed, so they outlast the
+ * ones nobody's heading for.
+ */
+static int SDLCALL runPrefetcher(void *pData)
+{
+    struct MazeStream *pStream = pData;
+    struct Generator *pGenerator = &pStream->generators[1];
+    int64_t xAheads[MAX_AHEAD];
+    int64_t yAheads[MAX_AHEAD];
+
+    for (;;)
+    {
+        SDL_WaitSemaphore(pStream->wakeSignal);
+
+        SDL_LockMutex(pStream->lock);
+        bool isQuitting = pStream->isQuitting;
+        int count = pStream->aheadCount;
+        memcpy(xAheads, pStream->xAheads, count * sizeof(*xAheads));
+        memcpy(yAheads, pStream->yAheads, count * sizeof(*yAheads));
+        pStream->aheadCount = 0;
+        SDL_UnlockMutex(pStream->lock);
+
+        if (isQuitting)
+            return 0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            SDL_LockMutex(pStream->lock);
+            int slot = findChunk(pStream, xAheads[i], yAheads[i]);
+            if (slot >= 0)
+                pStream->chunks[slot].lastUse = ++pStream->clock;
+            SDL_UnlockMutex(pStream->lock);
+
+            if (slot >= 0)
+                continue;
+
+            if (!generateChunk(pGenerator, pStream->seed, xAheads[i], yAheads[i]))
+                continue;
+
+            SDL_LockMutex(pStream->lock);
+            storeChunk(pStream, pGenerator, xAheads[i], yAheads[i]);
+            SDL_UnlockMutex(pStream->lock);
+        }
+    }
+}
@@ -0,0 +1,396 @@
+/**
+ * @file  texture.c
+ * @brief Implementation of the texture module.
+ *
+ * Defines the interface for the texture module and provides internal
+ * helper functions to draw the brick and tile patterns into level 0 and
+ * to average each level down into the next one.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>    // for console I/O
+#include <math.h>     // for sqrt
+#include <assert.h>   // for debugging assertions
+#include "texture.h"  // the header implemented here
+#include "palette.h"  // for indexing texels
+#include "rng.h"      // for varying the bricks
+#include "defines.h"  // for the cache line size
+
+#define BRICK_COLOR   0xFFB8A890u  // sandstone
+#define MORTAR_COLOR  0xFF6E665Au  // darker sandstone
+#define BRICK_WIDTH   16           // texels, mortar included; divides TEXTURE_SIZE
+#define BRICK_HEIGHT  8            // texels, mortar included; divides TEXTURE_SIZE
+#define BRICK_SEED    0xB51C4ull   // same bricks every run
+
+#define TILE_SIZE     16           // texels, grout included; divides TEXTURE_SIZE
+#define TILE_SEED     0x711E5ull   // same tiles every run
+
+#define ORB_AMBIENT   0.3          // brightness of the side facing away from the light
+
+
+// === Static function prototypes === //
+
+// Allocates a texture and its levels, leaving the texels to the caller
+static struct Texture *allocateTexture(
+    struct Arena *restrict pArena,
+    uint32_t *levels[TEXTURE_MAX_LEVELS]
+);
+
+// Derives every level after the first from the one before it
+static void buildLevels(
+    struct Texture *restrict pTexture,
+    uint32_t *levels[TEXTURE_MAX_LEVELS]
+);
+
+// Draws staggered rows of slightly uneven bricks into a column-major level
+static void drawBricks(
+    uint32_t *restrict texels,
+    int size,
+    struct Rng *restrict pRng
+);
+
+// Draws a grid of square tiles with thin grout lines into a column-major level
+static void drawTiles(
+    uint32_t *restrict texels,
+    int size,
+    uint32_t color,
+    struct Rng *restrict pRng
+);
+
+// Draws a ball lit from the top left, with clear texels around it
+static void drawOrb(uint32_t *restrict texels, int size, uint32_t color);
+
+// Averages each 2x2 block of a column-major level into one texel of the next
+static void downsample(
+    const uint32_t *restrict source,
+    int sourceSize,
+    uint32_t *restrict destination
+);
+
+
+// === Interface function definitions === //
+
+/* Each level can waste up to a cache line getting aligned, and so can
+ * its indexed copy, which is counted whether it gets built or not.
+ */
+size_t texture_getArenaSize(void)
+{
+    size_t size = sizeof(struct Texture) + ARENA_ALIGNMENT;
+
+    for (int level = 0; level < TEXTURE_MAX_LEVELS; ++level)
+    {
+        int side = TEXTURE_SIZE >> level;
+        size += (size_t)side * side * sizeof(uint32_t) + CACHE_LINE_SIZE;
+        size += (size_t)side * side * sizeof(uint8_t) + CACHE_LINE_SIZE;
+    }
+
+    return size;
+}
+
+
+/* Draws level 0 and then derives every other level from the one
+ * before it, all the way down to a single texel.
+ */
+struct Texture *texture_createBricks(struct Arena *restrict pArena)
+{
+    uint32_t *levels[TEXTURE_MAX_LEVELS];
+    struct Texture *pTexture = allocateTexture(pArena, levels);
+
+    if (!pTexture)
+        return NULL;
+
+    struct Rng rng;
+    rng_seed(&rng, BRICK_SEED);
+    drawBricks(levels[0], TEXTURE_SIZE, &rng);
+    buildLevels(pTexture, levels);
+    return pTexture;
+}
+
+
+/* Same as the bricks, with a different pattern in level 0.
+ */
+struct Texture *texture_createTiles(struct Arena *restrict pArena, uint32_t color)
+{
+    uint32_t *levels[TEXTURE_MAX_LEVELS];
+    struct Texture *pTexture = allocateTexture(pArena, levels);
+
+    if (!pTexture)
+        return NULL;
+
+    struct Rng rng;
+    rng_seed(&rng, TILE_SEED);
+    drawTiles(levels[0], TEXTURE_SIZE, color, &rng);
+    buildLevels(pTexture, levels);
+    return pTexture;
+}
+
+
+/* Same as the bricks, with no randomness to seed.
+ */
+struct Texture *texture_createOrb(struct Arena *restrict pArena, uint32_t color)
+{
+    uint32_t *levels[TEXTURE_MAX_LEVELS];
+    struct Texture *pTexture = allocateTexture(pArena, levels);
+
+    if (!pTexture)
+        return NULL;
+
+    drawOrb(levels[0], TEXTURE_SIZE, color);
+    buildLevels(pTexture, levels);
+    return pTexture;
+}
+
+
+/* Indexes each level from its own texels rather than downsampling the
+ * indices, so that small levels get the palette's best match for their
+ * averaged colors. Indexed levels are aligned like the others.
+ */
+bool texture_buildIndices(
+    struct Texture *restrict pTexture,
+    const struct Palette *restrict pPalette,
+    struct Arena *restrict pArena
+) {
+    uint8_t *indexLevels[TEXTURE_MAX_LEVELS];
+
+    for (int level = 0; level < pTexture->levelCount; ++level)
+    {
+        int side = pTexture->size >> level;
+        int texelCount = side * side;
+        indexLevels[level] = arena_allocAligned(
+            pArena,
+            (size_t)texelCount,
+            CACHE_LINE_SIZE
+        );
+
+        if (!indexLevels[level])
+        {
+            perror("Error: Unable to allocate an indexed texture");
+            return false;
+        }
+
+        const uint32_t *texels = pTexture->levels[level];
+
+        for (int i = 0; i < texelCount; ++i)
+        {
+            indexLevels[level][i] = texels[i] >= 0x80000000u  // at least half opaque
+                ? palette_findNearest(pPalette, texels[i])
+                : PALETTE_CLEAR;
+        }
+    }
+
+    for (int level = 0; level < pTexture->levelCount; ++level)
+        pTexture->indexLevels[level] = indexLevels[level];
+
+    return true;
+}
+
+
+// === Static function definitions === //
+
+/* Aligns each level to a cache line, so that short columns of the
+ * small levels don't straddle two lines.
+ */
+static struct Texture *allocateTexture(
+    struct Arena *restrict pArena,
+    uint32_t *levels[TEXTURE_MAX_LEVELS]
+) {
+    struct Texture *pTexture = arena_alloc(pArena, sizeof(*pTexture));
+
+    for (int level = 0; pTexture && level < TEXTURE_MAX_LEVELS; ++level)
+    {
+        int side = TEXTURE_SIZE >> level;
+        levels[level] = arena_allocAligned(
+            pArena,
+            (size_t)side * side * sizeof(uint32_t),
+            CACHE_LINE_SIZE
+        );
+
+        if (!levels[level])
+            pTexture = NULL;
+    }
+
+    if (!pTexture)
+    {
+        perror("Error: Unable to allocate a texture");
+        return NULL;
+    }
+
+    pTexture->size = TEXTURE_SIZE;
+    pTexture->sizeShift = 0;
+    while ((1 << pTexture->sizeShift) < TEXTURE_SIZE)
+        ++pTexture->sizeShift;
+
+    for (int level = 0; level < TEXTURE_MAX_LEVELS; ++level)
+        pTexture->indexLevels[level] = NULL;
+
+    pTexture->levelCount = TEXTURE_MAX_LEVELS;
+    return pTexture;
+}
+
+
+/* Each level only needs the one before it, so they're built in order.
+ */
+static void buildLevels(
+    struct Texture *restrict pTexture,
+    uint32_t *levels[TEXTURE_MAX_LEVELS]
+) {
+    pTexture->levels[0] = levels[0];
+
+    for (int level = 1; level < pTexture->levelCount; ++level)
+    {
+        downsample(levels[level - 1], pTexture->size >> (level - 1), levels[level]);
+        pTexture->levels[level] = levels[level];
+    }
+}
+
+
+/* Every other row of bricks is shifted by half a brick, and each brick
+ * gets its own shade plus a little grain per texel. Mortar runs along
+ * the top and left edge of each brick, so the pattern tiles seamlessly.
+ */
+static void drawBricks(
+    uint32_t *restrict texels,
+    int size,
+    struct Rng *restrict pRng
+) {
+    const int bricksPerRow = size / BRICK_WIDTH;
+    const int rows = size / BRICK_HEIGHT;
+    uint32_t brickShades[TEXTURE_SIZE / BRICK_HEIGHT][TEXTURE_SIZE / BRICK_WIDTH];
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int brick = 0; brick < bricksPerRow; ++brick)
+            brickShades[row][brick] = 216 + rng_nextBelow(pRng, 40);
+    }
+
+    for (int u = 0; u < size; ++u)
+    {
+        for (int v = 0; v < size; ++v)
+        {
+            int row = v / BRICK_HEIGHT;
+            int shifted = (u + (row % 2) * BRICK_WIDTH / 2) % size;
+            bool isMortar = v % BRICK_HEIGHT == 0 || shifted % BRICK_WIDTH == 0;
+            uint32_t grain = 240 + rng_nextBelow(pRng, 16);
+
+            if (!isMortar)
+                grain = grain * brickShades[row][shifted / BRICK_WIDTH] >> 8;
+
+            texels[u * size + v] = texture_shadeColor(
+                isMortar ? MORTAR_COLOR : BRICK_COLOR,
+                grain
+            );
+        }
+    }
+}
+
+
+/* Grout runs along the top and left edge of each tile, like the mortar
+ * of the bricks, and each tile gets its own shade of the color.
+ */
+static void drawTiles(
+    uint32_t *restrict texels,
+    int size,
+    uint32_t color,
+    struct Rng *restrict pRng
+) {
+    const int tilesPerSide = size / TILE_SIZE;
+    uint32_t tileShades[TEXTURE_SIZE / TILE_SIZE][TEXTURE_SIZE / TILE_SIZE];
+
+    for (int row = 0; row < tilesPerSide; ++row)
+    {
+        for (int tile = 0; tile < tilesPerSide; ++tile)
+            tileShades[row][tile] = 224 + rng_nextBelow(pRng, 32);
+    }
+
+    for (int u = 0; u < size; ++u)
+    {
+        for (int v = 0; v < size; ++v)
+        {
+            bool isGrout = u % TILE_SIZE == 0 || v % TILE_SIZE == 0;
+            uint32_t grain = 244 + rng_nextBelow(pRng, 12);
+
+            grain = isGrout
+                ? grain * 3 / 5
+                : grain * tileShades[v / TILE_SIZE][u / TILE_SIZE] >> 8;
+
+            texels[u * size + v] = texture_shadeColor(color, grain);
+        }
+    }
+}
+
+
+/* Lights each texel by how squarely the ball's surface faces the light,
+ * taking the ball to be a hemisphere bulging out of the texture.
+ */
+static void drawOrb(uint32_t *restrict texels, int size, uint32_t color)
+{
+    const double light = 1.0 / sqrt(3.0);  // each component of the light's direction
+
+    for (int u = 0; u < size; ++u)
+    {
+        for (int v = 0; v < size; ++v)
+        {
+            double x = 2.0 * (u + 0.5) / size - 1.0;
+            double y = 2.0 * (v + 0.5) / size - 1.0;
+            double radiusSquared = x * x + y * y;
+
+            if (radiusSquared > 1.0)
+            {
+                texels[u * size + v] = 0;  // clear
+                continue;
+            }
+
+            double z = sqrt(1.0 - radiusSquared);
+            double lit = (z - x - y) * light;
+            if (lit < 0.0)
+                lit = 0.0;
+
+            double brightness = ORB_AMBIENT + (1.0 - ORB_AMBIENT) * lit;
+            texels[u * size + v] = texture_shadeColor(
+                color | 0xFF000000u,
+                (uint32_t)(brightness * 256.0)
+            );
+        }
+    }
+}
+
+
+/* A plain box filter, channel by channel. The source columns are
+ * contiguous, so each pair of them is read straight through.
+ */
+static void downsample(
+    const uint32_t *restrict source,
+    int sourceSize,
+    uint32_t *restrict destination
+) {
+    assert(sourceSize >= 2);
+
+    const int size = sourceSize / 2;
+
+    for (int u = 0; u < size; ++u)
+    {
+        const uint32_t *left  = source + (2 * u) * sourceSize;
+        const uint32_t *right = left + sourceSize;
+
+        for (int v = 0; v < size; ++v)
+        {
+            uint32_t texels[4] = {
+                left[2 * v], left[2 * v + 1], right[2 * v], right[2 * v + 1]
+            };
+            uint32_t result = 0;
+
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                uint32_t sum = 0;
+                for (int i = 0; i < 4; ++i)
+                    sum += texels[i] >> shift & 0xFFu;
+
+                result |= (sum + 2) / 4 << shift;
+            }
+
+            destination[u * size + v] = result;
+        }
+    }
+}
@@ -8,7 +8,10 @@
  * @date   2024-12-13
  */
 
+#include <stdio.h>   // for console I/O
 #include <stdlib.h>  // for the C standard library
+#include <stdint.h>  // for uintptr_t
+#include <errno.h>   // for reporting a full arena
 #include <assert.h>  // for debugging assertions
 #include "utils.h"   // the header implemented here
 
@@ -29,3 +32,79 @@ void freeMemory(void **ppData)
 
     assert(*ppData == NULL);
 }
+
+
+/* The block comes straight from malloc; alignment is handled per
+ * allocation instead, so callers count any padding in the capacity.
+ */
+bool arena_init(struct Arena *restrict pArena, size_t capacity)
+{
+    assert(pArena != NULL);
+
+    pArena->base = malloc(capacity);
+    pArena->capacity = pArena->base ? capacity : 0;
+    pArena->used = 0;
+
+    if (!pArena->base)
+    {
+        perror("Error: Unable to allocate an arena");
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Good enough for anything but cache-line-aligned blocks.
+ */
+void *arena_alloc(struct Arena *restrict pArena, size_t size)
+{
+    return arena_allocAligned(pArena, size, ARENA_ALIGNMENT);
+}
+
+
+/* Aligns the address rather than the offset, since the block itself is
+ * only as aligned as malloc made it. Checks against the room left rather
+ * than adding to the offset, which can't overflow.
+ */
+void *arena_allocAligned(struct Arena *restrict pArena, size_t size, size_t alignment)
+{
+    assert(pArena != NULL);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    uintptr_t next = (uintptr_t)(pArena->base + pArena->used);
+    size_t padding = (size_t)(-next & (alignment - 1));
+    size_t room = pArena->capacity - pArena->used;
+
+    if (padding > room || size > room - padding)
+    {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    void *pData = pArena->base + pArena->used + padding;
+    pArena->used += padding + size;
+    return pData;
+}
+
+
+/* Marks only ever move forward between rewinds, so a mark past the
+ * current position means it came from somewhere else.
+ */
+void arena_rewind(struct Arena *restrict pArena, size_t mark)
+{
+    assert(pArena != NULL && mark <= pArena->used);
+    pArena->used = mark;
+}
+
+
+/* Safe to call on an arena that was never successfully initialized.
+ */
+void arena_destroy(struct Arena *restrict pArena)
+{
+    assert(pArena != NULL);
+
+    freeMemory((void **)&pArena->base);
+    pArena->capacity = 0;
+    pArena->used = 0;
+}
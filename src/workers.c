@@ -0,0 +1,232 @@
+/**
+ * @file  workers.c
+ * @brief Implementation of the workers module.
+ *
+ * Defines the interface for the workers module. Threads park on a
+ * semaphore between batches. Within a batch, tasks are claimed through
+ * an atomic counter, and the last thread to run out of tasks wakes the
+ * thread that started the batch.
+ *
+ * @author Joseph Borjon
+ * @date   2026-10-16
+ */
+
+#include <stdio.h>     // for console I/O
+#include <stdlib.h>    // for the C standard library
+#include <stdbool.h>   // for the bool type
+#include <assert.h>    // for debugging assertions
+#include <SDL3/SDL.h>  // for threads, atomics, and semaphores
+#include "workers.h"   // the header implemented here
+#include "utils.h"     // for freeing pointers
+
+// One thread in the pool, along with what it needs to find its work
+struct Worker
+{
+    struct WorkerPool *pool;    // the pool the worker belongs to
+    SDL_Thread        *thread;  // the thread itself
+    int                index;   // 1 and up; 0 is the batch's caller
+};
+
+struct WorkerPool
+{
+    struct Worker  workers[MAX_WORKER_THREADS];  // the started threads
+    SDL_Semaphore *startSignal;     // posted once per thread per batch
+    SDL_Semaphore *doneSignal;      // posted when the last thread finishes
+    SDL_AtomicInt  nextTask;        // index of the next unclaimed task
+    SDL_AtomicInt  busyThreads;     // started threads still in the batch
+    WorkerTask     task;            // what the current batch runs
+    void          *data;            // what the current batch runs on
+    int            taskCount;       // tasks in the current batch
+    int            threadCount;     // threads in the pool, caller included
+    bool           isQuitting;      // should the threads exit?
+};
+
+
+// === Static function prototypes === //
+
+// Runs on each started thread, working through batches until told to quit
+static int SDLCALL runWorker(void *pData);
+
+// Claims and runs tasks from the current batch until none are left
+static void runTasks(struct WorkerPool *pPool, int workerIndex);
+
+// Stops and joins the first `count` started threads
+static void stopWorkers(struct WorkerPool *pPool, int count);
+
+
+// === Interface function definitions === //
+
+/* Creates the signals before the threads so the threads can block on
+ * them right away.
+ */
+struct WorkerPool *workers_create(int threadCount)
+{
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > MAX_WORKER_THREADS)
+        threadCount = MAX_WORKER_THREADS;
+
+    struct WorkerPool *pPool = malloc(sizeof(*pPool));
+
+    if (!pPool)
+    {
+        perror("Error: Unable to allocate a worker pool");
+        return NULL;
+    }
+
+    pPool->startSignal = SDL_CreateSemaphore(0);
+    pPool->doneSignal  = SDL_CreateSemaphore(0);
+    pPool->task        = NULL;
+    pPool->data        = NULL;
+    pPool->taskCount   = 0;
+    pPool->threadCount = threadCount;
+    pPool->isQuitting  = false;
+    SDL_SetAtomicInt(&pPool->nextTask, 0);
+    SDL_SetAtomicInt(&pPool->busyThreads, 0);
+
+    if (!pPool->startSignal || !pPool->doneSignal)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_ERROR,
+            "Failed to create the worker signals: %s.",
+            SDL_GetError()
+        );
+        SDL_DestroySemaphore(pPool->startSignal);
+        SDL_DestroySemaphore(pPool->doneSignal);
+        freeMemory((void **)&pPool);
+        return NULL;
+    }
+
+    for (int i = 1; i < threadCount; ++i)
+    {
+        struct Worker *pWorker = &pPool->workers[i];
+        pWorker->pool   = pPool;
+        pWorker->index  = i;
+        pWorker->thread = SDL_CreateThread(runWorker, "worker", pWorker);
+
+        if (!pWorker->thread)
+        {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_ERROR,
+                "Failed to start worker thread %d: %s.",
+                i,
+                SDL_GetError()
+            );
+            stopWorkers(pPool, i - 1);
+            SDL_DestroySemaphore(pPool->startSignal);
+            SDL_DestroySemaphore(pPool->doneSignal);
+            freeMemory((void **)&pPool);
+            return NULL;
+        }
+    }
+
+    return pPool;
+}
+
+
+/* Plain accessor.
+ */
+int workers_getThreadCount(const struct WorkerPool *pPool)
+{
+    return pPool->threadCount;
+}
+
+
+/* Publishes the batch, wakes every started thread, and works on the
+ * batch alongside them. The semaphores double as memory barriers, so
+ * the threads see the batch before they start and the caller sees all
+ * of their writes once it's woken back up.
+ */
+void workers_run(
+    struct WorkerPool *pPool,
+    WorkerTask task,
+    void *pData,
+    int taskCount
+) {
+    assert(pPool != NULL && task != NULL);
+
+    int startedCount = pPool->threadCount - 1;
+
+    pPool->task      = task;
+    pPool->data      = pData;
+    pPool->taskCount = taskCount;
+    SDL_SetAtomicInt(&pPool->nextTask, 0);
+    SDL_SetAtomicInt(&pPool->busyThreads, startedCount);
+
+    for (int i = 0; i < startedCount; ++i)
+        SDL_SignalSemaphore(pPool->startSignal);
+
+    runTasks(pPool, 0);
+
+    if (startedCount > 0)
+        SDL_WaitSemaphore(pPool->doneSignal);
+}
+
+
+/* Wakes every thread with the quit flag set instead of a batch.
+ */
+void workers_destroy(struct WorkerPool **ppPool)
+{
+    assert(ppPool != NULL);
+
+    struct WorkerPool *pPool = *ppPool;
+    if (!pPool)
+        return;
+
+    stopWorkers(pPool, pPool->threadCount - 1);
+    SDL_DestroySemaphore(pPool->startSignal);
+    SDL_DestroySemaphore(pPool->doneSignal);
+    freeMemory((void **)ppPool);
+}
+
+
+// === Static function definitions === //
+
+/* Sleeps until the next batch, helps finish it, and reports back. The
+ * last thread to finish is the one that wakes up the caller.
+ */
+static int SDLCALL runWorker(void *pData)
+{
+    struct Worker *pWorker = pData;
+    struct WorkerPool *pPool = pWorker->pool;
+
+    for (;;)
+    {
+        SDL_WaitSemaphore(pPool->startSignal);
+
+        if (pPool->isQuitting)
+            break;
+
+        runTasks(pPool, pWorker->index);
+
+        if (SDL_AddAtomicInt(&pPool->busyThreads, -1) == 1)
+            SDL_SignalSemaphore(pPool->doneSignal);
+    }
+
+    return 0;
+}
+
+
+/* Claims one task at a time, so threads that draw cheap tasks simply
+ * come back for more while others are stuck on expensive ones.
+ */
+static void runTasks(struct WorkerPool *pPool, int workerIndex)
+{
+    int taskIndex;
+    while ((taskIndex = SDL_AddAtomicInt(&pPool->nextTask, 1)) < pPool->taskCount)
+        pPool->task(pPool->data, taskIndex, workerIndex);
+}
+
+
+/* Sets the quit flag before posting so that every woken thread sees it.
+ */
+static void stopWorkers(struct WorkerPool *pPool, int count)
+{
+    pPool->isQuitting = true;
+
+    for (int i = 0; i < count; ++i)
+        SDL_SignalSemaphore(pPool->startSignal);
+
+    for (int i = 1; i <= count; ++i)
+        SDL_WaitThread(pPool->workers[i].thread, NULL);
+}